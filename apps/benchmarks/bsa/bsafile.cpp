@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include "../data.hpp"
+
+#include <components/bsa/bsafile.hpp>
+#include <components/files/conversion.hpp>
+#include <components/testing/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Creates a TES3 archive with filesCount files of fileSize bytes or reuses one created by a previous run
+    std::filesystem::path generateArchive(std::size_t filesCount, std::size_t fileSize)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath(
+            "generated_" + std::to_string(filesCount) + "_" + std::to_string(fileSize) + ".bsa");
+        if (std::filesystem::exists(path))
+            return path;
+
+        Bsa::BSAFile archive;
+        archive.open(path);
+        for (std::size_t i = 0; i < filesCount; ++i)
+        {
+            std::istringstream content(std::string(fileSize, static_cast<char>(i)));
+            archive.addFile("meshes\\group_" + std::to_string(i % 61) + "\\object_" + std::to_string(i) + ".nif",
+                content);
+        }
+        // Header is written on destruction
+        return path;
+    }
+
+    void openArchive(benchmark::State& state, const std::filesystem::path& path)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            Bsa::BSAFile archive;
+            archive.open(path);
+            benchmark::DoNotOptimize(archive.getList());
+        }
+    }
+
+    // Reads the whole content of the archive files in random order
+    void readFiles(benchmark::State& state, const std::filesystem::path& path)
+    {
+        Bsa::BSAFile archive;
+        archive.open(path);
+
+        std::vector<const Bsa::BSAFile::FileStruct*> files;
+        for (const Bsa::BSAFile::FileStruct& file : archive.getList())
+            files.push_back(&file);
+        if (files.empty())
+        {
+            state.SkipWithError("Archive is empty");
+            return;
+        }
+        std::shuffle(files.begin(), files.end(), std::minstd_rand(42));
+
+        std::vector<char> buffer;
+        std::size_t index = 0;
+        std::int64_t size = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            const Bsa::BSAFile::FileStruct& file = *files[index];
+            buffer.resize(file.mFileSize);
+            archive.getFile(&file)->read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            benchmark::DoNotOptimize(buffer.data());
+            size += file.mFileSize;
+            if (++index == files.size())
+                index = 0;
+        }
+
+        state.SetBytesProcessed(size);
+    }
+
+    void openGeneratedArchive(benchmark::State& state)
+    {
+        openArchive(state, generateArchive(static_cast<std::size_t>(state.range(0)), 16));
+    }
+
+    void readGeneratedArchive(benchmark::State& state)
+    {
+        readFiles(state,
+            generateArchive(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1))));
+    }
+}
+
+BENCHMARK(openGeneratedArchive)->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
+BENCHMARK(readGeneratedArchive)->Args({ 1 << 10, 1 << 10 })->Args({ 1 << 8, 1 << 16 })->Args({ 1 << 4, 1 << 20 });
+
+int main(int argc, char* argv[])
+{
+    for (const std::filesystem::path& path : Benchmarks::findDataFiles({ ".bsa" }))
+    {
+        if (Bsa::BSAFile::detectVersion(path) != Bsa::BsaVersion::Uncompressed)
+            continue;
+        const std::string name = Files::pathToUnicodeString(path.filename());
+        benchmark::RegisterBenchmark(
+            ("openDataArchive/" + name).c_str(), [=](benchmark::State& state) { openArchive(state, path); });
+        benchmark::RegisterBenchmark(
+            ("readDataArchive/" + name).c_str(), [=](benchmark::State& state) { readFiles(state, path); });
+    }
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#ifndef OPENMW_APPS_BENCHMARKS_DATA_H
+#define OPENMW_APPS_BENCHMARKS_DATA_H
+
+#include <components/esm/format.hpp>
+#include <components/files/conversion.hpp>
+#include <components/misc/strings/lower.hpp>
+#include <components/vfs/bsaarchive.hpp>
+#include <components/vfs/filesystemarchive.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/pathutil.hpp>
+#include <components/vfs/recursivedirectoryiterator.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Benchmarks
+{
+    // Benchmarks use generated data. When OPENMW_BENCHMARK_DATA environment variable points to a data directory
+    // (e.g. Morrowind "Data Files") the same code is benchmarked over its files in addition.
+    inline std::optional<std::filesystem::path> getDataPath()
+    {
+#ifdef _WIN32
+        const wchar_t* const value = _wgetenv(L"OPENMW_BENCHMARK_DATA");
+#else
+        const char* const value = std::getenv("OPENMW_BENCHMARK_DATA");
+#endif
+        if (value == nullptr || *value == 0)
+            return std::nullopt;
+        return std::filesystem::path(value);
+    }
+
+    // Returns sorted paths of the files in the data directory with one of the given lower case extensions. Returns
+    // nothing when the data directory is not set.
+    inline std::vector<std::filesystem::path> findDataFiles(std::initializer_list<std::string_view> extensions)
+    {
+        std::vector<std::filesystem::path> result;
+        const std::optional<std::filesystem::path> dataPath = getDataPath();
+        if (!dataPath.has_value())
+            return result;
+        for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(*dataPath))
+        {
+            if (!entry.is_regular_file())
+                continue;
+            const std::string extension
+                = Misc::StringUtils::lowerCase(Files::pathToUnicodeString(entry.path().extension()));
+            if (std::find(extensions.begin(), extensions.end(), extension) != extensions.end())
+                result.push_back(entry.path());
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    // Returns sorted paths of the TES3 content files in the data directory
+    inline std::vector<std::filesystem::path> findContentFiles()
+    {
+        std::vector<std::filesystem::path> result;
+        for (std::filesystem::path& path : findDataFiles({ ".esm", ".esp", ".omwgame", ".omwaddon" }))
+        {
+            std::ifstream stream(path, std::ios::binary);
+            if (ESM::readFormat(stream) == ESM::Format::Tes3)
+                result.push_back(std::move(path));
+        }
+        return result;
+    }
+
+    // Creates VFS over the archives and the loose files of the data directory. Returns nullptr when the data
+    // directory is not set.
+    inline std::unique_ptr<VFS::Manager> makeDataVFS()
+    {
+        const std::optional<std::filesystem::path> dataPath = getDataPath();
+        if (!dataPath.has_value())
+            return nullptr;
+        auto result = std::make_unique<VFS::Manager>();
+        for (const std::filesystem::path& archive : findDataFiles({ ".bsa", ".ba2" }))
+            result->addArchive(VFS::makeBsaArchive(archive, nullptr));
+        result->addArchive(std::make_unique<VFS::FileSystemArchive>(*dataPath));
+        result->buildIndex();
+        return result;
+    }
+
+    // Reads the VFS files with the given lower case extension into memory to exclude IO from the measurement
+    inline std::vector<std::pair<VFS::Path::Normalized, std::string>> readDataFiles(
+        const VFS::Manager& vfs, std::string_view extension)
+    {
+        std::vector<std::pair<VFS::Path::Normalized, std::string>> result;
+        for (const VFS::Path::Normalized& path : vfs.getRecursiveDirectoryIterator())
+        {
+            if (!path.value().ends_with(extension))
+                continue;
+            const Files::IStreamPtr stream = vfs.get(path);
+            result.emplace_back(path, std::string(std::istreambuf_iterator<char>(*stream), {}));
+        }
+        return result;
+    }
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include "components/esm/refid.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <random>
 #include <string>
@@ -233,6 +234,34 @@ namespace
                 i = 0;
         }
     }
+    void createExistingStringRefId(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        std::vector<std::string> values
+            = generateSerializedStringRefIds(state.range(0), random, [](ESM::RefId v) { return v.toString(); });
+        std::size_t i = state.thread_index() * values.size() / state.threads();
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(ESM::StringRefId(values[i]));
+            if (++i >= values.size())
+                i = 0;
+        }
+    }
+
+    void createNewStringRefId(benchmark::State& state)
+    {
+        // Shared by all runs to make sure each value is interned for the first time
+        static std::atomic<std::uint64_t> counter{ 0 };
+        std::minstd_rand random(state.thread_index());
+        const std::string prefix = generateText(state.range(0), random);
+        std::string value;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            value = prefix;
+            value += std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+            benchmark::DoNotOptimize(ESM::StringRefId(value));
+        }
+    }
 }
 
 BENCHMARK(serializeRefId)->RangeMultiplier(4)->Range(8, 64);
@@ -245,5 +274,7 @@ BENCHMARK(serializeTextIndexRefId);
 BENCHMARK(deserializeTextIndexRefId);
 BENCHMARK(serializeTextESM3ExteriorCellRefId);
 BENCHMARK(deserializeTextESM3ExteriorCellRefId);
+BENCHMARK(createExistingStringRefId)->Arg(32)->ThreadRange(1, 8);
+BENCHMARK(createNewStringRefId)->Arg(32)->ThreadRange(1, 8);
 
 BENCHMARK_MAIN();
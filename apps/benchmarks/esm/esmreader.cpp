@@ -0,0 +1,182 @@
+#include <benchmark/benchmark.h>
+
+#include "../data.hpp"
+
+#include <components/esm/defs.hpp>
+#include <components/esm/esmcommon.hpp>
+#include <components/esm/refid.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+#include <components/esm3/loadcont.hpp>
+#include <components/esm3/loadland.hpp>
+#include <components/esm3/loadstat.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/memorystream.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    template <class T>
+    void writeRecord(const T& record, ESM::ESMWriter& writer)
+    {
+        writer.startRecord(T::sRecordId);
+        record.save(writer);
+        writer.endRecord(T::sRecordId);
+    }
+
+    // Generates a content file where most of the records are statics, every 4th is a container and every 64th is a
+    // land record with all data present
+    std::string generateContentFile(std::size_t recordsCount)
+    {
+        std::stringstream stream;
+        ESM::ESMWriter writer;
+        writer.setFormatVersion(ESM::DefaultFormatVersion);
+        writer.save(stream);
+
+        for (std::size_t i = 0; i < recordsCount; ++i)
+        {
+            const std::string name = "object_" + std::to_string(i);
+            if (i % 64 == 0)
+            {
+                ESM::Land record;
+                record.blank();
+                record.mFlags = ESM::Land::Flag_HeightsNormals | ESM::Land::Flag_Colors | ESM::Land::Flag_Textures;
+                record.mX = static_cast<int>(i / 64) % 32;
+                record.mY = static_cast<int>(i / 64) / 32;
+                writeRecord(record, writer);
+            }
+            else if (i % 4 == 0)
+            {
+                ESM::Container record;
+                record.blank();
+                record.mId = ESM::RefId::stringRefId(name);
+                record.mName = "Container " + std::to_string(i);
+                record.mModel = "o\\contain_" + std::to_string(i % 16) + ".nif";
+                for (int j = 0; j < 8; ++j)
+                {
+                    const ESM::RefId item = ESM::RefId::stringRefId("item_" + std::to_string(j));
+                    record.mInventory.mList.push_back(ESM::ContItem{ .mCount = j + 1, .mItem = item });
+                }
+                writeRecord(record, writer);
+            }
+            else
+            {
+                ESM::Static record;
+                record.blank();
+                record.mId = ESM::RefId::stringRefId(name);
+                record.mModel = "x\\ex_static_" + std::to_string(i % 512) + ".nif";
+                writeRecord(record, writer);
+            }
+        }
+
+        writer.close();
+
+        return stream.str();
+    }
+
+    void open(const std::string& content, ESM::ESMReader& reader)
+    {
+        reader.open(std::make_unique<Files::IMemStream>(content.data(), content.size()), "benchmark.esp");
+    }
+
+    // Reads all subrecords without interpreting them
+    void iterateRecords(benchmark::State& state, const std::string& content)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            ESM::ESMReader reader;
+            open(content, reader);
+            while (reader.hasMoreRecs())
+            {
+                benchmark::DoNotOptimize(reader.getRecName());
+                reader.getRecHeader();
+                while (reader.hasMoreSubs())
+                {
+                    reader.getSubName();
+                    reader.skipHSub();
+                }
+            }
+        }
+
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(content.size()));
+    }
+
+    template <class T>
+    void loadRecord(ESM::ESMReader& reader)
+    {
+        T record;
+        bool isDeleted = false;
+        record.load(reader, isDeleted);
+        benchmark::DoNotOptimize(record);
+    }
+
+    void iterateGeneratedRecords(benchmark::State& state)
+    {
+        iterateRecords(state, generateContentFile(static_cast<std::size_t>(state.range(0))));
+    }
+
+    void loadGeneratedRecords(benchmark::State& state)
+    {
+        const std::string content = generateContentFile(static_cast<std::size_t>(state.range(0)));
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            ESM::ESMReader reader;
+            open(content, reader);
+            while (reader.hasMoreRecs())
+            {
+                const ESM::NAME name = reader.getRecName();
+                reader.getRecHeader();
+                switch (name.toInt())
+                {
+                    case ESM::REC_STAT:
+                        loadRecord<ESM::Static>(reader);
+                        break;
+                    case ESM::REC_CONT:
+                        loadRecord<ESM::Container>(reader);
+                        break;
+                    case ESM::REC_LAND:
+                        loadRecord<ESM::Land>(reader);
+                        break;
+                    default:
+                        reader.skipRecord();
+                        break;
+                }
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(iterateGeneratedRecords)->RangeMultiplier(8)->Range(1 << 8, 1 << 14);
+BENCHMARK(loadGeneratedRecords)->RangeMultiplier(8)->Range(1 << 8, 1 << 14);
+
+int main(int argc, char* argv[])
+{
+    for (const std::filesystem::path& path : Benchmarks::findContentFiles())
+    {
+        // Read into memory to exclude IO from the measurement
+        std::ifstream stream(path, std::ios::binary);
+        std::string content(std::istreambuf_iterator<char>(stream), {});
+        const std::string name = "iterateDataRecords/" + Files::pathToUnicodeString(path.filename());
+        benchmark::RegisterBenchmark(name.c_str(), [content = std::move(content)](benchmark::State& state) {
+            iterateRecords(state, content);
+        })->Unit(benchmark::kMillisecond);
+    }
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
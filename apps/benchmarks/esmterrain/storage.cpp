@@ -0,0 +1,240 @@
+#include <benchmark/benchmark.h>
+
+#include "../data.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm/defs.hpp>
+#include <components/esm/exteriorcelllocation.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/loadcell.hpp>
+#include <components/esm3/loadland.hpp>
+#include <components/esmterrain/storage.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <osg/Array>
+#include <osg/Vec2f>
+#include <osg/ref_ptr>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr int loadFlags
+        = ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX;
+
+    class TestStorage final : public ESMTerrain::Storage
+    {
+    public:
+        explicit TestStorage(const VFS::Manager* vfs)
+            : ESMTerrain::Storage(vfs)
+        {
+        }
+
+        void addLand(const ESM::Land& land)
+        {
+            mLands[{ land.mX, land.mY }] = new ESMTerrain::LandObject(land, loadFlags);
+        }
+
+        bool empty() const { return mLands.empty(); }
+
+        osg::ref_ptr<const ESMTerrain::LandObject> getLand(ESM::ExteriorCellLocation cellLocation) override
+        {
+            const auto it = mLands.find({ cellLocation.mX, cellLocation.mY });
+            if (it == mLands.end())
+                return nullptr;
+            return it->second;
+        }
+
+        const std::string* getLandTexture(std::uint16_t /*index*/, int /*plugin*/) override { return nullptr; }
+
+        void getBounds(float& minX, float& maxX, float& minY, float& maxY, ESM::RefId /*worldspace*/) override
+        {
+            minX = minY = std::numeric_limits<float>::max();
+            maxX = maxY = std::numeric_limits<float>::lowest();
+            for (const auto& [position, land] : mLands)
+            {
+                minX = std::min(minX, static_cast<float>(position.first));
+                maxX = std::max(maxX, static_cast<float>(position.first + 1));
+                minY = std::min(minY, static_cast<float>(position.second));
+                maxY = std::max(maxY, static_cast<float>(position.second + 1));
+            }
+        }
+
+    private:
+        std::map<std::pair<int, int>, osg::ref_ptr<const ESMTerrain::LandObject>> mLands;
+    };
+
+    // Smooth hills continuous over the cell borders with varying vertex colours
+    ESM::Land generateLand(int cellX, int cellY)
+    {
+        ESM::Land land;
+        land.blank();
+        land.mX = cellX;
+        land.mY = cellY;
+        ESM::Land::LandData& data = *land.getLandData();
+        data.mMinHeight = std::numeric_limits<float>::max();
+        data.mMaxHeight = std::numeric_limits<float>::lowest();
+        for (int y = 0; y < ESM::Land::LAND_SIZE; ++y)
+            for (int x = 0; x < ESM::Land::LAND_SIZE; ++x)
+            {
+                const float worldX = static_cast<float>(cellX * (ESM::Land::LAND_SIZE - 1) + x);
+                const float worldY = static_cast<float>(cellY * (ESM::Land::LAND_SIZE - 1) + y);
+                const float height = 1024 * std::sin(worldX / 37) * std::cos(worldY / 53) + 64 * std::sin(worldX / 5);
+                const std::size_t index = static_cast<std::size_t>(y * ESM::Land::LAND_SIZE + x);
+                data.mHeights[index] = height;
+                data.mMinHeight = std::min(data.mMinHeight, height);
+                data.mMaxHeight = std::max(data.mMaxHeight, height);
+                data.mColours[index * 3] = static_cast<std::uint8_t>(x * 4);
+                data.mColours[index * 3 + 1] = static_cast<std::uint8_t>(y * 4);
+            }
+        return land;
+    }
+
+    // Chunk centers covering the storage bounds the same way as the terrain quad tree leafs
+    std::vector<osg::Vec2f> getChunkCenters(TestStorage& storage, float size)
+    {
+        float minX, maxX, minY, maxY;
+        storage.getBounds(minX, maxX, minY, maxY, ESM::Cell::sDefaultWorldspaceId);
+        std::vector<osg::Vec2f> result;
+        for (float y = minY; y + size <= maxY; y += size)
+            for (float x = minX; x + size <= maxX; x += size)
+                result.emplace_back(x + size / 2, y + size / 2);
+        if (result.empty())
+            result.emplace_back((minX + maxX) / 2, (minY + maxY) / 2);
+        return result;
+    }
+
+    void fillVertexBuffers(benchmark::State& state, TestStorage& storage)
+    {
+        const int lodLevel = static_cast<int>(state.range(0));
+        const float size = static_cast<float>(state.range(1));
+        const std::vector<osg::Vec2f> centers = getChunkCenters(storage, size);
+
+        std::size_t index = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            // Terrain::ChunkManager creates new arrays for each chunk
+            osg::ref_ptr<osg::Vec3Array> positions(new osg::Vec3Array);
+            osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array);
+            osg::ref_ptr<osg::Vec4ubArray> colours(new osg::Vec4ubArray);
+            storage.fillVertexBuffers(lodLevel, size, centers[index], ESM::Cell::sDefaultWorldspaceId, *positions,
+                *normals, *colours);
+            benchmark::DoNotOptimize(positions->data());
+            if (++index == centers.size())
+                index = 0;
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void fillCompactVertexBuffers(benchmark::State& state, TestStorage& storage)
+    {
+        const int lodLevel = static_cast<int>(state.range(0));
+        const float size = static_cast<float>(state.range(1));
+        const std::vector<osg::Vec2f> centers = getChunkCenters(storage, size);
+
+        std::size_t index = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            osg::ref_ptr<osg::Vec2sArray> vertices(new osg::Vec2sArray);
+            osg::ref_ptr<osg::Vec4ubArray> colours(new osg::Vec4ubArray);
+            benchmark::DoNotOptimize(storage.fillCompactVertexBuffers(
+                lodLevel, size, centers[index], ESM::Cell::sDefaultWorldspaceId, *vertices, *colours));
+            benchmark::DoNotOptimize(vertices->data());
+            if (++index == centers.size())
+                index = 0;
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    osg::ref_ptr<TestStorage> generateStorage(const VFS::Manager& vfs)
+    {
+        constexpr int cellsPerSide = 16;
+        osg::ref_ptr<TestStorage> storage(new TestStorage(&vfs));
+        for (int y = -cellsPerSide / 2; y < cellsPerSide / 2; ++y)
+            for (int x = -cellsPerSide / 2; x < cellsPerSide / 2; ++x)
+                storage->addLand(generateLand(x, y));
+        return storage;
+    }
+
+    void fillGeneratedVertexBuffers(benchmark::State& state)
+    {
+        const VFS::Manager vfs;
+        fillVertexBuffers(state, *generateStorage(vfs));
+    }
+
+    void fillGeneratedCompactVertexBuffers(benchmark::State& state)
+    {
+        const VFS::Manager vfs;
+        fillCompactVertexBuffers(state, *generateStorage(vfs));
+    }
+
+    // Loads land records of the TES3 content files in the data directory, later files override the earlier ones
+    void loadDataLands(TestStorage& storage)
+    {
+        for (const std::filesystem::path& path : Benchmarks::findContentFiles())
+        {
+            try
+            {
+                ESM::ESMReader reader;
+                reader.open(path);
+                while (reader.hasMoreRecs())
+                {
+                    const ESM::NAME name = reader.getRecName();
+                    reader.getRecHeader();
+                    if (name.toInt() != ESM::REC_LAND)
+                    {
+                        reader.skipRecord();
+                        continue;
+                    }
+                    ESM::Land land;
+                    bool isDeleted = false;
+                    land.load(reader, isDeleted);
+                    if (!isDeleted)
+                        storage.addLand(land);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Skipping " << path << ": " << e.what();
+            }
+        }
+    }
+}
+
+// Arguments are the lod level and the chunk size in cells
+BENCHMARK(fillGeneratedVertexBuffers)->Args({ 0, 1 })->Args({ 1, 2 })->Args({ 2, 4 })->Args({ 3, 8 })->Args({ 4, 16 });
+BENCHMARK(fillGeneratedCompactVertexBuffers)
+    ->Args({ 0, 1 })
+    ->Args({ 1, 2 })
+    ->Args({ 2, 4 })
+    ->Args({ 3, 8 })
+    ->Args({ 4, 16 });
+
+int main(int argc, char* argv[])
+{
+    const VFS::Manager vfs;
+    const osg::ref_ptr<TestStorage> storage(new TestStorage(&vfs));
+    loadDataLands(*storage);
+    if (!storage->empty())
+        benchmark::RegisterBenchmark("fillDataVertexBuffers", [&](benchmark::State& state) {
+            fillVertexBuffers(state, *storage);
+        })->Args({ 0, 1 })->Args({ 1, 2 })->Args({ 2, 4 })->Args({ 3, 8 })->Args({ 4, 16 });
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
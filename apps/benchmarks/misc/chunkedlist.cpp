@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+
+#include "components/esm/refid.hpp"
+#include "components/misc/chunkedlist.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // Close to the size of MWWorld::LiveCellRef.
+    struct Ref
+    {
+        ESM::RefId mId;
+        bool mEnabled = true;
+        std::array<float, 48> mData{};
+    };
+
+    // Exterior cells store references of different types in different lists, so nodes of a list are interleaved with
+    // the nodes of other lists when loaded.
+    constexpr std::size_t listsCount = 8;
+
+    template <class List>
+    std::array<List, listsCount> makeCell(std::size_t refsCount, std::size_t uniqueIdsCount)
+    {
+        std::array<List, listsCount> result;
+        std::minstd_rand random;
+        std::uniform_int_distribution<std::size_t> distribution(0, uniqueIdsCount - 1);
+        for (std::size_t i = 0; i < refsCount; ++i)
+        {
+            Ref ref;
+            ref.mId = ESM::RefId::stringRefId("ref_" + std::to_string(distribution(random)));
+            ref.mData[0] = static_cast<float>(i);
+            result[i % listsCount].push_back(std::move(ref));
+        }
+        return result;
+    }
+
+    template <class List>
+    void iterate(benchmark::State& state)
+    {
+        const std::size_t refsCount = static_cast<std::size_t>(state.range(0));
+        const auto cell = makeCell<List>(refsCount, refsCount);
+        for ([[maybe_unused]] auto _ : state)
+        {
+            float sum = 0;
+            for (const List& list : cell)
+                for (const Ref& ref : list)
+                    if (ref.mEnabled)
+                        sum += ref.mData[0];
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * refsCount);
+    }
+
+    template <class List>
+    void searchLinear(benchmark::State& state)
+    {
+        const std::size_t refsCount = static_cast<std::size_t>(state.range(0));
+        const std::size_t uniqueIdsCount = refsCount / 4;
+        const auto cell = makeCell<List>(refsCount, uniqueIdsCount);
+        std::minstd_rand random;
+        std::uniform_int_distribution<std::size_t> distribution(0, uniqueIdsCount - 1);
+        for ([[maybe_unused]] auto _ : state)
+        {
+            state.PauseTiming();
+            const ESM::RefId id = ESM::RefId::stringRefId("ref_" + std::to_string(distribution(random)));
+            state.ResumeTiming();
+            const Ref* found = nullptr;
+            for (const List& list : cell)
+            {
+                for (const Ref& ref : list)
+                {
+                    if (ref.mEnabled && ref.mId == id)
+                    {
+                        found = &ref;
+                        break;
+                    }
+                }
+                if (found != nullptr)
+                    break;
+            }
+            benchmark::DoNotOptimize(found);
+        }
+    }
+
+    // Same approach as CellStore::findMergedRef.
+    void searchIndexed(benchmark::State& state)
+    {
+        constexpr std::uint32_t noIndex = std::numeric_limits<std::uint32_t>::max();
+        const std::size_t refsCount = static_cast<std::size_t>(state.range(0));
+        const std::size_t uniqueIdsCount = refsCount / 4;
+        const auto cell = makeCell<Misc::ChunkedList<Ref>>(refsCount, uniqueIdsCount);
+        std::vector<const Ref*> refs;
+        for (const auto& list : cell)
+            for (const Ref& ref : list)
+                refs.push_back(&ref);
+        std::unordered_map<ESM::RefId, std::uint32_t> index;
+        std::vector<std::uint32_t> next(refs.size(), noIndex);
+        for (std::size_t i = refs.size(); i > 0; --i)
+        {
+            const auto [it, inserted] = index.emplace(refs[i - 1]->mId, static_cast<std::uint32_t>(i - 1));
+            if (!inserted)
+            {
+                next[i - 1] = it->second;
+                it->second = static_cast<std::uint32_t>(i - 1);
+            }
+        }
+        std::minstd_rand random;
+        std::uniform_int_distribution<std::size_t> distribution(0, uniqueIdsCount - 1);
+        for ([[maybe_unused]] auto _ : state)
+        {
+            state.PauseTiming();
+            const ESM::RefId id = ESM::RefId::stringRefId("ref_" + std::to_string(distribution(random)));
+            state.ResumeTiming();
+            const Ref* found = nullptr;
+            if (const auto it = index.find(id); it != index.end())
+            {
+                for (std::uint32_t i = it->second; i != noIndex; i = next[i])
+                {
+                    if (refs[i]->mEnabled)
+                    {
+                        found = refs[i];
+                        break;
+                    }
+                }
+            }
+            benchmark::DoNotOptimize(found);
+        }
+    }
+
+    void iterateStdList(benchmark::State& state)
+    {
+        iterate<std::list<Ref>>(state);
+    }
+
+    void iterateChunkedList(benchmark::State& state)
+    {
+        iterate<Misc::ChunkedList<Ref>>(state);
+    }
+
+    void searchLinearStdList(benchmark::State& state)
+    {
+        searchLinear<std::list<Ref>>(state);
+    }
+
+    void searchLinearChunkedList(benchmark::State& state)
+    {
+        searchLinear<Misc::ChunkedList<Ref>>(state);
+    }
+}
+
+BENCHMARK(iterateStdList)->Arg(1024)->Arg(16384);
+BENCHMARK(iterateChunkedList)->Arg(1024)->Arg(16384);
+BENCHMARK(searchLinearStdList)->Arg(1024)->Arg(16384);
+BENCHMARK(searchLinearChunkedList)->Arg(1024)->Arg(16384);
+BENCHMARK(searchIndexed)->Arg(1024)->Arg(16384);
+
+BENCHMARK_MAIN();
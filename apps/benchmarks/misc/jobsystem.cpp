@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include "components/misc/jobsystem.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t jobsCount = 1024;
+
+    void work(std::size_t iterations)
+    {
+        float value = 1;
+        for (std::size_t i = 0; i < iterations; ++i)
+            value = std::sqrt(value + static_cast<float>(i));
+        benchmark::DoNotOptimize(value);
+    }
+
+    void scheduleAndWaitIndependentJobs(benchmark::State& state)
+    {
+        Misc::JobSystem jobSystem(static_cast<std::size_t>(state.range(0)));
+        const std::size_t iterations = static_cast<std::size_t>(state.range(1));
+        std::vector<Misc::JobHandle> jobs;
+        jobs.reserve(jobsCount);
+        for ([[maybe_unused]] auto _ : state)
+        {
+            jobs.clear();
+            for (std::size_t i = 0; i < jobsCount; ++i)
+                jobs.push_back(jobSystem.schedule([=] { work(iterations); }));
+            for (const Misc::JobHandle& job : jobs)
+                job->wait();
+        }
+        state.SetItemsProcessed(state.iterations() * jobsCount);
+    }
+
+    void scheduleAndWaitJobsChain(benchmark::State& state)
+    {
+        Misc::JobSystem jobSystem(static_cast<std::size_t>(state.range(0)));
+        for ([[maybe_unused]] auto _ : state)
+        {
+            Misc::JobHandle job = jobSystem.schedule([] {});
+            for (std::size_t i = 1; i < jobsCount; ++i)
+                job = jobSystem.schedule([] {}, std::span(&job, 1));
+            job->wait();
+        }
+        state.SetItemsProcessed(state.iterations() * jobsCount);
+    }
+
+    void scheduleNestedJobs(benchmark::State& state)
+    {
+        Misc::JobSystem jobSystem(static_cast<std::size_t>(state.range(0)));
+        for ([[maybe_unused]] auto _ : state)
+        {
+            // Jobs scheduled by worker threads go to their own queues and are stolen by the others
+            jobSystem
+                .schedule([&] {
+                    std::vector<Misc::JobHandle> jobs;
+                    jobs.reserve(jobsCount);
+                    for (std::size_t i = 0; i < jobsCount; ++i)
+                        jobs.push_back(jobSystem.schedule([] { work(64); }));
+                    for (const Misc::JobHandle& job : jobs)
+                        job->wait();
+                })
+                ->wait();
+        }
+        state.SetItemsProcessed(state.iterations() * jobsCount);
+    }
+
+    void parallelFor(benchmark::State& state)
+    {
+        Misc::JobSystem jobSystem(static_cast<std::size_t>(state.range(0)));
+        const std::size_t grainSize = static_cast<std::size_t>(state.range(1));
+        constexpr std::size_t size = 64 * 1024;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            jobSystem.parallelFor(0, size, grainSize, [](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i)
+                    work(16);
+            });
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+}
+
+BENCHMARK(scheduleAndWaitIndependentJobs)
+    ->ArgsProduct({ { 1, 2, 4, 8 }, { 0, 256 } })
+    ->ArgNames({ "threads", "work" })
+    ->UseRealTime();
+BENCHMARK(scheduleAndWaitJobsChain)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->ArgName("threads")->UseRealTime();
+BENCHMARK(scheduleNestedJobs)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->ArgName("threads")->UseRealTime();
+BENCHMARK(parallelFor)
+    ->ArgsProduct({ { 0, 1, 2, 4, 8 }, { 64, 1024 } })
+    ->ArgNames({ "threads", "grain" })
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,133 @@
+#ifndef OPENMW_APPS_BENCHMARKS_NIF_GENERATE_H
+#define OPENMW_APPS_BENCHMARKS_NIF_GENERATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace Benchmarks
+{
+    namespace NifDetail
+    {
+        template <class T>
+        void write(T value, std::string& out)
+        {
+            char buffer[sizeof(T)];
+            std::memcpy(buffer, &value, sizeof(T));
+            out.append(buffer, sizeof(T));
+        }
+
+        // Sized string and 4 byte boolean as used by NIF 4.0.0.2
+        inline void writeString(std::string_view value, std::string& out)
+        {
+            write(static_cast<std::uint32_t>(value.size()), out);
+            out.append(value);
+        }
+
+        inline void writeBool(bool value, std::string& out)
+        {
+            write(static_cast<std::int32_t>(value), out);
+        }
+
+        inline void writeAVObject(std::string_view name, float x, float y, std::string& out)
+        {
+            writeString(name, out);
+            write(std::int32_t{ -1 }, out); // Extra data
+            write(std::int32_t{ -1 }, out); // Controller
+            write(std::uint16_t{ 0 }, out); // Flags
+            for (const float v : { x, y, 0.0f })
+                write(v, out);
+            for (const float v : { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f })
+                write(v, out);
+            write(1.0f, out); // Scale
+            for (int i = 0; i < 3; ++i)
+                write(0.0f, out); // Velocity
+            write(std::uint32_t{ 0 }, out); // Properties
+            writeBool(false, out); // Bounding volume
+        }
+
+        inline void writeTriShapeData(std::size_t gridSize, std::string& out)
+        {
+            const std::size_t numVertices = gridSize * gridSize;
+            const std::size_t numTriangles = 2 * (gridSize - 1) * (gridSize - 1);
+            const float step = 1.0f / static_cast<float>(gridSize - 1);
+
+            write(static_cast<std::uint16_t>(numVertices), out);
+            writeBool(true, out);
+            for (std::size_t y = 0; y < gridSize; ++y)
+                for (std::size_t x = 0; x < gridSize; ++x)
+                {
+                    write(static_cast<float>(x) * step, out);
+                    write(static_cast<float>(y) * step, out);
+                    write(static_cast<float>((x * 7 + y * 13) % 5) * step, out);
+                }
+            writeBool(true, out);
+            for (std::size_t i = 0; i < numVertices; ++i)
+                for (const float v : { 0.0f, 0.0f, 1.0f })
+                    write(v, out);
+            for (const float v : { 0.5f, 0.5f, 0.0f, 1.0f })
+                write(v, out); // Bounding sphere
+            writeBool(false, out); // Vertex colors
+            write(std::uint16_t{ 1 }, out); // Number of UV sets
+            writeBool(true, out);
+            for (std::size_t y = 0; y < gridSize; ++y)
+                for (std::size_t x = 0; x < gridSize; ++x)
+                {
+                    write(static_cast<float>(x) * step, out);
+                    write(static_cast<float>(y) * step, out);
+                }
+            write(static_cast<std::uint16_t>(numTriangles), out);
+            write(static_cast<std::uint32_t>(numTriangles * 3), out);
+            for (std::size_t y = 0; y + 1 < gridSize; ++y)
+                for (std::size_t x = 0; x + 1 < gridSize; ++x)
+                {
+                    const std::size_t i = y * gridSize + x;
+                    for (const std::size_t v : { i, i + 1, i + gridSize, i + 1, i + gridSize + 1, i + gridSize })
+                        write(static_cast<std::uint16_t>(v), out);
+                }
+            write(std::uint16_t{ 0 }, out); // Match groups
+        }
+    }
+
+    // Generates a Morrowind (4.0.0.2) NIF file with a root NiNode holding shapesCount NiTriShape children. Each
+    // shape is a grid of gridSize x gridSize vertices with normals and a UV set.
+    inline std::string generateNif(std::size_t shapesCount, std::size_t gridSize)
+    {
+        using namespace NifDetail;
+
+        if (gridSize < 2 || gridSize * gridSize > 0xffff || 2 * (gridSize - 1) * (gridSize - 1) > 0xffff)
+            throw std::invalid_argument("Invalid NIF shape grid size: " + std::to_string(gridSize));
+
+        std::string result = "NetImmerse File Format, Version 4.0.0.2\n";
+        write(std::uint32_t{ 0x04000002 }, result);
+        write(static_cast<std::uint32_t>(1 + 2 * shapesCount), result);
+
+        writeString("NiNode", result);
+        writeAVObject("Root", 0, 0, result);
+        write(static_cast<std::uint32_t>(shapesCount), result);
+        for (std::size_t i = 0; i < shapesCount; ++i)
+            write(static_cast<std::int32_t>(1 + 2 * i), result);
+        write(std::uint32_t{ 0 }, result); // Effects
+
+        for (std::size_t i = 0; i < shapesCount; ++i)
+        {
+            writeString("NiTriShape", result);
+            writeAVObject("Shape" + std::to_string(i), static_cast<float>(i % 16), static_cast<float>(i / 16), result);
+            write(static_cast<std::int32_t>(2 + 2 * i), result); // Data
+            write(std::int32_t{ -1 }, result); // Skin instance
+
+            writeString("NiTriShapeData", result);
+            writeTriShapeData(gridSize, result);
+        }
+
+        write(std::uint32_t{ 1 }, result); // Roots
+        write(std::int32_t{ 0 }, result);
+
+        return result;
+    }
+}
+
+#endif
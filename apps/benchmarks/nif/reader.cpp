@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include "../data.hpp"
+#include "generate.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/memorystream.hpp>
+#include <components/nif/niffile.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr VFS::Path::NormalizedView generatedPath("meshes/generated.nif");
+
+    void parse(VFS::Path::NormalizedView path, const std::string& content)
+    {
+        Nif::NIFFile file(path);
+        Nif::Reader reader(file, nullptr);
+        reader.parse(std::make_unique<Files::IMemStream>(content.data(), content.size()));
+        benchmark::DoNotOptimize(file);
+    }
+
+    void parseGeneratedNif(benchmark::State& state)
+    {
+        const std::string content = Benchmarks::generateNif(
+            static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+
+        for ([[maybe_unused]] auto _ : state)
+            parse(generatedPath, content);
+
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(content.size()));
+    }
+
+    void parseDataNifs(benchmark::State& state, const std::vector<std::pair<VFS::Path::Normalized, std::string>>& files)
+    {
+        std::size_t size = 0;
+        for (const auto& [path, content] : files)
+            size += content.size();
+
+        for ([[maybe_unused]] auto _ : state)
+            for (const auto& [path, content] : files)
+                parse(path, content);
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(files.size()));
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size));
+    }
+}
+
+BENCHMARK(parseGeneratedNif)->Args({ 1, 16 })->Args({ 16, 16 })->Args({ 16, 64 })->Args({ 256, 4 });
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::pair<VFS::Path::Normalized, std::string>> files;
+    if (const std::unique_ptr<VFS::Manager> vfs = Benchmarks::makeDataVFS())
+    {
+        for (auto& [path, content] : Benchmarks::readDataFiles(*vfs, ".nif"))
+        {
+            try
+            {
+                parse(path, content);
+                files.emplace_back(std::move(path), std::move(content));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Skipping " << path << ": " << e.what();
+            }
+        }
+        benchmark::RegisterBenchmark("parseDataNifs", [&](benchmark::State& state) { parseDataNifs(state, files); })
+            ->Unit(benchmark::kMillisecond);
+    }
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
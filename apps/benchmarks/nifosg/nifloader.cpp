@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include "../data.hpp"
+#include "../nif/generate.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/memorystream.hpp>
+#include <components/nif/niffile.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/resource/bgsmfilemanager.hpp>
+#include <components/resource/imagemanager.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr VFS::Path::NormalizedView generatedPath("meshes/generated.nif");
+
+    std::unique_ptr<Nif::NIFFile> parse(VFS::Path::NormalizedView path, const std::string& content)
+    {
+        auto file = std::make_unique<Nif::NIFFile>(path);
+        Nif::Reader reader(*file, nullptr);
+        reader.parse(std::make_unique<Files::IMemStream>(content.data(), content.size()));
+        return file;
+    }
+
+    void loadGeneratedNif(benchmark::State& state)
+    {
+        const std::unique_ptr<Nif::NIFFile> file = parse(generatedPath,
+            Benchmarks::generateNif(
+                static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1))));
+        const VFS::Manager vfs;
+        Resource::ImageManager imageManager(&vfs, 0);
+        Resource::BgsmFileManager materialManager(&vfs, 0);
+
+        for ([[maybe_unused]] auto _ : state)
+            benchmark::DoNotOptimize(NifOsg::Loader::load(*file, &imageManager, &materialManager));
+    }
+
+    // Textures are read from the data VFS by the first iteration, the following ones use the image cache
+    void loadDataNifs(benchmark::State& state, const VFS::Manager& vfs,
+        const std::vector<std::unique_ptr<Nif::NIFFile>>& files)
+    {
+        Resource::ImageManager imageManager(&vfs, 0);
+        Resource::BgsmFileManager materialManager(&vfs, 0);
+
+        for ([[maybe_unused]] auto _ : state)
+            for (const std::unique_ptr<Nif::NIFFile>& file : files)
+                benchmark::DoNotOptimize(NifOsg::Loader::load(*file, &imageManager, &materialManager));
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(files.size()));
+    }
+}
+
+BENCHMARK(loadGeneratedNif)->Args({ 1, 16 })->Args({ 16, 16 })->Args({ 16, 64 })->Args({ 256, 4 });
+
+int main(int argc, char* argv[])
+{
+    const std::unique_ptr<VFS::Manager> vfs = Benchmarks::makeDataVFS();
+    std::vector<std::unique_ptr<Nif::NIFFile>> files;
+    if (vfs != nullptr)
+    {
+        for (const auto& [path, content] : Benchmarks::readDataFiles(*vfs, ".nif"))
+        {
+            try
+            {
+                files.push_back(parse(path, content));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Skipping " << path << ": " << e.what();
+            }
+        }
+        benchmark::RegisterBenchmark("loadDataNifs", [&](benchmark::State& state) { loadDataNifs(state, *vfs, files); })
+            ->Unit(benchmark::kMillisecond);
+    }
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <benchmark/benchmark.h>
+
+#include "../data.hpp"
+
+#include <components/testing/util.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/pathutil.hpp>
+#include <components/vfs/recursivedirectoryiterator.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr std::array<std::string_view, 4> directories = { "Meshes\\", "Textures\\", "Icons\\", "Sound\\Fx\\" };
+    constexpr std::array<std::string_view, 4> extensions = { ".NIF", ".DDS", ".TGA", ".WAV" };
+
+    // Paths in the form they are stored in the content files: mixed case with backslashes
+    std::vector<std::string> generatePaths(std::size_t count, std::string_view prefix)
+    {
+        std::vector<std::string> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::string path(directories[i % directories.size()]);
+            path += "Group_" + std::to_string(i % 61) + "\\";
+            path += prefix;
+            path += "Object_" + std::to_string(i);
+            path += extensions[i % extensions.size()];
+            result.push_back(std::move(path));
+        }
+        std::shuffle(result.begin(), result.end(), std::minstd_rand(42));
+        return result;
+    }
+
+    std::vector<VFS::Path::Normalized> normalize(const std::vector<std::string>& paths)
+    {
+        return std::vector<VFS::Path::Normalized>(paths.begin(), paths.end());
+    }
+
+    struct GeneratedVFS
+    {
+        TestingOpenMW::VFSTestFile mFile{ std::string() };
+        std::vector<std::string> mPaths;
+        std::unique_ptr<VFS::Manager> mVFS;
+
+        explicit GeneratedVFS(std::size_t count)
+            : mPaths(generatePaths(count, ""))
+        {
+            VFS::FileMap files;
+            for (const std::string& path : mPaths)
+                files.emplace(VFS::Path::Normalized(path), &mFile);
+            mVFS = TestingOpenMW::createTestVFS(std::move(files));
+        }
+    };
+
+    template <class Function>
+    void forEachCyclic(benchmark::State& state, const auto& values, Function&& function)
+    {
+        std::size_t index = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            function(values[index]);
+            if (++index == values.size())
+                index = 0;
+        }
+    }
+
+    void findExisting(benchmark::State& state)
+    {
+        const GeneratedVFS vfs(static_cast<std::size_t>(state.range(0)));
+        const std::vector<VFS::Path::Normalized> paths = normalize(vfs.mPaths);
+        forEachCyclic(
+            state, paths, [&](const VFS::Path::Normalized& v) { benchmark::DoNotOptimize(vfs.mVFS->find(v)); });
+    }
+
+    void findMissing(benchmark::State& state)
+    {
+        const GeneratedVFS vfs(static_cast<std::size_t>(state.range(0)));
+        const std::vector<VFS::Path::Normalized> paths
+            = normalize(generatePaths(static_cast<std::size_t>(state.range(0)), "Missing_"));
+        forEachCyclic(
+            state, paths, [&](const VFS::Path::Normalized& v) { benchmark::DoNotOptimize(vfs.mVFS->find(v)); });
+    }
+
+    void existsExisting(benchmark::State& state)
+    {
+        const GeneratedVFS vfs(static_cast<std::size_t>(state.range(0)));
+        const std::vector<VFS::Path::Normalized> paths = normalize(vfs.mPaths);
+        forEachCyclic(
+            state, paths, [&](const VFS::Path::Normalized& v) { benchmark::DoNotOptimize(vfs.mVFS->exists(v)); });
+    }
+
+    // Includes normalization as done for paths coming from the content files
+    void findNotNormalized(benchmark::State& state)
+    {
+        const GeneratedVFS vfs(static_cast<std::size_t>(state.range(0)));
+        forEachCyclic(state, vfs.mPaths,
+            [&](const std::string& v) { benchmark::DoNotOptimize(vfs.mVFS->find(VFS::Path::Normalized(v))); });
+    }
+
+    void findDataFiles(
+        benchmark::State& state, const VFS::Manager& vfs, const std::vector<VFS::Path::Normalized>& paths)
+    {
+        forEachCyclic(state, paths, [&](const VFS::Path::Normalized& v) { benchmark::DoNotOptimize(vfs.find(v)); });
+    }
+
+    void existsDataFiles(
+        benchmark::State& state, const VFS::Manager& vfs, const std::vector<VFS::Path::Normalized>& paths)
+    {
+        forEachCyclic(state, paths, [&](const VFS::Path::Normalized& v) { benchmark::DoNotOptimize(vfs.exists(v)); });
+    }
+}
+
+BENCHMARK(findExisting)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK(findMissing)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK(existsExisting)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK(findNotNormalized)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+int main(int argc, char* argv[])
+{
+    const std::unique_ptr<VFS::Manager> vfs = Benchmarks::makeDataVFS();
+    std::vector<VFS::Path::Normalized> paths;
+    if (vfs != nullptr)
+    {
+        for (const VFS::Path::Normalized& path : vfs->getRecursiveDirectoryIterator())
+            paths.push_back(path);
+        std::shuffle(paths.begin(), paths.end(), std::minstd_rand(42));
+        if (!paths.empty())
+        {
+            benchmark::RegisterBenchmark(
+                "findDataFiles", [&](benchmark::State& state) { findDataFiles(state, *vfs, paths); });
+            benchmark::RegisterBenchmark(
+                "existsDataFiles", [&](benchmark::State& state) { existsDataFiles(state, *vfs, paths); });
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include <components/debug/traceformat.hpp>
+#include <components/debug/tracing.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Debug::Tracing;
+
+    struct DebugTracingTest : Test
+    {
+        DebugTracingTest()
+        {
+            clear();
+            setEnabled(true);
+        }
+
+        ~DebugTracingTest() override { setEnabled(false); }
+    };
+
+    std::vector<std::string> getEventNames(const std::vector<ThreadTrace>& threads, std::string_view threadName)
+    {
+        std::vector<std::string> result;
+        for (const ThreadTrace& thread : threads)
+            if (thread.mName == threadName)
+                for (const TraceEvent& event : thread.mEvents)
+                    result.emplace_back(event.mName);
+        return result;
+    }
+
+    std::size_t countPackets(std::string_view data)
+    {
+        std::size_t result = 0;
+        while (!data.empty())
+        {
+            // TracePacket field with a length delimited value
+            if (data.front() != 0x0a)
+                return 0;
+            data.remove_prefix(1);
+            std::uint64_t size = 0;
+            for (int shift = 0; !data.empty(); shift += 7)
+            {
+                const auto byte = static_cast<std::uint8_t>(data.front());
+                data.remove_prefix(1);
+                size |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0)
+                    break;
+            }
+            if (size > data.size())
+                return 0;
+            data.remove_prefix(size);
+            ++result;
+        }
+        return result;
+    }
+
+    TEST_F(DebugTracingTest, zoneShouldNotBeRecordedWhenDisabled)
+    {
+        setEnabled(false);
+        std::thread([] {
+            setThreadName("disabled");
+            OPENMW_TRACE_ZONE("zone");
+        }).join();
+        EXPECT_THAT(getEventNames(collect(), "disabled"), IsEmpty());
+    }
+
+    TEST_F(DebugTracingTest, nestedZonesShouldBeRecordedInOrderOfEnd)
+    {
+        std::thread([] {
+            setThreadName("nested");
+            OPENMW_TRACE_ZONE("outer");
+            {
+                OPENMW_TRACE_ZONE("inner");
+            }
+        }).join();
+        const std::vector<ThreadTrace> threads = collect();
+        EXPECT_THAT(getEventNames(threads, "nested"), ElementsAre("inner", "outer"));
+        const auto thread
+            = std::find_if(threads.begin(), threads.end(), [](const ThreadTrace& v) { return v.mName == "nested"; });
+        ASSERT_NE(thread, threads.end());
+        const TraceEvent& inner = thread->mEvents[0];
+        const TraceEvent& outer = thread->mEvents[1];
+        EXPECT_LE(outer.mBegin, inner.mBegin);
+        EXPECT_LE(inner.mEnd, outer.mEnd);
+    }
+
+    TEST_F(DebugTracingTest, clearShouldDropRecordedEvents)
+    {
+        std::thread thread([] {
+            setThreadName("cleared");
+            OPENMW_TRACE_ZONE("zone");
+        });
+        thread.join();
+        clear();
+        EXPECT_THAT(getEventNames(collect(), "cleared"), IsEmpty());
+    }
+
+    TEST_F(DebugTracingTest, shouldKeepOnlyLatestEventsWhenBufferIsFull)
+    {
+        setBufferSize(2);
+        std::thread([] {
+            setThreadName("overflow");
+            {
+                OPENMW_TRACE_ZONE("first");
+            }
+            {
+                OPENMW_TRACE_ZONE("second");
+            }
+            {
+                OPENMW_TRACE_ZONE("third");
+            }
+        }).join();
+        setBufferSize(64 * 1024);
+        EXPECT_THAT(getEventNames(collect(), "overflow"), ElementsAre("second", "third"));
+    }
+
+    TEST(DebugTracingFormatTest, chromeTraceShouldContainThreadNamesAndCompleteEvents)
+    {
+        const std::vector<ThreadTrace> threads{
+            ThreadTrace{ .mId = 2, .mName = "Main \"1\"", .mEvents = { TraceEvent{ "Frame", 2000, 3500 } } },
+        };
+        std::ostringstream stream;
+        writeChromeTrace(threads, stream);
+        EXPECT_EQ(stream.str(),
+            "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+            R"({"name":"thread_name","ph":"M","pid":1,"tid":2,"args":{"name":"Main \"1\""}},)"
+            "\n"
+            R"({"name":"Frame","ph":"X","pid":1,"tid":2,"ts":0.000,"dur":1.500})"
+            "\n]}\n");
+    }
+
+    TEST(DebugTracingFormatTest, perfettoTraceShouldContainPacketPerSliceBoundaryAndThread)
+    {
+        const std::vector<ThreadTrace> threads{
+            ThreadTrace{ .mId = 1,
+                .mName = "Main",
+                .mEvents = { TraceEvent{ "Inner", 1100, 1200 }, TraceEvent{ "Outer", 1000, 2000 } } },
+            ThreadTrace{ .mId = 2, .mName = "Worker", .mEvents = {} },
+        };
+        std::ostringstream stream;
+        writePerfettoTrace(threads, stream);
+        const std::string data = stream.str();
+        EXPECT_EQ(countPackets(data), 6);
+        EXPECT_THAT(data, HasSubstr("Worker"));
+        EXPECT_THAT(data, HasSubstr("Outer"));
+    }
+}
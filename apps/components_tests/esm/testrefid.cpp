@@ -1,6 +1,7 @@
 #include <components/esm/refid.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
+#include <components/misc/strings/algorithm.hpp>
 #include <components/testing/expecterror.hpp>
 
 #include <gmock/gmock.h>
@@ -9,6 +10,8 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <thread>
+#include <vector>
 
 MATCHER(IsPrint, "")
 {
@@ -158,6 +161,29 @@ namespace ESM
             EXPECT_EQ(hash(lower), hash(upper));
         }
 
+        TEST(ESMRefIdTest, stringRefIdHashIsEqualToCaseInsensitiveStringHash)
+        {
+            const StringRefId id("Some Mixed Case Id");
+            EXPECT_EQ(std::hash<StringRefId>()(id), Misc::StringUtils::CiHash()("some mixed case id"));
+        }
+
+        TEST(ESMRefIdTest, stringRefIdCreatedConcurrentlyFromSameValueIsEqual)
+        {
+            constexpr std::size_t threadsCount = 4;
+            constexpr std::size_t idsCount = 1000;
+            std::vector<std::vector<StringRefId>> ids(threadsCount);
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0; i < threadsCount; ++i)
+                threads.emplace_back([&, i] {
+                    for (std::size_t j = 0; j < idsCount; ++j)
+                        ids[i].emplace_back((i % 2 == 0 ? "concurrent id " : "CONCURRENT ID ") + std::to_string(j));
+                });
+            for (std::thread& thread : threads)
+                thread.join();
+            for (std::size_t i = 1; i < threadsCount; ++i)
+                EXPECT_EQ(ids[i], ids[0]);
+        }
+
         TEST(ESMRefIdTest, hasCaseInsensitiveEqualityWithStringView)
         {
             const RefId a = RefId::stringRefId("a");
@@ -0,0 +1,210 @@
+#include <components/esm/fourcc.hpp>
+#include <components/esm4/common.hpp>
+#include <components/esm4/grouptype.hpp>
+#include <components/esm4/reader.hpp>
+#include <components/esm4/readerutils.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace ESM4
+{
+    namespace
+    {
+        // Builds a TES4 (Oblivion) file, record and group headers are 20 bytes long
+        class TestFile
+        {
+        public:
+            TestFile()
+            {
+                // HEDR: version, number of records, next object id
+                std::string data;
+                appendSubRecord(data, ESM::fourCC("HEDR"), std::string(12, '\0'));
+                appendRecord(REC_TES4, 0, data);
+            }
+
+            // Returns the offset of the record data, which is the reader offset right after the record header
+            std::size_t appendRecord(std::uint32_t type, std::uint32_t id, const std::string& data)
+            {
+                appendValue(type);
+                appendValue(static_cast<std::uint32_t>(data.size()));
+                appendValue(std::uint32_t{ 0 }); // flags
+                appendValue(id);
+                appendValue(std::uint32_t{ 0 }); // revision
+                const std::size_t offset = mData.size();
+                mData += data;
+                return offset;
+            }
+
+            std::size_t appendRecord(std::uint32_t type, std::uint32_t id)
+            {
+                std::string data;
+                appendSubRecord(data, ESM::fourCC("EDID"), "Record" + std::to_string(id) + '\0');
+                return appendRecord(type, id, data);
+            }
+
+            void beginGroup(std::uint32_t label, GroupType type)
+            {
+                mGroups.push_back(mData.size());
+                appendValue(REC_GRUP);
+                appendValue(std::uint32_t{ 0 }); // size, set by endGroup
+                appendValue(label);
+                appendValue(static_cast<std::int32_t>(type));
+                appendValue(std::uint32_t{ 0 }); // stamp, unknown
+            }
+
+            void endGroup()
+            {
+                const std::size_t begin = mGroups.back();
+                mGroups.pop_back();
+                const auto size = static_cast<std::uint32_t>(mData.size() - begin);
+                mData.replace(begin + sizeof(std::uint32_t), sizeof(size), reinterpret_cast<const char*>(&size),
+                    sizeof(size));
+            }
+
+            std::unique_ptr<Reader> makeReader() const
+            {
+                return std::make_unique<Reader>(std::make_unique<std::istringstream>(mData), "test.esp", nullptr,
+                    nullptr);
+            }
+
+        private:
+            std::string mData;
+            std::vector<std::size_t> mGroups;
+
+            template <class T>
+            void appendValue(T value)
+            {
+                mData.append(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+
+            static void appendSubRecord(std::string& data, std::uint32_t type, const std::string& value)
+            {
+                const auto size = static_cast<std::uint16_t>(value.size());
+                data.append(reinterpret_cast<const char*>(&type), sizeof(type));
+                data.append(reinterpret_cast<const char*>(&size), sizeof(size));
+                data += value;
+            }
+        };
+
+        struct VisitedRecord
+        {
+            std::uint32_t mId;
+            std::size_t mOffset;
+            std::size_t mStackSize;
+            std::uint32_t mGroupLabel;
+            std::int32_t mGroupType;
+
+            friend bool operator==(const VisitedRecord& lhs, const VisitedRecord& rhs)
+            {
+                const auto tie = [](const VisitedRecord& v) {
+                    return std::tie(v.mId, v.mOffset, v.mStackSize, v.mGroupLabel, v.mGroupType);
+                };
+                return tie(lhs) == tie(rhs);
+            }
+
+            friend std::ostream& operator<<(std::ostream& stream, const VisitedRecord& value)
+            {
+                return stream << "VisitedRecord {.mId = " << value.mId << ", .mOffset = " << value.mOffset
+                              << ", .mStackSize = " << value.mStackSize << ", .mGroupLabel = " << value.mGroupLabel
+                              << ", .mGroupType = " << value.mGroupType << "}";
+            }
+        };
+
+        struct ESM4ReaderUtilsTest : ::testing::Test
+        {
+            static constexpr std::uint32_t sCellId = 3;
+
+            TestFile mFile;
+            std::vector<std::size_t> mOffsets;
+
+            ESM4ReaderUtilsTest()
+            {
+                // Skipped as a whole, has a nested group
+                mFile.beginGroup(REC_DIAL, Grp_RecordType);
+                mOffsets.push_back(mFile.appendRecord(REC_DIAL, 1));
+                mFile.beginGroup(1, Grp_TopicChild);
+                mOffsets.push_back(mFile.appendRecord(REC_INFO, 2));
+                mFile.endGroup();
+                mFile.endGroup();
+
+                // Entered, the nested group between the two cells is skipped
+                mFile.beginGroup(REC_CELL, Grp_RecordType);
+                mOffsets.push_back(mFile.appendRecord(REC_CELL, sCellId));
+                mFile.beginGroup(sCellId, Grp_CellChild);
+                mOffsets.push_back(mFile.appendRecord(REC_REFR, 4));
+                mFile.endGroup();
+                mOffsets.push_back(mFile.appendRecord(REC_CELL, 5));
+                mFile.endGroup();
+
+                mFile.beginGroup(REC_GMST, Grp_RecordType);
+                mOffsets.push_back(mFile.appendRecord(REC_GMST, 6));
+                mFile.endGroup();
+
+                // readAll stops at the header reaching the end of the file, an empty group keeps the last record
+                // visited. Real files have them as well (e.g. HAIR in Skyrim).
+                mFile.beginGroup(REC_HAIR, Grp_RecordType);
+                mFile.endGroup();
+            }
+
+            template <class GroupInvocable>
+            std::vector<VisitedRecord> readAll(GroupInvocable&& groupInvocable) const
+            {
+                std::unique_ptr<Reader> fileReader = mFile.makeReader();
+                std::vector<VisitedRecord> result;
+                ReaderUtils::readAll(
+                    *fileReader,
+                    [&](Reader& reader) {
+                        result.push_back(VisitedRecord{ reader.hdr().record.id, reader.getFileOffset(),
+                            reader.stackSize(), reader.grp().label.value, reader.grp().type });
+                        return false;
+                    },
+                    groupInvocable);
+                return result;
+            }
+        };
+
+        TEST_F(ESM4ReaderUtilsTest, readAllShouldVisitAllRecords)
+        {
+            const std::vector<VisitedRecord> expected{
+                { 1, mOffsets[0], 1, REC_DIAL, Grp_RecordType },
+                { 2, mOffsets[1], 2, 1, Grp_TopicChild },
+                { sCellId, mOffsets[2], 1, REC_CELL, Grp_RecordType },
+                { 4, mOffsets[3], 2, sCellId, Grp_CellChild },
+                { 5, mOffsets[4], 1, REC_CELL, Grp_RecordType },
+                { 6, mOffsets[5], 1, REC_GMST, Grp_RecordType },
+            };
+            EXPECT_EQ(readAll([](Reader&) {}), expected);
+        }
+
+        TEST_F(ESM4ReaderUtilsTest, skippedGroupsShouldNotChangeGroupStackAndOffsetOfFollowingRecords)
+        {
+            const std::vector<VisitedRecord> all = readAll([](Reader&) {});
+            ASSERT_EQ(all.size(), 6);
+
+            const std::vector<VisitedRecord> result = readAll([](Reader& reader) {
+                const GroupTypeHeader& group = reader.hdr().group;
+                if (group.type == Grp_RecordType)
+                    return group.label.value != REC_DIAL;
+                return group.type != Grp_CellChild;
+            });
+
+            EXPECT_EQ(result, (std::vector<VisitedRecord>{ all[2], all[4], all[5] }));
+        }
+
+        TEST_F(ESM4ReaderUtilsTest, readAllShouldEndAfterSkippedLastGroup)
+        {
+            const std::vector<VisitedRecord> result
+                = readAll([](Reader& reader) { return reader.hdr().group.label.value != REC_GMST; });
+
+            ASSERT_EQ(result.size(), 5);
+            EXPECT_EQ(result.back().mId, 5);
+        }
+    }
+}
@@ -0,0 +1,194 @@
+#include <components/misc/chunkedlist.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    template <class T, std::size_t chunkSize>
+    std::vector<T> toVector(const ChunkedList<T, chunkSize>& list)
+    {
+        return std::vector<T>(list.begin(), list.end());
+    }
+
+    TEST(MiscChunkedListTest, defaultConstructedShouldBeEmpty)
+    {
+        const ChunkedList<int> list;
+        EXPECT_TRUE(list.empty());
+        EXPECT_EQ(list.size(), 0);
+        EXPECT_EQ(list.begin(), list.end());
+    }
+
+    TEST(MiscChunkedListTest, pushBackShouldPreserveOrderAcrossChunks)
+    {
+        ChunkedList<int, 4> list;
+        for (int i = 0; i < 10; ++i)
+            list.push_back(i);
+        EXPECT_EQ(list.size(), 10);
+        EXPECT_EQ(list.front(), 0);
+        EXPECT_EQ(list.back(), 9);
+        EXPECT_THAT(toVector(list), ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+    }
+
+    TEST(MiscChunkedListTest, pushBackShouldPreserveOrderAcrossGrowingChunks)
+    {
+        ChunkedList<int, 16> list;
+        std::vector<int> expected;
+        std::vector<const int*> addresses;
+        for (int i = 0; i < 100; ++i)
+        {
+            list.push_back(i);
+            expected.push_back(i);
+            addresses.push_back(&list.back());
+        }
+        EXPECT_EQ(toVector(list), expected);
+        std::vector<const int*> actual;
+        for (const int& value : list)
+            actual.push_back(&value);
+        EXPECT_EQ(actual, addresses);
+        list.erase(std::next(list.begin(), 3));
+        list.erase(std::next(list.begin(), 27));
+        expected.erase(expected.begin() + 28);
+        expected.erase(expected.begin() + 3);
+        EXPECT_EQ(toVector(list), expected);
+    }
+
+    TEST(MiscChunkedListTest, pushBackShouldNotMoveElements)
+    {
+        ChunkedList<int, 2> list;
+        std::vector<const int*> addresses;
+        for (int i = 0; i < 9; ++i)
+        {
+            list.push_back(i);
+            addresses.push_back(&list.back());
+        }
+        std::vector<const int*> actual;
+        for (const int& value : list)
+            actual.push_back(&value);
+        EXPECT_EQ(actual, addresses);
+    }
+
+    TEST(MiscChunkedListTest, eraseShouldSkipErasedElementsAndReturnNext)
+    {
+        ChunkedList<int, 4> list;
+        for (int i = 0; i < 10; ++i)
+            list.push_back(i);
+        auto it = list.begin();
+        while (it != list.end())
+        {
+            if (*it % 3 == 0)
+                it = list.erase(it);
+            else
+                ++it;
+        }
+        EXPECT_EQ(list.size(), 6);
+        EXPECT_EQ(list.front(), 1);
+        EXPECT_EQ(list.back(), 8);
+        EXPECT_THAT(toVector(list), ElementsAre(1, 2, 4, 5, 7, 8));
+    }
+
+    TEST(MiscChunkedListTest, eraseShouldNotInvalidateIteratorsToOtherElements)
+    {
+        ChunkedList<int, 2> list;
+        for (int i = 0; i < 6; ++i)
+            list.push_back(i);
+        auto first = list.begin();
+        auto last = std::prev(list.end());
+        list.erase(std::next(list.begin(), 2));
+        list.push_back(6);
+        EXPECT_EQ(*first, 0);
+        EXPECT_EQ(*last, 5);
+        EXPECT_EQ(*++last, 6);
+    }
+
+    TEST(MiscChunkedListTest, pushBackAfterErasingLastElementsShouldPreserveOrder)
+    {
+        ChunkedList<int, 4> list;
+        for (int i = 0; i < 6; ++i)
+            list.push_back(i);
+        list.erase(std::prev(list.end()));
+        list.erase(std::prev(list.end()));
+        list.erase(std::next(list.begin()));
+        list.push_back(42);
+        EXPECT_THAT(toVector(list), ElementsAre(0, 2, 3, 42));
+    }
+
+    TEST(MiscChunkedListTest, decrementFromEndShouldSkipErasedElements)
+    {
+        ChunkedList<int, 2> list;
+        for (int i = 0; i < 5; ++i)
+            list.push_back(i);
+        list.erase(std::next(list.begin(), 3));
+        std::vector<int> reversed;
+        for (auto it = list.end(); it != list.begin();)
+            reversed.push_back(*--it);
+        EXPECT_THAT(reversed, ElementsAre(4, 2, 1, 0));
+    }
+
+    TEST(MiscChunkedListTest, iteratorShouldBeConvertibleToConstIterator)
+    {
+        ChunkedList<int> list;
+        list.push_back(1);
+        const ChunkedList<int>::const_iterator it = list.begin();
+        EXPECT_EQ(it, list.begin());
+        EXPECT_EQ(*it, 1);
+    }
+
+    TEST(MiscChunkedListTest, findShouldReturnIteratorToElement)
+    {
+        ChunkedList<int, 4> list;
+        for (int i = 0; i < 10; ++i)
+            list.push_back(i);
+        const auto it = std::find(list.begin(), list.end(), 7);
+        ASSERT_NE(it, list.end());
+        EXPECT_EQ(*it, 7);
+        EXPECT_EQ(std::find(list.begin(), list.end(), 10), list.end());
+    }
+
+    TEST(MiscChunkedListTest, copyShouldContainOnlyAliveElements)
+    {
+        ChunkedList<std::string, 2> list;
+        list.push_back("a");
+        list.push_back("b");
+        list.push_back("c");
+        list.erase(std::next(list.begin()));
+        ChunkedList<std::string, 2> copy(list);
+        EXPECT_THAT(toVector(copy), ElementsAre("a", "c"));
+        copy = list;
+        EXPECT_THAT(toVector(copy), ElementsAre("a", "c"));
+        EXPECT_NE(&copy.front(), &list.front());
+    }
+
+    TEST(MiscChunkedListTest, moveShouldPreserveAddresses)
+    {
+        ChunkedList<std::string, 2> list;
+        list.push_back("a");
+        list.push_back("b");
+        const std::string* const address = &list.back();
+        ChunkedList<std::string, 2> moved(std::move(list));
+        EXPECT_EQ(&moved.back(), address);
+        EXPECT_TRUE(list.empty());
+    }
+
+    TEST(MiscChunkedListTest, clearShouldDestroyAliveElements)
+    {
+        const auto value = std::make_shared<int>(42);
+        ChunkedList<std::shared_ptr<int>, 2> list;
+        for (int i = 0; i < 5; ++i)
+            list.push_back(value);
+        list.erase(list.begin());
+        EXPECT_EQ(value.use_count(), 5);
+        list.clear();
+        EXPECT_EQ(value.use_count(), 1);
+        EXPECT_TRUE(list.empty());
+        EXPECT_EQ(list.begin(), list.end());
+    }
+}
@@ -0,0 +1,154 @@
+#include <components/misc/jobsystem.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    TEST(MiscJobSystemTest, scheduledJobShouldBeExecuted)
+    {
+        JobSystem jobSystem(2);
+        std::atomic_int value{ 0 };
+        const JobHandle job = jobSystem.schedule([&] { value = 42; });
+        job->wait();
+        EXPECT_TRUE(job->isDone());
+        EXPECT_EQ(value, 42);
+    }
+
+    TEST(MiscJobSystemTest, jobShouldBeExecutedAfterDependencies)
+    {
+        JobSystem jobSystem(4);
+        std::mutex mutex;
+        std::vector<int> order;
+        const auto append = [&](int value) {
+            return [&, value] {
+                const std::lock_guard lock(mutex);
+                order.push_back(value);
+            };
+        };
+        const JobHandle first = jobSystem.schedule(append(1));
+        const JobHandle second = jobSystem.schedule(append(2), std::span(&first, 1));
+        const JobHandle third = jobSystem.schedule(append(3), std::vector<JobHandle>{ first, second });
+        third->wait();
+        EXPECT_THAT(order, ElementsAre(1, 2, 3));
+    }
+
+    TEST(MiscJobSystemTest, jobShouldBeExecutedWhenDependencyIsDone)
+    {
+        JobSystem jobSystem(1);
+        const JobHandle first = jobSystem.schedule([] {});
+        first->wait();
+        bool executed = false;
+        jobSystem.schedule([&] { executed = true; }, std::span(&first, 1))->wait();
+        EXPECT_TRUE(executed);
+    }
+
+    TEST(MiscJobSystemTest, waitInsideJobShouldNotDeadlockWithSingleThread)
+    {
+        JobSystem jobSystem(1);
+        std::atomic_int value{ 0 };
+        const JobHandle outer = jobSystem.schedule([&] {
+            const JobHandle inner = jobSystem.schedule([&] { value = 13; });
+            inner->wait();
+            value += 1;
+        });
+        outer->wait();
+        EXPECT_EQ(value, 14);
+    }
+
+    TEST(MiscJobSystemTest, jobThrowingNonStandardExceptionShouldReleaseWaitersAndContinuations)
+    {
+        JobSystem jobSystem(1);
+        const JobHandle failed = jobSystem.schedule([] { throw 42; });
+        bool executed = false;
+        jobSystem.schedule([&] { executed = true; }, std::span(&failed, 1))->wait();
+        EXPECT_TRUE(failed->isDone());
+        EXPECT_TRUE(executed);
+    }
+
+    TEST(MiscJobSystemTest, startThreadsShouldAddThreads)
+    {
+        if (std::thread::hardware_concurrency() < 2)
+            GTEST_SKIP() << "Needs at least 2 CPU cores";
+        JobSystem jobSystem(1);
+        jobSystem.startThreads(2);
+        EXPECT_EQ(jobSystem.getNumThreads(), 2);
+        jobSystem.startThreads(1);
+        EXPECT_EQ(jobSystem.getNumThreads(), 2);
+        std::atomic_int value{ 0 };
+        jobSystem.schedule([&] { value = 42; })->wait();
+        EXPECT_EQ(value, 42);
+    }
+
+    TEST(MiscJobSystemTest, startThreadsShouldDoNothingAfterStop)
+    {
+        JobSystem jobSystem(1);
+        jobSystem.stop();
+        jobSystem.startThreads(2);
+        EXPECT_EQ(jobSystem.getNumThreads(), 1);
+    }
+
+    TEST(MiscJobSystemTest, parallelForShouldProcessEachIndexOnce)
+    {
+        JobSystem jobSystem(3);
+        std::vector<std::atomic_int> counts(1000);
+        jobSystem.parallelFor(0, counts.size(), 7, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+                ++counts[i];
+        });
+        EXPECT_TRUE(std::all_of(counts.begin(), counts.end(), [](const std::atomic_int& v) { return v == 1; }));
+    }
+
+    TEST(MiscJobSystemTest, parallelForShouldWorkWithoutThreads)
+    {
+        JobSystem jobSystem(0);
+        std::size_t sum = 0;
+        jobSystem.parallelFor(10, 20, 3, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+                sum += i;
+        });
+        EXPECT_EQ(sum, 145);
+    }
+
+    TEST(MiscJobSystemTest, parallelForShouldRethrowException)
+    {
+        JobSystem jobSystem(2);
+        EXPECT_THROW(jobSystem.parallelFor(0, 100, 1,
+                         [](std::size_t begin, std::size_t) {
+                             if (begin == 50)
+                                 throw std::runtime_error("error");
+                         }),
+            std::runtime_error);
+    }
+
+    TEST(MiscJobSystemTest, higherPriorityJobShouldBeStartedFirst)
+    {
+        JobSystem jobSystem(1);
+        std::mutex blocker;
+        std::unique_lock lock(blocker);
+        // Keep the only thread busy while the other jobs are scheduled
+        const JobHandle blocking = jobSystem.schedule([&] { const std::lock_guard guard(blocker); });
+        while (jobSystem.getNumQueuedJobs() != 0)
+            std::this_thread::yield();
+        std::vector<int> order;
+        const std::vector<JobHandle> jobs{
+            jobSystem.schedule([&] { order.push_back(1); }, JobPriority::Low),
+            jobSystem.schedule([&] { order.push_back(2); }, JobPriority::Normal),
+            jobSystem.schedule([&] { order.push_back(3); }, JobPriority::High),
+        };
+        lock.unlock();
+        for (const JobHandle& job : jobs)
+            job->wait();
+        EXPECT_THAT(order, ElementsAre(3, 2, 1));
+    }
+}
@@ -0,0 +1,131 @@
+#include <components/nif/particle.hpp>
+#include <components/nifosg/particle.hpp>
+
+#include <osgParticle/ModularProgram>
+#include <osgParticle/ParticleSystem>
+
+#include <gtest/gtest.h>
+
+#include <initializer_list>
+
+namespace
+{
+    using namespace NifOsg;
+
+    struct TestParticleProgram : ParticleProgram
+    {
+        using ParticleProgram::execute;
+    };
+
+    struct TestModularProgram : osgParticle::ModularProgram
+    {
+        using osgParticle::ModularProgram::execute;
+    };
+
+    // Non batched operator to check the interaction with ParticleOperators
+    struct SetVelocityOperator : osgParticle::Operator
+    {
+        META_Object(NifOsgTest, SetVelocityOperator)
+
+        SetVelocityOperator() = default;
+        SetVelocityOperator(const SetVelocityOperator& copy, const osg::CopyOp& copyop)
+            : osgParticle::Operator(copy, copyop)
+        {
+        }
+
+        void operate(osgParticle::Particle* particle, double /*dt*/) override
+        {
+            particle->setVelocity(osg::Vec3(1, 2, 3));
+        }
+    };
+
+    osg::ref_ptr<osgParticle::ParticleSystem> makeParticleSystem(std::initializer_list<float> ages)
+    {
+        osg::ref_ptr<osgParticle::ParticleSystem> particleSystem = new osgParticle::ParticleSystem;
+        particleSystem->getDefaultParticleTemplate().setSizeRange(osgParticle::rangef(10, 10));
+        for (const float age : ages)
+        {
+            ParticleAgeSetter particle(age);
+            particle.setLifeTime(2);
+            particleSystem->createParticle(&particle);
+        }
+        return particleSystem;
+    }
+
+    Nif::NiGravity makeWindGravity()
+    {
+        Nif::NiGravity gravity;
+        gravity.mForce = 2;
+        gravity.mType = Nif::ForceType::Wind;
+        gravity.mDirection = osg::Vec3f(0, 0, -1);
+        return gravity;
+    }
+
+    struct NifOsgParticleProgramTest : ::testing::Test
+    {
+        NifOsgParticleProgramTest() { ParticleProgram::setBatchedOperators(true); }
+
+        ~NifOsgParticleProgramTest() override { ParticleProgram::setBatchedOperators(false); }
+    };
+
+    TEST_F(NifOsgParticleProgramTest, shouldMatchPerParticleOperators)
+    {
+        const std::initializer_list<float> ages = { 0.f, 0.25f, 1.f, 1.75f, 1.9f };
+        const Nif::NiGravity gravity = makeWindGravity();
+
+        osg::ref_ptr<osgParticle::ParticleSystem> batched = makeParticleSystem(ages);
+        osg::ref_ptr<TestParticleProgram> batchedProgram = new TestParticleProgram;
+        batchedProgram->setParticleSystem(batched);
+        batchedProgram->addOperator(new GrowFadeAffector(0.5f, 0.5f));
+        batchedProgram->addOperator(new GravityAffector(&gravity));
+        batchedProgram->execute(0.1);
+
+        osg::ref_ptr<osgParticle::ParticleSystem> reference = makeParticleSystem(ages);
+        osg::ref_ptr<TestModularProgram> referenceProgram = new TestModularProgram;
+        referenceProgram->setParticleSystem(reference);
+        referenceProgram->addOperator(new GrowFadeAffector(0.5f, 0.5f));
+        referenceProgram->addOperator(new GravityAffector(&gravity));
+        referenceProgram->execute(0.1);
+
+        ASSERT_EQ(batched->numParticles(), reference->numParticles());
+        for (int i = 0; i < batched->numParticles(); ++i)
+        {
+            const osgParticle::Particle& actual = *batched->getParticle(i);
+            const osgParticle::Particle& expected = *reference->getParticle(i);
+            EXPECT_EQ(actual.getSizeRange().minimum, expected.getSizeRange().minimum) << i;
+            EXPECT_EQ(actual.getVelocity(), expected.getVelocity()) << i;
+        }
+    }
+
+    TEST_F(NifOsgParticleProgramTest, growFadeShouldScaleSizeByAge)
+    {
+        osg::ref_ptr<osgParticle::ParticleSystem> particleSystem = makeParticleSystem({ 0.25f, 1.f, 1.75f });
+        osg::ref_ptr<TestParticleProgram> program = new TestParticleProgram;
+        program->setParticleSystem(particleSystem);
+        program->addOperator(new GrowFadeAffector(0.5f, 0.5f));
+        program->execute(0.1);
+
+        EXPECT_FLOAT_EQ(particleSystem->getParticle(0)->getSizeRange().minimum, 5);
+        EXPECT_FLOAT_EQ(particleSystem->getParticle(1)->getSizeRange().minimum, 10);
+        EXPECT_FLOAT_EQ(particleSystem->getParticle(2)->getSizeRange().minimum, 5);
+    }
+
+    TEST_F(NifOsgParticleProgramTest, batchedOperatorShouldSeeChangesOfPerParticleOperator)
+    {
+        const Nif::NiGravity gravity = makeWindGravity();
+        osg::ref_ptr<osgParticle::ParticleSystem> particleSystem = makeParticleSystem({ 0.f, 1.f });
+        osg::ref_ptr<TestParticleProgram> program = new TestParticleProgram;
+        program->setParticleSystem(particleSystem);
+        program->addOperator(new SetVelocityOperator);
+        program->addOperator(new GravityAffector(&gravity));
+        program->execute(0.5);
+
+        for (int i = 0; i < particleSystem->numParticles(); ++i)
+        {
+            const osg::Vec3 velocity = particleSystem->getParticle(i)->getVelocity();
+            EXPECT_FLOAT_EQ(velocity.x(), 1);
+            EXPECT_FLOAT_EQ(velocity.y(), 2);
+            EXPECT_FLOAT_EQ(velocity.z(), 3 - 2 * 0.5f * 1.6f);
+        }
+    }
+}
@@ -1,3 +1,4 @@
+#include <components/misc/jobsystem.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/toutf8/toutf8.hpp>
@@ -7,6 +8,7 @@
 #include <gtest/gtest.h>
 
 #include <thread>
+#include <vector>
 
 namespace
 {
@@ -29,4 +31,48 @@ namespace
         for (std::thread& thread : threads)
             thread.join();
     }
+
+    TEST(ResourceResourceSystem, scenemanager_concurrent_gettemplate_should_load_once)
+    {
+        const VFS::Manager vfsManager;
+        const ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+        Resource::ResourceSystem resourceSystem(&vfsManager, 1.0, &encoder.getStatelessEncoder());
+        Resource::SceneManager* sceneManager = resourceSystem.getSceneManager();
+
+        constexpr VFS::Path::NormalizedView noSuchPath("meshes/whatever.nif");
+        std::vector<osg::ref_ptr<const osg::Node>> templates(50);
+        std::vector<std::thread> threads;
+
+        for (std::size_t i = 0; i < templates.size(); ++i)
+        {
+            threads.emplace_back([=, &templates]() { templates[i] = sceneManager->getTemplate(noSuchPath); });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+
+        ASSERT_NE(templates.front(), nullptr);
+        for (const osg::ref_ptr<const osg::Node>& value : templates)
+            EXPECT_EQ(value, templates.front());
+    }
+
+    TEST(ResourceResourceSystem, scenemanager_gettemplateasync_should_return_same_template_as_gettemplate)
+    {
+        const VFS::Manager vfsManager;
+        const ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+        Resource::ResourceSystem resourceSystem(&vfsManager, 1.0, &encoder.getStatelessEncoder());
+        Resource::SceneManager* sceneManager = resourceSystem.getSceneManager();
+        Misc::JobSystem jobSystem(2);
+        sceneManager->setJobSystem(&jobSystem);
+
+        constexpr VFS::Path::NormalizedView noSuchPath("meshes/whatever.nif");
+        const auto low = sceneManager->getTemplateAsync(noSuchPath, Misc::JobPriority::Low);
+        const auto high = sceneManager->getTemplateAsync(noSuchPath, Misc::JobPriority::High);
+        const osg::ref_ptr<const osg::Node> value = sceneManager->getTemplate(noSuchPath);
+
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(low.get(), value);
+        EXPECT_EQ(high.get(), value);
+
+        sceneManager->setJobSystem(nullptr);
+    }
 }
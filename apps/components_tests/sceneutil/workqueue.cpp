@@ -0,0 +1,56 @@
+#include <components/misc/jobsystem.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    using namespace SceneUtil;
+
+    struct ThrowingWorkItem : WorkItem
+    {
+        void doWork() override { throw std::runtime_error("failed"); }
+    };
+
+    TEST(SceneUtilWorkQueueTest, failedWorkItemShouldBeDone)
+    {
+        osg::ref_ptr<WorkQueue> workQueue = new WorkQueue(1);
+        osg::ref_ptr<ThrowingWorkItem> item = new ThrowingWorkItem;
+        workQueue->addWorkItem(item);
+        item->waitTillDone();
+        EXPECT_TRUE(item->isDone());
+    }
+
+    struct AbortableWorkItem : WorkItem
+    {
+        bool mAborted = false;
+        bool mDoneWork = false;
+
+        void doWork() override { mDoneWork = true; }
+
+        void abort() override { mAborted = true; }
+    };
+
+    TEST(SceneUtilWorkQueueTest, itemAddedAfterStopShouldBeAbortedAndDone)
+    {
+        osg::ref_ptr<WorkQueue> workQueue = new WorkQueue(1);
+        workQueue->stop();
+        osg::ref_ptr<AbortableWorkItem> item = new AbortableWorkItem;
+        workQueue->addWorkItem(item);
+        item->waitTillDone();
+        EXPECT_TRUE(item->mAborted);
+        EXPECT_FALSE(item->mDoneWork);
+    }
+
+    TEST(SceneUtilWorkQueueTest, startShouldAddThreads)
+    {
+        if (std::thread::hardware_concurrency() < 2)
+            GTEST_SKIP() << "Needs at least 2 CPU cores";
+        osg::ref_ptr<WorkQueue> workQueue = new WorkQueue(1);
+        workQueue->start(2);
+        EXPECT_EQ(workQueue->getJobSystem()->getNumThreads(), 2);
+    }
+}
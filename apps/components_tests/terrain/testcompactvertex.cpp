@@ -0,0 +1,52 @@
+#include <components/terrain/compactvertex.hpp>
+
+#include <osg/Math>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace Terrain
+{
+    namespace
+    {
+        TEST(TerrainCompactVertexTest, decodeShouldRestorePositionWithinQuantizationError)
+        {
+            const CompactVertexDecode decode = CompactVertexDecode::fromRange(8192, -1000, 3000);
+            for (const float height : { -1000.0f, -123.4f, 0.0f, 1234.5f, 3000.0f })
+            {
+                const osg::Vec3f position = decode.decode(osg::Vec2f(0.25f, 1), decode.encodeHeight(height));
+                EXPECT_FLOAT_EQ(position.x(), -2048);
+                EXPECT_FLOAT_EQ(position.y(), 4096);
+                EXPECT_NEAR(position.z(), height, decode.mHeightScale) << height;
+            }
+        }
+
+        TEST(TerrainCompactVertexTest, encodeHeightShouldClampOutOfRange)
+        {
+            const CompactVertexDecode decode = CompactVertexDecode::fromRange(8192, 0, 100);
+            EXPECT_EQ(decode.encodeHeight(1000), 32767);
+            EXPECT_EQ(decode.encodeHeight(-1000), -32767);
+        }
+
+        TEST(TerrainCompactVertexTest, flatRangeShouldBeDecodable)
+        {
+            const CompactVertexDecode decode = CompactVertexDecode::fromRange(8192, -2048, -2048);
+            EXPECT_GT(decode.mHeightScale, 0);
+            EXPECT_FLOAT_EQ(decode.decode(osg::Vec2f(), decode.encodeHeight(-2048)).z(), -2048);
+        }
+
+        TEST(TerrainCompactVertexTest, decodeNormalShouldRestoreDirection)
+        {
+            for (osg::Vec3f normal : { osg::Vec3f(0, 0, 1), osg::Vec3f(1, 0, 0.01f), osg::Vec3f(-1, -1, 1),
+                     osg::Vec3f(0.3f, -0.7f, 0.2f), osg::Vec3f(-0.05f, 0.02f, 1) })
+            {
+                normal.normalize();
+                const osg::Vec3f decoded = decodeCompactNormal(encodeCompactNormal(normal));
+                EXPECT_NEAR(decoded.length(), 1, 1e-5f);
+                EXPECT_GT(decoded * normal, std::cos(osg::DegreesToRadians(1.5f)))
+                    << normal.x() << " " << normal.y() << " " << normal.z();
+            }
+        }
+    }
+}
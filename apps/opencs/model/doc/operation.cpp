@@ -2,11 +2,13 @@
 
 #include <algorithm>
 #include <exception>
+#include <string>
 #include <vector>
 
 #include <QTimer>
 
 #include <components/debug/debuglog.hpp>
+#include <components/misc/jobsystem.hpp>
 
 #include <apps/opencs/model/doc/messages.hpp>
 
@@ -18,6 +20,13 @@ namespace CSMDoc
 {
     namespace
     {
+        // Number of steps per thread performed by each timer event when running concurrently. Keeps progress
+        // reporting and abort responsive.
+        constexpr int stepsPerThread = 256;
+
+        // Number of steps of a concurrent stage performed by a single job
+        constexpr int stepsPerJob = 32;
+
         std::string_view operationToString(State value)
         {
             switch (value)
@@ -53,6 +62,9 @@ void CSMDoc::Operation::prepareStages()
         iter->second = iter->first->setup();
         mTotalSteps += iter->second;
     }
+
+    mProgress.clear();
+    mProgress.resize(mStages.size());
 }
 
 CSMDoc::Operation::Operation(State type, bool ordered, bool finalAlways)
@@ -68,6 +80,7 @@ CSMDoc::Operation::Operation(State type, bool ordered, bool finalAlways)
     , mConnected(false)
     , mPrepared(false)
     , mDefaultSeverity(Message::Severity_Error)
+    , mConcurrency(1)
 {
     mTimer = new QTimer(this);
 }
@@ -104,6 +117,22 @@ void CSMDoc::Operation::setDefaultSeverity(Message::Severity severity)
     mDefaultSeverity = severity;
 }
 
+void CSMDoc::Operation::setConcurrency(std::size_t threads)
+{
+    if (mOrdered || mFinalAlways)
+        threads = 1;
+
+    if (threads == mConcurrency)
+        return;
+
+    mConcurrency = threads;
+    mJobSystem.reset();
+
+    // The operation thread takes part in the execution
+    if (threads > 1)
+        mJobSystem = std::make_unique<Misc::JobSystem>(threads - 1);
+}
+
 bool CSMDoc::Operation::hasError() const
 {
     return mError;
@@ -136,6 +165,27 @@ void CSMDoc::Operation::executeStage()
         mPrepared = true;
     }
 
+    if (mJobSystem != nullptr)
+        executeStepsConcurrently();
+    else
+        executeStep();
+
+    if (mCurrentStage == mStages.end())
+    {
+        if (mStart.has_value())
+        {
+            const auto duration = std::chrono::steady_clock::now() - *mStart;
+            Log(Debug::Verbose) << operationToString(mType) << " operation is completed in "
+                                << std::chrono::duration_cast<std::chrono::duration<double>>(duration).count() << 's';
+            mStart.reset();
+        }
+
+        operationDone();
+    }
+}
+
+void CSMDoc::Operation::executeStep()
+{
     Messages messages(mDefaultSeverity);
 
     while (mCurrentStage != mStages.end())
@@ -167,18 +217,111 @@ void CSMDoc::Operation::executeStage()
 
     for (Messages::Iterator iter(messages.begin()); iter != messages.end(); ++iter)
         emit reportMessage(*iter, mType);
+}
 
-    if (mCurrentStage == mStages.end())
+void CSMDoc::Operation::executeStepsConcurrently()
+{
+    // mCurrentStage is the first stage not completed yet, following stages may be partially performed. Only the
+    // messages of mCurrentStage are reported, so they are reported in the order of a sequential execution.
+    struct Task
     {
-        if (mStart.has_value())
+        std::size_t mStage;
+        int mBegin;
+        int mEnd;
+        Messages mMessages;
+        std::optional<std::string> mError;
+    };
+
+    std::vector<Task> tasks;
+    int budget = static_cast<int>(mConcurrency) * stepsPerThread;
+
+    for (auto stage = mCurrentStage; stage != mStages.end() && budget > 0; ++stage)
+    {
+        const std::size_t index = static_cast<std::size_t>(stage - mStages.begin());
+        // A sequential execution would never reach the steps after a failed one
+        if (mProgress[index].mFailed)
+            break;
+
+        const int begin = mProgress[index].mPerformed;
+        if (begin >= stage->second)
+            continue;
+
+        if (stage->first->isConcurrent())
         {
-            const auto duration = std::chrono::steady_clock::now() - *mStart;
-            Log(Debug::Verbose) << operationToString(mType) << " operation is completed in "
-                                << std::chrono::duration_cast<std::chrono::duration<double>>(duration).count() << 's';
-            mStart.reset();
+            const int end = begin + std::min(stage->second - begin, budget);
+            for (int step = begin; step < end; step += stepsPerJob)
+                tasks.push_back(Task{ index, step, std::min(step + stepsPerJob, end), Messages(mDefaultSeverity) });
+            budget -= end - begin;
+        }
+        else
+        {
+            const int end = begin + std::min({ stage->second - begin, budget, stepsPerThread });
+            tasks.push_back(Task{ index, begin, end, Messages(mDefaultSeverity) });
+            budget -= end - begin;
+        }
+    }
+
+    mJobSystem->parallelFor(0, tasks.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            Task& task = tasks[i];
+            Stage& stage = *mStages[task.mStage].first;
+            for (int step = task.mBegin; step < task.mEnd; ++step)
+            {
+                try
+                {
+                    stage.perform(step, task.mMessages);
+                }
+                catch (const std::exception& e)
+                {
+                    task.mError = e.what();
+                    task.mEnd = step + 1;
+                    break;
+                }
+            }
         }
+    });
 
-        operationDone();
+    // Tasks are sorted by stage and step, so everything after a failed step is discarded like it would have never
+    // been performed by a sequential execution
+    for (Task& task : tasks)
+    {
+        StageProgress& stageProgress = mProgress[task.mStage];
+        stageProgress.mMessages.insert(stageProgress.mMessages.end(), task.mMessages.begin(), task.mMessages.end());
+        stageProgress.mPerformed = task.mEnd;
+        mCurrentStepTotal += task.mEnd - task.mBegin;
+
+        if (task.mError.has_value())
+        {
+            stageProgress.mMessages.emplace_back(
+                CSMWorld::UniversalId(), *task.mError, "", Message::Severity_SeriousError);
+            stageProgress.mFailed = true;
+            break;
+        }
+    }
+
+    emit progress(mCurrentStepTotal, mTotalSteps ? mTotalSteps : 1, mType);
+
+    while (mCurrentStage != mStages.end())
+    {
+        const std::size_t index = static_cast<std::size_t>(mCurrentStage - mStages.begin());
+        StageProgress& stageProgress = mProgress[index];
+
+        for (const Message& message : stageProgress.mMessages)
+            emit reportMessage(message, mType);
+        stageProgress.mMessages.clear();
+
+        // The failed stage may be reached only by a later event when a previous stage is still incomplete
+        if (stageProgress.mFailed)
+        {
+            abort();
+            break;
+        }
+
+        if (stageProgress.mPerformed < mCurrentStage->second)
+            break;
+
+        ++mCurrentStage;
     }
 }
 
@@ -2,6 +2,8 @@
 #define CSM_DOC_OPERATION_H
 
 #include <chrono>
+#include <cstddef>
+#include <memory>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -13,6 +15,11 @@
 
 class QTimer;
 
+namespace Misc
+{
+    class JobSystem;
+}
+
 namespace CSMDoc
 {
     class Stage;
@@ -35,9 +42,27 @@ namespace CSMDoc
         bool mPrepared;
         Message::Severity mDefaultSeverity;
         std::optional<std::chrono::steady_clock::time_point> mStart;
+        std::size_t mConcurrency;
+        std::unique_ptr<Misc::JobSystem> mJobSystem;
+
+        struct StageProgress
+        {
+            int mPerformed = 0;
+            // A step threw, mPerformed is the number of steps up to and including it. Nothing is scheduled from this
+            // stage on, the operation is aborted once the messages of the previous stages are reported.
+            bool mFailed = false;
+            // Messages held back until the messages of the previous stages are reported
+            std::vector<Message> mMessages;
+        };
+
+        std::vector<StageProgress> mProgress;
 
         void prepareStages();
 
+        void executeStep();
+
+        void executeStepsConcurrently();
+
     public:
         Operation(State type, bool ordered, bool finalAlways = false);
         ///< \param ordered Stages must be executed in the given order.
@@ -53,6 +78,13 @@ namespace CSMDoc
         /// \attention Do no call this function while this Operation is running.
         void setDefaultSeverity(Message::Severity severity);
 
+        /// Number of threads performing the steps of an unordered operation. Independent stages and the steps of
+        /// stages supporting it are performed concurrently, messages are reported in the same order as with a
+        /// single thread. Has no effect on ordered operations and operations with a final stage.
+        ///
+        /// \attention Do no call this function while this Operation is running.
+        void setConcurrency(std::size_t threads);
+
         bool hasError() const;
 
     signals:
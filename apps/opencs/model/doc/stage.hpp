@@ -14,6 +14,11 @@ namespace CSMDoc
 
         virtual void perform(int stage, Messages& messages) = 0;
         ///< Messages resulting from this stage will be appended to \a messages.
+
+        virtual bool isConcurrent() const { return false; }
+        ///< \return Can perform be called for different steps at the same time from different threads. Steps of
+        /// stages returning false are performed in order one at a time, but may run at the same time as other stages
+        /// of an unordered Operation.
     };
 }
 
@@ -16,6 +16,17 @@ CSMFilter::TextNode::TextNode(int columnId, const std::string& text)
     , mRegExp(QRegularExpression::anchoredPattern(QString::fromUtf8(mText.c_str())),
           QRegularExpression::CaseInsensitiveOption)
 {
+    // Compile the pattern now instead of on the first match, test() may be called from multiple threads
+    mRegExp.optimize();
+
+    const auto column = static_cast<CSMWorld::Columns::ColumnId>(mColumnId);
+    if (CSMWorld::Columns::hasEnums(column))
+    {
+        const std::vector<std::pair<int, std::string>> enums = CSMWorld::Columns::getEnums(column);
+        mEnums.reserve(enums.size());
+        for (const auto& value : enums)
+            mEnums.push_back(QString::fromUtf8(value.second.c_str()));
+    }
 }
 
 bool CSMFilter::TextNode::test(const CSMWorld::IdTableBase& table, int row, const std::map<int, int>& columns) const
@@ -43,11 +54,8 @@ bool CSMFilter::TextNode::test(const CSMWorld::IdTableBase& table, int row, cons
     {
         int value = data.toInt();
 
-        std::vector<std::pair<int, std::string>> enums
-            = CSMWorld::Columns::getEnums(static_cast<CSMWorld::Columns::ColumnId>(mColumnId));
-
-        if (value >= 0 && value < static_cast<int>(enums.size()))
-            string = QString::fromUtf8(enums[value].second.c_str());
+        if (value >= 0 && value < static_cast<int>(mEnums.size()))
+            string = mEnums[value];
     }
     else if (data.typeId() == QMetaType::Bool)
     {
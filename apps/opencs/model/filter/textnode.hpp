@@ -6,6 +6,7 @@
 #include <vector>
 
 #include <QRegularExpression>
+#include <QString>
 
 #include <apps/opencs/model/world/idtablebase.hpp>
 
@@ -18,6 +19,7 @@ namespace CSMFilter
         int mColumnId;
         std::string mText;
         QRegularExpression mRegExp;
+        std::vector<QString> mEnums; // names of the enum values of the column, if any
 
     public:
         TextNode(int columnId, const std::string& text);
@@ -95,6 +95,11 @@ void CSMPrefs::State::declare()
     declareEnum(mValues->mReports.mDoubleC, "Control Double Click");
     declareEnum(mValues->mReports.mDoubleSc, "Shift Control Double Click");
     declareBool(mValues->mReports.mIgnoreBaseRecords, "Ignore Base Records in Verifier");
+    declareInt(mValues->mReports.mVerifierThreads, "Verifier Threads")
+        .setTooltip(
+            "Number of threads used to verify the records. 0 uses all available cores, 1 verifies the records one "
+            "at a time.")
+        .setRange(0, 64);
 
     declareCategory("Search & Replace");
     declareInt(mValues->mSearchAndReplace.mCharBefore, "Max Characters Before the Search String")
@@ -177,6 +177,7 @@ namespace CSMPrefs
         EnumSettingValue mDoubleC{ mIndex, sName, "double-c", sReportValues, 3 };
         EnumSettingValue mDoubleSc{ mIndex, sName, "double-sc", sReportValues, 0 };
         Settings::SettingValue<bool> mIgnoreBaseRecords{ mIndex, sName, "ignore-base-records", false };
+        Settings::SettingValue<int> mVerifierThreads{ mIndex, sName, "verifier-threads", 0 };
     };
 
     struct SearchAndReplaceCategory : Settings::WithIndex
@@ -36,6 +36,8 @@ namespace CSMTools
         void perform(int stage, CSMDoc::Messages& messages) override;
         ///< Messages resulting from this stage will be appended to \a messages
 
+        bool isConcurrent() const override { return true; }
+
     private:
         const CSMWorld::IdCollection<ESM::Dialogue>& mJournals;
         const CSMWorld::InfoCollection& mJournalInfos;
@@ -31,6 +31,8 @@ namespace CSMTools
             const CSMWorld::IdCollection<ESM::Script>& scripts);
 
         void perform(int stage, CSMDoc::Messages& messages) override;
+
+        bool isConcurrent() const override { return true; }
         int setup() override;
     };
 }
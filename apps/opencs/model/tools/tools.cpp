@@ -1,7 +1,9 @@
 #include "tools.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -33,7 +35,11 @@
 #include "startscriptcheck.hpp"
 #include "topicinfocheck.hpp"
 
+#include <apps/opencs/model/doc/operation.hpp>
 #include <apps/opencs/model/doc/operationholder.hpp>
+#include <apps/opencs/model/prefs/category.hpp>
+#include <apps/opencs/model/prefs/setting.hpp>
+#include <apps/opencs/model/prefs/state.hpp>
 #include <apps/opencs/model/world/idcollection.hpp>
 #include <apps/opencs/model/world/refidcollection.hpp>
 
@@ -197,7 +203,17 @@ CSMWorld::UniversalId CSMTools::Tools::runVerifier(const CSMWorld::UniversalId&
 
     mActiveReports[CSMDoc::State_Verifying] = reportNumber;
 
-    getVerifier()->start();
+    CSMDoc::OperationHolder* verifier = getVerifier();
+
+    if (!verifier->isRunning())
+    {
+        std::size_t threads = static_cast<std::size_t>(CSMPrefs::get()["Reports"]["verifier-threads"].toInt());
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        mVerifierOperation->setConcurrency(threads);
+    }
+
+    verifier->start();
 
     return CSMWorld::UniversalId(CSMWorld::UniversalId::Type_VerificationResults, reportNumber);
 }
@@ -57,6 +57,8 @@ namespace CSMTools
         void perform(int step, CSMDoc::Messages& messages) override;
         ///< Messages resulting from this stage will be appended to \a messages
 
+        bool isConcurrent() const override { return true; }
+
     private:
         const CSMWorld::InfoCollection& mTopicInfos;
 
@@ -9,6 +9,7 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -88,12 +89,16 @@ namespace CSMWorld
         typedef ESXRecordT ESXRecord;
 
     private:
+        // Records are kept behind pointers so references to them stay valid when rows are inserted or removed
         std::vector<std::unique_ptr<Record<ESXRecordT>>> mRecords;
-        std::map<ESM::RefId, int> mIndex;
+        std::unordered_map<ESM::RefId, int> mIndex;
         std::vector<Column<ESXRecordT>*> mColumns;
 
         const std::vector<std::unique_ptr<Record<ESXRecordT>>>& getRecords() const;
 
+        void updateIndex(int begin, int end);
+        ///< Set the index of the records in [begin, end) to their position, only these records are visited.
+
     protected:
         void reorderRowsImp(const std::vector<int>& indexOrder);
 
@@ -205,6 +210,13 @@ namespace CSMWorld
         return mRecords;
     }
 
+    template <typename ESXRecordT>
+    void Collection<ESXRecordT>::updateIndex(int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+            mIndex.at(getRecordId(mRecords[i]->get())) = i;
+    }
+
     template <typename ESXRecordT>
     void Collection<ESXRecordT>::reorderRowsImp(const std::vector<int>& indexOrder)
     {
@@ -244,10 +256,7 @@ namespace CSMWorld
 
             std::move(buffer.begin(), buffer.end(), mRecords.begin() + baseIndex);
 
-            // adjust index
-            for (auto& [id, index] : mIndex)
-                if (index >= baseIndex && index < baseIndex + size)
-                    index = newOrder.at(index - baseIndex) + baseIndex;
+            updateIndex(baseIndex, baseIndex + size);
         }
 
         return true;
@@ -444,27 +453,12 @@ namespace CSMWorld
     template <typename ESXRecordT>
     void Collection<ESXRecordT>::removeRows(int index, int count)
     {
-        mRecords.erase(mRecords.begin() + index, mRecords.begin() + index + count);
+        for (int i = index; i < index + count; ++i)
+            mIndex.erase(getRecordId(mRecords.at(i)->get()));
 
-        auto iter = mIndex.begin();
+        mRecords.erase(mRecords.begin() + index, mRecords.begin() + index + count);
 
-        while (iter != mIndex.end())
-        {
-            if (iter->second >= index)
-            {
-                if (iter->second >= index + count)
-                {
-                    iter->second -= count;
-                    ++iter;
-                }
-                else
-                {
-                    iter = mIndex.erase(iter);
-                }
-            }
-            else
-                ++iter;
-        }
+        updateIndex(index, static_cast<int>(mRecords.size()));
     }
 
     template <typename ESXRecordT>
@@ -522,12 +516,14 @@ namespace CSMWorld
     {
         std::vector<ESM::RefId> ids;
 
-        for (auto iter = mIndex.begin(); iter != mIndex.end(); ++iter)
+        for (const auto& record : mRecords)
         {
-            if (listDeleted || !mRecords[iter->second]->isDeleted())
-                ids.push_back(getRecordId(mRecords[iter->second]->get()));
+            if (listDeleted || !record->isDeleted())
+                ids.push_back(getRecordId(record->get()));
         }
 
+        std::sort(ids.begin(), ids.end());
+
         return ids;
     }
 
@@ -559,16 +555,9 @@ namespace CSMWorld
         else
             mRecords.insert(mRecords.begin() + index, std::move(record2));
 
-        if (index < size - 1)
-        {
-            for (auto& [key, value] : mIndex)
-            {
-                if (value >= index)
-                    ++value;
-            }
-        }
-
         mIndex.insert(std::make_pair(id, index));
+
+        updateIndex(index + 1, size + 1);
     }
 
     template <typename ESXRecordT>
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <QAbstractItemModel>
 #include <QModelIndex>
@@ -30,6 +31,27 @@
 #include "idtableproxymodel.hpp"
 #include "record.hpp"
 
+namespace
+{
+    // Sorted indices of the references in the selected cells
+    std::vector<int> getSelectionReferences(
+        const CSMWorld::RefCollection& collection, const std::vector<std::string>& cells)
+    {
+        std::vector<int> indices;
+
+        for (const std::string& cell : cells)
+        {
+            const std::vector<int> cellIndices = collection.getCellReferences(ESM::RefId::stringRefId(cell));
+            indices.insert(indices.end(), cellIndices.begin(), cellIndices.end());
+        }
+
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+        return indices;
+    }
+}
+
 std::vector<std::string> CSMWorld::CommandDispatcher::getDeletableRecords() const
 {
     std::vector<std::string> result;
@@ -277,18 +299,15 @@ void CSMWorld::CommandDispatcher::executeExtendedDelete()
 
             const RefCollection& collection = mDocument.getData().getReferences();
 
-            int size = collection.getSize();
+            const std::vector<int> indices = getSelectionReferences(collection, mSelection);
 
-            for (int i = size - 1; i >= 0; --i)
+            for (auto index = indices.rbegin(); index != indices.rend(); ++index)
             {
-                const Record<CellRef>& record = collection.getRecord(i);
+                const Record<CellRef>& record = collection.getRecord(*index);
 
                 if (record.mState == RecordBase::State_Deleted)
                     continue;
 
-                if (!std::binary_search(mSelection.begin(), mSelection.end(), record.get().mCell))
-                    continue;
-
                 macro.push(new CSMWorld::DeleteCommand(model, record.get().mId.getRefIdString()));
             }
         }
@@ -310,14 +329,11 @@ void CSMWorld::CommandDispatcher::executeExtendedRevert()
 
             const RefCollection& collection = mDocument.getData().getReferences();
 
-            int size = collection.getSize();
+            const std::vector<int> indices = getSelectionReferences(collection, mSelection);
 
-            for (int i = size - 1; i >= 0; --i)
+            for (auto index = indices.rbegin(); index != indices.rend(); ++index)
             {
-                const Record<CellRef>& record = collection.getRecord(i);
-
-                if (!std::binary_search(mSelection.begin(), mSelection.end(), record.get().mCell))
-                    continue;
+                const Record<CellRef>& record = collection.getRecord(*index);
 
                 macro.push(new CSMWorld::RevertCommand(model, record.get().mId.getRefIdString()));
             }
@@ -5,13 +5,18 @@
 #include <QSortFilterProxyModel>
 #include <QString>
 
+#include <algorithm>
 #include <compare>
+#include <cstddef>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
 #include <apps/opencs/model/filter/node.hpp>
 #include <apps/opencs/model/world/columns.hpp>
 
+#include <components/misc/jobsystem.hpp>
+
 #include "columnbase.hpp"
 #include "idtablebase.hpp"
 
@@ -27,6 +32,16 @@ namespace
         }
         return values[index].second;
     }
+
+    // Rows tested by one job when filtering a whole table
+    constexpr std::size_t filterGrainSize = 1024;
+
+    Misc::JobSystem& getFilterJobSystem()
+    {
+        // Shared by all tables, the calling thread takes part in the filtering
+        static Misc::JobSystem jobSystem(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+        return jobSystem;
+    }
 }
 
 void CSMWorld::IdTableProxyModel::updateColumnMap()
@@ -58,9 +73,46 @@ bool CSMWorld::IdTableProxyModel::filterAcceptsRow(int sourceRow, const QModelIn
     if (!mFilter)
         return true;
 
+    if (sourceRow < static_cast<int>(mFilterResults.size()))
+        return mFilterResults[sourceRow] != 0;
+
+    return testFilter(sourceRow);
+}
+
+bool CSMWorld::IdTableProxyModel::testFilter(int sourceRow) const
+{
     return mFilter->test(*mSourceModel, sourceRow, mColumnMap);
 }
 
+void CSMWorld::IdTableProxyModel::updateFilterResults()
+{
+    mFilterResults.clear();
+
+    if (!mFilter)
+        return;
+
+    std::vector<char> results(static_cast<std::size_t>(mSourceModel->rowCount()));
+
+    // Columns are only read, the source model can't change while the UI thread waits for the filtering
+    getFilterJobSystem().parallelFor(0, results.size(), filterGrainSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t row = begin; row < end; ++row)
+            results[row] = testFilter(static_cast<int>(row));
+    });
+
+    mFilterResults = std::move(results);
+}
+
+void CSMWorld::IdTableProxyModel::sourceDataAboutToBeFiltered(
+    const QModelIndex& topLeft, const QModelIndex& bottomRight)
+{
+    if (!mFilter || topLeft.parent().isValid())
+        return;
+
+    const int end = std::min(bottomRight.row() + 1, static_cast<int>(mFilterResults.size()));
+    for (int row = std::max(topLeft.row(), 0); row < end; ++row)
+        mFilterResults[row] = testFilter(row);
+}
+
 CSMWorld::IdTableProxyModel::IdTableProxyModel(QObject* parent)
     : QSortFilterProxyModel(parent)
     , mFilterTimer{ new QTimer(this) }
@@ -86,6 +138,17 @@ QModelIndex CSMWorld::IdTableProxyModel::getModelIndex(const std::string& id, in
 
 void CSMWorld::IdTableProxyModel::setSourceModel(QAbstractItemModel* model)
 {
+    mFilterResults.clear();
+
+    // Connected before QSortFilterProxyModel to update the filter results before they are used for the changed rows
+    if (auto* const table = dynamic_cast<IdTableBase*>(model))
+    {
+        connect(table, &IdTableBase::dataChanged, this, &IdTableProxyModel::sourceDataAboutToBeFiltered);
+        connect(table, &IdTableBase::rowsAboutToBeInserted, this, [this] { mFilterResults.clear(); });
+        connect(table, &IdTableBase::rowsAboutToBeRemoved, this, [this] { mFilterResults.clear(); });
+        connect(table, &IdTableBase::modelAboutToBeReset, this, [this] { mFilterResults.clear(); });
+    }
+
     QSortFilterProxyModel::setSourceModel(model);
 
     mSourceModel = dynamic_cast<IdTableBase*>(sourceModel());
@@ -134,6 +197,7 @@ void CSMWorld::IdTableProxyModel::refreshFilter()
     if (mFilter)
     {
         updateColumnMap();
+        updateFilterResults();
         invalidateFilter();
     }
 }
@@ -145,6 +209,7 @@ void CSMWorld::IdTableProxyModel::timerTimeout()
         beginResetModel();
         mFilter = mAwaitingFilter;
         updateColumnMap();
+        updateFilterResults();
         endResetModel();
         mAwaitingFilter.reset();
     }
@@ -174,5 +239,6 @@ void CSMWorld::IdTableProxyModel::sourceRowsRemoved(const QModelIndex& /*parent*
 
 void CSMWorld::IdTableProxyModel::sourceDataChanged(const QModelIndex& /*topLeft*/, const QModelIndex& /*bottomRight*/)
 {
-    refreshFilter();
+    // The changed rows are filtered again by QSortFilterProxyModel using the results updated in
+    // sourceDataAboutToBeFiltered()
 }
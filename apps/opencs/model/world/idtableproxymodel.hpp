@@ -35,6 +35,9 @@ namespace CSMWorld
         std::unique_ptr<QTimer> mFilterTimer;
         std::shared_ptr<CSMFilter::Node> mAwaitingFilter;
         std::map<int, int> mColumnMap; // column ID, column index in this model (or -1)
+        // Filter result of each source row, evaluated in parallel for the whole table and then kept up to date with
+        // the source rows. Empty when rows need to be tested one by one.
+        std::vector<char> mFilterResults;
 
         // Cache of enum values for enum columns (e.g. Modified, Record Type).
         // Used to speed up comparisons during the sort by such columns.
@@ -47,6 +50,14 @@ namespace CSMWorld
     private:
         void updateColumnMap();
 
+        bool testFilter(int sourceRow) const;
+
+        void updateFilterResults();
+        ///< Evaluate the filter for all source rows.
+
+        void sourceDataAboutToBeFiltered(const QModelIndex& topLeft, const QModelIndex& bottomRight);
+        ///< Re-evaluate the filter for the changed rows before QSortFilterProxyModel filters them.
+
     public:
         IdTableProxyModel(QObject* parent = nullptr);
 
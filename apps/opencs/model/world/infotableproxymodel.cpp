@@ -100,8 +100,6 @@ void CSMWorld::InfoTableProxyModel::sourceRowsInserted(const QModelIndex& parent
 
 void CSMWorld::InfoTableProxyModel::sourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight)
 {
-    refreshFilter();
-
     if (mLastAddedSourceRow != -1 && topLeft.row() <= mLastAddedSourceRow && bottomRight.row() >= mLastAddedSourceRow)
     {
         // Now the topic of the last added row is set,
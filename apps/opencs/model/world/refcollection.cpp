@@ -21,6 +21,15 @@
 
 namespace CSMWorld
 {
+    namespace
+    {
+        // Cell ids are compared as strings, like the cell ids of the render view
+        ESM::RefId toCellKey(const ESM::RefId& cell)
+        {
+            return ESM::RefId::stringRefId(cell.toString());
+        }
+    }
+
     template <>
     void Collection<CellRef>::removeRows(int index, int count)
     {
@@ -252,7 +261,7 @@ int CSMWorld::RefCollection::getIntIndex(unsigned int id) const
 
 int CSMWorld::RefCollection::searchId(unsigned int id) const
 {
-    std::map<unsigned int, int>::const_iterator iter = mRefIndex.find(id);
+    const auto iter = mRefIndex.find(id);
 
     if (iter == mRefIndex.end())
         return -1;
@@ -260,26 +269,78 @@ int CSMWorld::RefCollection::searchId(unsigned int id) const
     return iter->second;
 }
 
-void CSMWorld::RefCollection::removeRows(int index, int count)
+void CSMWorld::RefCollection::updateRefIndex(int begin, int end)
 {
-    Collection<CellRef>::removeRows(index, count); // erase records only
+    for (int i = begin; i < end; ++i)
+        mRefIndex.at(getRecord(i).get().mIdNum) = i;
+}
 
-    std::map<unsigned int, int>::iterator iter = mRefIndex.begin();
-    while (iter != mRefIndex.end())
+void CSMWorld::RefCollection::indexCell(const CellRef& ref)
+{
+    const ESM::RefId cell = toCellKey(ref.mCell);
+
+    const auto indexed = mIndexedCells.find(ref.mIdNum);
+    if (indexed != mIndexedCells.end())
     {
-        if (iter->second >= index)
-        {
-            if (iter->second >= index + count)
-            {
-                iter->second -= count;
-                ++iter;
-            }
-            else
-                mRefIndex.erase(iter++);
-        }
-        else
-            ++iter;
+        if (indexed->second == cell)
+            return;
+        unindexCell(ref.mIdNum);
+    }
+
+    mRefsByCell[cell].insert(ref.mIdNum);
+    mIndexedCells.emplace(ref.mIdNum, cell);
+}
+
+void CSMWorld::RefCollection::unindexCell(unsigned int idNum)
+{
+    const auto indexed = mIndexedCells.find(idNum);
+    if (indexed == mIndexedCells.end())
+        return;
+
+    const auto refs = mRefsByCell.find(indexed->second);
+    if (refs != mRefsByCell.end())
+    {
+        refs->second.erase(idNum);
+        if (refs->second.empty())
+            mRefsByCell.erase(refs);
+    }
+
+    mIndexedCells.erase(indexed);
+}
+
+void CSMWorld::RefCollection::removeRows(int index, int count)
+{
+    for (int i = index; i < index + count; ++i)
+    {
+        const unsigned int idNum = getRecord(i).get().mIdNum;
+        mRefIndex.erase(idNum);
+        unindexCell(idNum);
     }
+
+    Collection<CellRef>::removeRows(index, count); // erase records only
+
+    updateRefIndex(index, getSize());
+}
+
+void CSMWorld::RefCollection::setData(int index, int column, const QVariant& data)
+{
+    Collection<CellRef>::setData(index, column, data);
+
+    indexCell(getRecord(index).get());
+}
+
+void CSMWorld::RefCollection::replace(int index, std::unique_ptr<RecordBase> record)
+{
+    Collection<CellRef>::replace(index, std::move(record));
+
+    indexCell(getRecord(index).get());
+}
+
+void CSMWorld::RefCollection::setRecord(int index, std::unique_ptr<Record<CellRef>> record)
+{
+    Collection<CellRef>::setRecord(index, std::move(record));
+
+    indexCell(getRecord(index).get());
 }
 
 void CSMWorld::RefCollection::appendBlankRecord(const ESM::RefId& id, UniversalId::Type type)
@@ -330,23 +391,36 @@ void CSMWorld::RefCollection::appendRecord(std::unique_ptr<RecordBase> record, U
     mRefIndex.insert(std::make_pair(static_cast<Record<CellRef>*>(record.get())->get().mIdNum, index));
 
     Collection<CellRef>::insertRecord(std::move(record), index, type); // add records only
+
+    indexCell(getRecord(index).get());
 }
 
 void CSMWorld::RefCollection::insertRecord(std::unique_ptr<RecordBase> record, int index, UniversalId::Type type)
 {
-    int size = getAppendIndex(/*id*/ ESM::RefId(), type); // for CellRef records id is ignored
     unsigned int idNum = static_cast<Record<CellRef>*>(record.get())->get().mIdNum;
 
     Collection<CellRef>::insertRecord(std::move(record), index, type); // add records only
 
-    if (index < size - 1)
-    {
-        for (std::map<unsigned int, int>::iterator iter(mRefIndex.begin()); iter != mRefIndex.end(); ++iter)
-        {
-            if (iter->second >= index)
-                ++(iter->second);
-        }
-    }
-
     mRefIndex.insert(std::make_pair(idNum, index));
+
+    updateRefIndex(index + 1, getSize());
+
+    indexCell(getRecord(index).get());
+}
+
+std::vector<int> CSMWorld::RefCollection::getCellReferences(const ESM::RefId& cell) const
+{
+    std::vector<int> indices;
+
+    const auto refs = mRefsByCell.find(toCellKey(cell));
+    if (refs == mRefsByCell.end())
+        return indices;
+
+    indices.reserve(refs->second.size());
+    for (const unsigned int idNum : refs->second)
+        indices.push_back(getIntIndex(idNum));
+
+    std::sort(indices.begin(), indices.end());
+
+    return indices;
 }
@@ -6,6 +6,8 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <apps/opencs/model/world/universalid.hpp>
@@ -38,7 +40,11 @@ namespace CSMWorld
     class RefCollection final : public Collection<CellRef>
     {
         Collection<Cell>& mCells;
-        std::map<unsigned int, int> mRefIndex; // CellRef index keyed by CSMWorld::CellRef::mIdNum
+        std::unordered_map<unsigned int, int> mRefIndex; // CellRef index keyed by CSMWorld::CellRef::mIdNum
+        // CSMWorld::CellRef::mIdNum of the references keyed by their cell
+        std::unordered_map<ESM::RefId, std::unordered_set<unsigned int>> mRefsByCell;
+        // Cell each reference is registered in mRefsByCell with, keyed by CSMWorld::CellRef::mIdNum
+        std::unordered_map<unsigned int, ESM::RefId> mIndexedCells;
 
         int mNextId;
         uint32_t mHighestUsedRefNum = 0;
@@ -51,6 +57,13 @@ namespace CSMWorld
 
         int searchId(unsigned int id) const;
 
+        void updateRefIndex(int begin, int end);
+        ///< Set the index of the references in [begin, end) to their position, only these references are visited.
+
+        void indexCell(const CellRef& ref);
+
+        void unindexCell(unsigned int idNum);
+
     public:
         // MSVC needs the constructor for a class inheriting a template to be defined in header
         RefCollection(Collection<Cell>& cells)
@@ -67,6 +80,13 @@ namespace CSMWorld
 
         void removeRows(int index, int count) override;
 
+        void setData(int index, int column, const QVariant& data) override;
+
+        void replace(int index, std::unique_ptr<RecordBase> record) override;
+
+        void setRecord(int index, std::unique_ptr<Record<CellRef>> record);
+        ///< \attention This function must not change the ID.
+
         void appendBlankRecord(const ESM::RefId& id, UniversalId::Type type = UniversalId::Type_None) override;
 
         void cloneRecord(
@@ -78,6 +98,9 @@ namespace CSMWorld
 
         void insertRecord(
             std::unique_ptr<RecordBase> record, int index, UniversalId::Type type = UniversalId::Type_None) override;
+
+        std::vector<int> getCellReferences(const ESM::RefId& cell) const;
+        ///< Return the sorted indices of all references in \a cell, including deleted ones.
     };
 }
 
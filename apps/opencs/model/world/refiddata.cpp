@@ -5,6 +5,7 @@
 
 #include <components/misc/strings/lower.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string_view>
 #include <type_traits>
@@ -296,6 +297,8 @@ std::vector<ESM::RefId> CSMWorld::RefIdData::getIds(bool listDeleted) const
         }
     }
 
+    std::sort(ids.begin(), ids.end());
+
     return ids;
 }
 
@@ -8,6 +8,7 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -262,7 +263,7 @@ namespace CSMWorld
         RefIdDataContainer<ESM::Static> mStatics;
         RefIdDataContainer<ESM::Weapon> mWeapons;
 
-        std::map<ESM::RefId, LocalIndex> mIndex;
+        std::unordered_map<ESM::RefId, LocalIndex> mIndex;
 
         std::map<UniversalId::Type, RefIdDataContainerBase*> mRecordContainers;
 
@@ -96,13 +96,16 @@ bool CSVRender::Cell::addObjects(int start, int end)
 
     const CSMWorld::RefCollection& collection = mData.getReferences();
 
-    for (int i = start; i <= end; ++i)
+    const std::vector<int> indices = collection.getCellReferences(mId);
+
+    for (auto index = std::lower_bound(indices.begin(), indices.end(), start);
+         index != indices.end() && *index <= end; ++index)
     {
-        const auto& cellId = ESM::RefId::stringRefId(collection.getRecord(i).get().mCell.toString());
+        const int i = *index;
 
         CSMWorld::RecordBase::State state = collection.getRecord(i).mState;
 
-        if (cellId == mId && state != CSMWorld::RecordBase::State_Deleted)
+        if (state != CSMWorld::RecordBase::State_Deleted)
         {
             const std::string& id = collection.getRecord(i).get().mId.getRefIdString();
 
@@ -0,0 +1,109 @@
+#include <apps/opencs/model/doc/messages.hpp>
+#include <apps/opencs/model/doc/operation.hpp>
+#include <apps/opencs/model/doc/stage.hpp>
+
+#include <QCoreApplication>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace CSMDoc
+{
+    namespace
+    {
+        struct TestStage : Stage
+        {
+            std::string mName;
+            int mSteps;
+            bool mConcurrent;
+            int mThrowAt = -1;
+
+            TestStage(std::string name, int steps, bool concurrent)
+                : mName(std::move(name))
+                , mSteps(steps)
+                , mConcurrent(concurrent)
+            {
+            }
+
+            int setup() override { return mSteps; }
+
+            void perform(int stage, Messages& messages) override
+            {
+                if (stage == mThrowAt)
+                    throw std::runtime_error(mName + " failed");
+                if (stage % 3 == 0)
+                    messages.add(CSMWorld::UniversalId(), mName + " " + std::to_string(stage));
+            }
+
+            bool isConcurrent() const override { return mConcurrent; }
+        };
+
+        struct Result
+        {
+            std::vector<std::string> mMessages;
+            int mLastProgress = 0;
+            int mMaxProgress = 0;
+            bool mFailed = false;
+        };
+
+        Result run(std::size_t threads, int throwAt = -1)
+        {
+            int argc = 0;
+            QCoreApplication application(argc, nullptr);
+
+            Operation operation(State_Verifying, false);
+            operation.appendStage(new TestStage("serial", 700, false));
+            auto* concurrent = new TestStage("concurrent", 2000, true);
+            concurrent->mThrowAt = throwAt;
+            operation.appendStage(concurrent);
+            operation.appendStage(new TestStage("empty", 0, true));
+            operation.appendStage(new TestStage("last", 100, false));
+            operation.setConcurrency(threads);
+
+            Result result;
+            QObject::connect(&operation, &Operation::reportMessage,
+                [&](const Message& message, int) { result.mMessages.push_back(message.mMessage); });
+            QObject::connect(&operation, &Operation::progress, [&](int current, int max, int) {
+                result.mLastProgress = current;
+                result.mMaxProgress = max;
+            });
+            QObject::connect(&operation, &Operation::done, [&](int, bool failed) {
+                result.mFailed = failed;
+                application.quit();
+            });
+
+            operation.run();
+            application.exec();
+
+            return result;
+        }
+
+        TEST(CSMDocOperationTest, concurrentExecutionShouldReportMessagesInSequentialOrder)
+        {
+            const Result sequential = run(1);
+            const Result concurrent = run(4);
+
+            EXPECT_FALSE(sequential.mFailed);
+            EXPECT_FALSE(concurrent.mFailed);
+            EXPECT_EQ(concurrent.mMessages, sequential.mMessages);
+            EXPECT_EQ(concurrent.mLastProgress, 2800);
+            EXPECT_EQ(concurrent.mMaxProgress, 2800);
+        }
+
+        TEST(CSMDocOperationTest, concurrentExecutionShouldStopAtFailedStepLikeSequential)
+        {
+            const Result sequential = run(1, 1234);
+            const Result concurrent = run(4, 1234);
+
+            EXPECT_TRUE(sequential.mFailed);
+            EXPECT_TRUE(concurrent.mFailed);
+            ASSERT_FALSE(concurrent.mMessages.empty());
+            EXPECT_EQ(concurrent.mMessages.back(), "concurrent failed");
+            EXPECT_EQ(concurrent.mMessages, sequential.mMessages);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#include "apps/opencs/model/world/refcollection.hpp"
+
+#include "apps/opencs/model/world/cell.hpp"
+#include "apps/opencs/model/world/record.hpp"
+#include "apps/opencs/model/world/ref.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CSMWorld
+{
+    namespace
+    {
+        std::unique_ptr<Record<CellRef>> makeRecord(unsigned int idNum, std::string_view cell)
+        {
+            auto record = std::make_unique<Record<CellRef>>();
+            record->mState = RecordBase::State_ModifiedOnly;
+            record->mModified.blank();
+            record->mModified.mId = ESM::RefId::stringRefId("ref#" + std::to_string(idNum));
+            record->mModified.mIdNum = idNum;
+            record->mModified.mCell = ESM::RefId::stringRefId(cell);
+            return record;
+        }
+
+        void expectIndexed(const RefCollection& collection)
+        {
+            for (int i = 0; i < collection.getSize(); ++i)
+                EXPECT_EQ(collection.searchId(collection.getRecord(i).get().mId), i) << i;
+        }
+
+        struct CSMWorldRefCollectionTest : ::testing::Test
+        {
+            Collection<Cell> mCells;
+            RefCollection mRefs{ mCells };
+
+            CSMWorldRefCollectionTest()
+            {
+                mRefs.appendRecord(makeRecord(1, "a"));
+                mRefs.appendRecord(makeRecord(2, "b"));
+                mRefs.appendRecord(makeRecord(3, "a"));
+            }
+        };
+
+        TEST_F(CSMWorldRefCollectionTest, insertRecordShouldShiftFollowingIndices)
+        {
+            mRefs.insertRecord(makeRecord(4, "b"), 2);
+            expectIndexed(mRefs);
+            EXPECT_EQ(mRefs.getCellReferences(ESM::RefId::stringRefId("a")), (std::vector<int>{ 0, 3 }));
+            EXPECT_EQ(mRefs.getCellReferences(ESM::RefId::stringRefId("b")), (std::vector<int>{ 1, 2 }));
+        }
+
+        TEST_F(CSMWorldRefCollectionTest, insertRecordBeforeLastShouldShiftLast)
+        {
+            mRefs.insertRecord(makeRecord(4, "b"), mRefs.getSize() - 1);
+            expectIndexed(mRefs);
+        }
+
+        TEST_F(CSMWorldRefCollectionTest, removeRowsShouldUpdateIndices)
+        {
+            mRefs.removeRows(0, 2);
+            expectIndexed(mRefs);
+            EXPECT_EQ(mRefs.searchId(ESM::RefId::stringRefId("ref#1")), -1);
+            EXPECT_EQ(mRefs.getCellReferences(ESM::RefId::stringRefId("a")), (std::vector<int>{ 0 }));
+            EXPECT_TRUE(mRefs.getCellReferences(ESM::RefId::stringRefId("b")).empty());
+        }
+
+        TEST_F(CSMWorldRefCollectionTest, setRecordShouldMoveReferenceToNewCell)
+        {
+            mRefs.setRecord(0, makeRecord(1, "b"));
+            EXPECT_EQ(mRefs.getCellReferences(ESM::RefId::stringRefId("a")), (std::vector<int>{ 2 }));
+            EXPECT_EQ(mRefs.getCellReferences(ESM::RefId::stringRefId("b")), (std::vector<int>{ 0, 1 }));
+        }
+    }
+}
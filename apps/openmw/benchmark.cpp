@@ -0,0 +1,240 @@
+#include "benchmark.hpp"
+
+#include <cerrno>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+
+#include <osg/Stats>
+#include <osgViewer/Viewer>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+
+#include "../../performance_toolkit/benchmark/benchmark_report.hpp"
+
+#include "mwbase/environment.hpp"
+#include "mwbase/inputmanager.hpp"
+#include "mwbase/statemanager.hpp"
+#include "mwbase/world.hpp"
+
+#include "mwworld/class.hpp"
+#include "mwworld/ptr.hpp"
+
+#include "profile.hpp"
+
+namespace OMW
+{
+    namespace
+    {
+        // Rendering happens in parallel to the main thread, its stats are complete a few frames later
+        constexpr unsigned statsReportDelay = 3;
+
+        // Interval between recorded camera keys in seconds of simulation time
+        constexpr double recordInterval = 0.25;
+
+        bool isGameRunning()
+        {
+            return MWBase::Environment::get().getStateManager()->getState()
+                == MWBase::StateManager::State_Running;
+        }
+
+        PerformanceToolkit::BenchmarkTrack readTrack(const std::filesystem::path& path)
+        {
+            std::ifstream stream(path);
+            if (!stream.is_open())
+                throw std::system_error(errno, std::generic_category(),
+                    "Failed to open benchmark track " + Files::pathToUnicodeString(path));
+            return PerformanceToolkit::BenchmarkTrack::read(stream);
+        }
+
+        double getAttribute(osg::Stats& stats, unsigned frameNumber, const std::string& name)
+        {
+            double value = 0;
+            if (!stats.getAttribute(frameNumber, name, value))
+                return std::numeric_limits<double>::quiet_NaN();
+            return value;
+        }
+
+        double getAttributeOrZero(osg::Stats* stats, unsigned frameNumber, const std::string& name)
+        {
+            double value = 0;
+            if (stats != nullptr)
+                stats->getAttribute(frameNumber, name, value);
+            return value;
+        }
+    }
+
+    BenchmarkRunner::BenchmarkRunner(const std::filesystem::path& trackPath, const std::filesystem::path& outputPath)
+        : mTrack(readTrack(trackPath))
+        , mSceneName(Files::pathToUnicodeString(trackPath.stem()))
+        , mOutputPath(outputPath)
+    {
+        forEachUserStatsValue([&](const UserStats& v) {
+            mSubsystemNames.push_back(v.mName);
+            mSubsystemAttributes.push_back(v.mTaken);
+        });
+
+        Log(Debug::Info) << "Running benchmark " << trackPath << " for " << mTrack.getDuration() << " seconds";
+    }
+
+    void BenchmarkRunner::setUpStats(osgViewer::Viewer& viewer) const
+    {
+        viewer.getViewerStats()->collectStats("engine", true);
+        if (osg::Stats* const stats = viewer.getCamera()->getStats())
+        {
+            stats->collectStats("rendering", true);
+            stats->collectStats("gpu", true);
+            stats->collectStats("scene", true);
+        }
+    }
+
+    void BenchmarkRunner::beginFrame(float dt)
+    {
+        mFrameBegin = std::chrono::steady_clock::now();
+        mActive = !mFinished && isGameRunning();
+        if (!mActive)
+            return;
+
+        if (mTrack.hasCamera())
+        {
+            const PerformanceToolkit::CameraKey key = mTrack.sampleCamera(mTime);
+            MWBase::World& world = *MWBase::Environment::get().getWorld();
+            MWWorld::Ptr player = world.getPlayerPtr();
+            player = world.moveObject(player, osg::Vec3f(key.position[0], key.position[1], key.position[2]));
+            world.rotateObject(player, osg::Vec3f(key.pitch, 0, key.yaw), MWBase::RotationFlag_none);
+        }
+
+        for (const PerformanceToolkit::InputKey& key : mTrack.getInputs(mTime, mTime + dt))
+            MWBase::Environment::get().getInputManager()->executeAction(key.action);
+
+        mTime += dt;
+        mFinished = mTime > mTrack.getDuration();
+    }
+
+    void BenchmarkRunner::endFrame(unsigned frameNumber, osgViewer::Viewer& viewer)
+    {
+        const auto now = std::chrono::steady_clock::now();
+
+        if (mActive)
+        {
+            const auto frameTime = now - (mLastFrameEnd.time_since_epoch().count() != 0 ? mLastFrameEnd : mFrameBegin);
+            const PerformanceToolkit::LiveStats& liveStats = PerformanceToolkit::Toolkit::getInstance().getLiveStats();
+
+            PerformanceToolkit::FrameStats stats{};
+            stats.dt = std::chrono::duration<float>(frameTime).count();
+            stats.cpuMainTime = std::chrono::duration<double>(now - mFrameBegin).count();
+            stats.terrainNodes = liveStats.terrainNodes;
+            stats.terrainChunks = liveStats.terrainChunks;
+            stats.terrainCompositeCount = liveStats.terrainCompositeCount;
+            mPendingFrames.push_back(PendingFrame{ frameNumber, std::move(stats) });
+        }
+
+        mLastFrameEnd = now;
+
+        // Loading screens render frames inside a simulation frame, the viewer frame number can be ahead
+        const unsigned currentFrameNumber = viewer.getFrameStamp()->getFrameNumber();
+        if (currentFrameNumber >= statsReportDelay)
+            completeFrames(currentFrameNumber - statsReportDelay, viewer);
+    }
+
+    void BenchmarkRunner::completeFrames(unsigned lastFrameNumber, osgViewer::Viewer& viewer)
+    {
+        osg::Stats& viewerStats = *viewer.getViewerStats();
+        osg::Stats* const cameraStats = viewer.getCamera()->getStats();
+
+        while (!mPendingFrames.empty() && mPendingFrames.front().mFrameNumber <= lastFrameNumber)
+        {
+            const unsigned frameNumber = mPendingFrames.front().mFrameNumber;
+            PerformanceToolkit::FrameStats& stats = mPendingFrames.front().mStats;
+
+            stats.cpuCullTime = getAttributeOrZero(cameraStats, frameNumber, "Cull traversal time taken");
+            stats.cpuDrawTime = getAttributeOrZero(cameraStats, frameNumber, "Draw traversal time taken");
+            stats.gpuTime = getAttributeOrZero(cameraStats, frameNumber, "GPU draw time taken");
+            // Each primitive set is drawn by a separate draw call
+            stats.drawCalls = static_cast<unsigned>(
+                getAttributeOrZero(cameraStats, frameNumber, "Visible number of PrimitiveSets"));
+            stats.visibleObjects = static_cast<unsigned>(
+                getAttributeOrZero(cameraStats, frameNumber, "Visible number of drawables"));
+
+            stats.cpuSubsystemTimes.reserve(mSubsystemAttributes.size());
+            for (const std::string& attribute : mSubsystemAttributes)
+                stats.cpuSubsystemTimes.push_back(getAttribute(viewerStats, frameNumber, attribute));
+
+            mFrames.push_back(std::move(stats));
+            mPendingFrames.pop_front();
+        }
+    }
+
+    void BenchmarkRunner::writeResult(osgViewer::Viewer& viewer)
+    {
+        completeFrames(std::numeric_limits<unsigned>::max(), viewer);
+
+        if (!mFinished)
+            Log(Debug::Warning) << "Benchmark is interrupted at " << mTime << " of " << mTrack.getDuration()
+                                << " seconds";
+
+        const PerformanceToolkit::BenchmarkResult result
+            = PerformanceToolkit::makeBenchmarkResult(mSceneName, std::move(mFrames), mSubsystemNames);
+        mFrames.clear();
+
+        std::ofstream stream(mOutputPath);
+        if (!stream.is_open())
+        {
+            Log(Debug::Error) << "Failed to open benchmark result file " << mOutputPath << ": "
+                              << std::generic_category().message(errno);
+            return;
+        }
+
+        PerformanceToolkit::writeBenchmarkResult(result, stream);
+
+        Log(Debug::Info) << "Benchmark result for " << result.totalFrames << " frames with average frame time "
+                         << result.avgFrameTime * 1000 << " ms is written to " << mOutputPath;
+    }
+
+    BenchmarkRecorder::BenchmarkRecorder(const std::filesystem::path& trackPath)
+        : mTrackPath(trackPath)
+    {
+        Log(Debug::Info) << "Recording benchmark track to " << trackPath;
+    }
+
+    void BenchmarkRecorder::update(float dt)
+    {
+        if (!isGameRunning())
+            return;
+
+        if (mTime >= mNextKeyTime)
+        {
+            const MWWorld::Ptr player = MWBase::Environment::get().getWorld()->getPlayerPtr();
+            const ESM::Position& position = player.getRefData().getPosition();
+
+            PerformanceToolkit::CameraKey key;
+            key.time = mTime;
+            key.position = { position.pos[0], position.pos[1], position.pos[2] };
+            key.pitch = position.rot[0];
+            key.yaw = position.rot[2];
+            mTrack.addCamera(key);
+
+            mNextKeyTime = mTime + recordInterval;
+        }
+
+        mTime += dt;
+    }
+
+    void BenchmarkRecorder::save() const
+    {
+        std::ofstream stream(mTrackPath);
+        if (!stream.is_open())
+        {
+            Log(Debug::Error) << "Failed to open benchmark track file " << mTrackPath << ": "
+                              << std::generic_category().message(errno);
+            return;
+        }
+
+        mTrack.write(stream);
+
+        Log(Debug::Info) << "Benchmark track with " << mTrack.getCameraKeys().size() << " camera keys is written to "
+                         << mTrackPath;
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef OPENMW_BENCHMARK_H
+#define OPENMW_BENCHMARK_H
+
+#include "../../performance_toolkit/benchmark/benchmark_track.hpp"
+#include "../../performance_toolkit/toolkit.hpp"
+
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace osgViewer
+{
+    class Viewer;
+}
+
+namespace OMW
+{
+    /// \brief Replays a benchmark track over the running game and collects statistics of the replayed frames
+    ///
+    /// The track clock advances only while the game is running, so loading the start cell or save is not measured.
+    class BenchmarkRunner
+    {
+    public:
+        BenchmarkRunner(const std::filesystem::path& trackPath, const std::filesystem::path& outputPath);
+
+        /// Enables collecting the statistics required for the result
+        void setUpStats(osgViewer::Viewer& viewer) const;
+
+        /// Moves the player along the track and executes recorded input actions. Call before simulating a frame.
+        void beginFrame(float dt);
+
+        /// Records statistics of the frame. Rendering statistics are read a few frames later when they are complete.
+        void endFrame(unsigned frameNumber, osgViewer::Viewer& viewer);
+
+        bool isFinished() const { return mFinished; }
+
+        /// Writes collected statistics into the output file
+        void writeResult(osgViewer::Viewer& viewer);
+
+    private:
+        struct PendingFrame
+        {
+            unsigned mFrameNumber;
+            PerformanceToolkit::FrameStats mStats;
+        };
+
+        PerformanceToolkit::BenchmarkTrack mTrack;
+        std::string mSceneName;
+        std::filesystem::path mOutputPath;
+        std::vector<std::string> mSubsystemNames;
+        std::vector<std::string> mSubsystemAttributes;
+        double mTime = 0;
+        bool mActive = false;
+        bool mFinished = false;
+        std::chrono::steady_clock::time_point mFrameBegin;
+        std::chrono::steady_clock::time_point mLastFrameEnd;
+        std::deque<PendingFrame> mPendingFrames;
+        std::vector<PerformanceToolkit::FrameStats> mFrames;
+
+        void completeFrames(unsigned lastFrameNumber, osgViewer::Viewer& viewer);
+    };
+
+    /// \brief Samples the player position and view direction into a benchmark track while the game is running
+    class BenchmarkRecorder
+    {
+    public:
+        explicit BenchmarkRecorder(const std::filesystem::path& trackPath);
+
+        void update(float dt);
+
+        void save() const;
+
+    private:
+        std::filesystem::path mTrackPath;
+        PerformanceToolkit::BenchmarkTrack mTrack;
+        double mTime = 0;
+        double mNextKeyTime = 0;
+    };
+}
+
+#endif
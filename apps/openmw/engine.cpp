@@ -18,6 +18,7 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/debug/gldebug.hpp>
+#include <components/debug/tracing.hpp>
 
 #include <components/misc/rng.hpp>
 #include <components/misc/strings/format.hpp>
@@ -50,6 +51,8 @@
 
 #include <components/misc/frameratelimiter.hpp>
 
+#include <components/myguiplatform/myguirendermanager.hpp>
+
 #include <components/sceneutil/color.hpp>
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/screencapture.hpp>
@@ -88,6 +91,7 @@
 
 #include "mwstate/statemanagerimp.hpp"
 
+#include "benchmark.hpp"
 #include "profile.hpp"
 
 namespace
@@ -184,15 +188,24 @@ bool OMW::Engine::runMainLoopIteration(
 {
     static constexpr std::chrono::steady_clock::duration sMaxSimulationInterval(std::chrono::milliseconds(200));
 
-    const double dt = std::chrono::duration_cast<std::chrono::duration<double>>(
-                          std::min(frameRateLimiter.getLastFrameDuration(), sMaxSimulationInterval))
-                          .count()
-        * timeManager.getSimulationTimeScale();
+    // Benchmark simulates the same sequence of frames independently of the rendering performance
+    const double frameDuration = mBenchmarkRunner != nullptr
+        ? mBenchmarkTimeStep
+        : std::chrono::duration_cast<std::chrono::duration<double>>(
+            std::min(frameRateLimiter.getLastFrameDuration(), sMaxSimulationInterval))
+              .count();
+    const double dt = frameDuration * timeManager.getSimulationTimeScale();
 
     mViewer->advance(timeManager.getRenderingSimulationTime());
 
     const unsigned frameNumber = mViewer->getFrameStamp()->getFrameNumber();
 
+    if (mBenchmarkRunner != nullptr)
+        mBenchmarkRunner->beginFrame(static_cast<float>(dt));
+
+    if (mBenchmarkRecorder != nullptr)
+        mBenchmarkRecorder->update(static_cast<float>(dt));
+
     if (!frame(frameNumber, static_cast<float>(dt)))
     {
 #if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
@@ -201,6 +214,9 @@ bool OMW::Engine::runMainLoopIteration(
         return true;
     }
 
+    if (mBenchmarkRunner != nullptr)
+        mBenchmarkRunner->endFrame(frameNumber, *mViewer);
+
     timeManager.updateIsPaused();
     if (!timeManager.isPaused())
     {
@@ -225,7 +241,8 @@ bool OMW::Engine::runMainLoopIteration(
 
     frameRateLimiter.limit();
 
-    return !mViewer->done() && !mStateManager->hasQuitRequest();
+    return !mViewer->done() && !mStateManager->hasQuitRequest()
+        && (mBenchmarkRunner == nullptr || !mBenchmarkRunner->isFinished());
 }
 
 void OMW::Engine::shutdownAfterMainLoop()
@@ -241,6 +258,15 @@ void OMW::Engine::shutdownAfterMainLoop()
     Settings::ShaderManager::get().save();
     mLuaManager->savePermanentStorage(mCfgMgr.getUserConfigPath());
 
+    if (Debug::Tracing::isEnabled())
+        Debug::Tracing::dump();
+
+    if (mBenchmarkRunner != nullptr)
+        mBenchmarkRunner->writeResult(*mViewer);
+
+    if (mBenchmarkRecorder != nullptr)
+        mBenchmarkRecorder->save();
+
 #ifdef __EMSCRIPTEN__
     emscripten_run_script(R"(
         if (typeof globalThis !== 'undefined' && typeof globalThis.__openmwSyncPersistentStorage === 'function') {
@@ -326,6 +352,8 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
     const osg::Timer* const timer = osg::Timer::instance();
     osg::Stats* const stats = mViewer->getViewerStats();
 
+    OPENMW_TRACE_ZONE("Frame");
+
     mEnvironment.setFrameDuration(frametime);
 
     try
@@ -466,14 +494,23 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
         mWorld->reportStats(frameNumber, *stats);
         PerformanceToolkit::Toolkit::getInstance().reportStats(frameNumber, *stats);
         mLuaManager->reportStats(frameNumber, *stats);
+        if (MyGUIPlatform::RenderManager* guiRenderManager = MyGUIPlatform::RenderManager::getInstancePtr())
+            guiRenderManager->reportStats(frameNumber, *stats);
 
         stats->setAttribute(frameNumber, "StringRefId Count", static_cast<double>(ESM::StringRefId::totalCount()));
     }
 
     mStereoManager->updateSettings(Settings::camera().mNearClip, Settings::camera().mViewingDistance);
 
-    mViewer->eventTraversal();
-    mViewer->updateTraversal();
+    {
+        OPENMW_TRACE_ZONE("EventTraversal");
+        mViewer->eventTraversal();
+    }
+
+    {
+        OPENMW_TRACE_ZONE("UpdateTraversal");
+        mViewer->updateTraversal();
+    }
 
     // update focus object for GUI
     {
@@ -484,7 +521,10 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
     // if there is a separate Lua thread, it starts the update now
     mLuaWorker->allowUpdate(frameStart, frameNumber, *stats);
 
-    mViewer->renderingTraversals();
+    {
+        OPENMW_TRACE_ZONE("RenderingTraversals");
+        mViewer->renderingTraversals();
+    }
 
     mLuaWorker->finishUpdate(frameStart, frameNumber, *stats);
 
@@ -555,6 +595,8 @@ OMW::Engine::~Engine()
     mScriptContext = nullptr;
 
     mUnrefQueue = nullptr;
+    if (mResourceSystem != nullptr)
+        mResourceSystem->getSceneManager()->setJobSystem(nullptr);
     mWorkQueue = nullptr;
 
     mViewer = nullptr;
@@ -627,7 +669,9 @@ void OMW::Engine::createWindow()
     const int height = Settings::video().mResolutionY;
     const Settings::WindowMode windowMode = Settings::video().mWindowMode;
     const bool windowBorder = Settings::video().mWindowBorder;
-    const SDLUtil::VSyncMode vsync = Settings::video().mVsyncMode;
+    // Benchmark measures the time required to render a frame rather than the display refresh rate
+    const SDLUtil::VSyncMode vsync
+        = mBenchmarkTrackFile.empty() ? Settings::video().mVsyncMode.get() : SDLUtil::VSyncMode::Disabled;
     unsigned antialiasing = static_cast<unsigned>(Settings::video().mAntialiasing);
 
 #ifdef __EMSCRIPTEN__
@@ -646,7 +690,8 @@ void OMW::Engine::createWindow()
         posY = SDL_WINDOWPOS_UNDEFINED_DISPLAY(screen);
     }
 
-    Uint32 flags = SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI;
+    Uint32 flags = SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI;
+    flags |= mHiddenWindow ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN;
     if (windowMode == Settings::WindowMode::Fullscreen)
         flags |= SDL_WINDOW_FULLSCREEN;
     else if (windowMode == Settings::WindowMode::WindowedFullscreen)
@@ -903,6 +948,7 @@ void OMW::Engine::prepareEngine()
     mWorkQueue = new SceneUtil::WorkQueue(Settings::cells().mPreloadNumThreads);
 #endif
     mUnrefQueue = std::make_unique<SceneUtil::UnrefQueue>();
+    mResourceSystem->getSceneManager()->setJobSystem(mWorkQueue->getJobSystem());
 
     mScreenCaptureOperation = new SceneUtil::AsyncScreenCaptureOperation(mWorkQueue,
         new SceneUtil::WriteScreenshotToFileOperation(mCfgMgr.getScreenshotPath(),
@@ -1109,6 +1155,27 @@ void OMW::Engine::go()
 
     Misc::Rng::init(mRandomSeed);
 
+    if (!mBenchmarkTrackFile.empty())
+        mBenchmarkRunner = std::make_unique<BenchmarkRunner>(mBenchmarkTrackFile,
+            mBenchmarkOutputFile.empty() ? mCfgMgr.getUserDataPath() / "benchmark.json" : mBenchmarkOutputFile);
+
+    if (!mBenchmarkRecordFile.empty())
+        mBenchmarkRecorder = std::make_unique<BenchmarkRecorder>(mBenchmarkRecordFile);
+
+#ifdef _WIN32
+    const auto* traceFile = _wgetenv(L"OPENMW_TRACE_FILE");
+#else
+    const auto* traceFile = std::getenv("OPENMW_TRACE_FILE");
+#endif
+
+    Debug::Tracing::setThreadName("Main");
+    Debug::Tracing::setBufferSize(Settings::general().mTracingBufferSize);
+    Debug::Tracing::setOutputPath(
+        traceFile != nullptr ? std::filesystem::path(traceFile) : mCfgMgr.getUserDataPath() / "trace");
+    Debug::Tracing::setEnabled(Settings::general().mTracing || traceFile != nullptr);
+    if (Debug::Tracing::isEnabled())
+        Log(Debug::Info) << "Tracing is enabled";
+
     Settings::ShaderManager::get().load(mCfgMgr.getUserConfigPath() / "shaders.yaml");
 
 #ifdef __EMSCRIPTEN__
@@ -1197,6 +1264,9 @@ void OMW::Engine::go()
     if (stats.is_open())
         Resource::collectStatistics(*mViewer);
 
+    if (mBenchmarkRunner != nullptr)
+        mBenchmarkRunner->setUpStats(*mViewer);
+
     // Start the game
     if (!mSaveGameFile.empty())
     {
@@ -1228,7 +1298,8 @@ void OMW::Engine::go()
 
     // Start the main rendering loop
     MWWorld::DateTimeManager& timeManager = *mWorld->getTimeManager();
-    Misc::FrameRateLimiter frameRateLimiter = Misc::makeFrameRateLimiter(mEnvironment.getFrameRateLimit());
+    Misc::FrameRateLimiter frameRateLimiter
+        = Misc::makeFrameRateLimiter(mBenchmarkRunner != nullptr ? 0 : mEnvironment.getFrameRateLimit());
 
 #ifdef __EMSCRIPTEN__
     mWasmTimeManager = &timeManager;
@@ -1299,3 +1370,12 @@ void OMW::Engine::setRandomSeed(unsigned int seed)
 {
     mRandomSeed = seed;
 }
+
+void OMW::Engine::setBenchmark(const std::filesystem::path& track, const std::filesystem::path& output, float timeStep)
+{
+    mBenchmarkTrackFile = track;
+    mBenchmarkOutputFile = output;
+    mBenchmarkTimeStep = timeStep;
+    if (!track.empty())
+        mSkipMenu = true;
+}
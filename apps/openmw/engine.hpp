@@ -135,6 +135,9 @@ namespace Misc
 
 namespace OMW
 {
+    class BenchmarkRunner;
+    class BenchmarkRecorder;
+
     /// \brief Main engine class, that brings together all the components of OpenMW
     class Engine
     {
@@ -199,6 +202,13 @@ namespace OMW
         Files::ConfigurationManager& mCfgMgr;
         int mGlMaxTextureImageUnits;
         bool mMainLoopShutdownCompleted = false;
+        std::filesystem::path mBenchmarkTrackFile;
+        std::filesystem::path mBenchmarkOutputFile;
+        std::filesystem::path mBenchmarkRecordFile;
+        float mBenchmarkTimeStep = 1.0f / 60.0f;
+        bool mHiddenWindow = false;
+        std::unique_ptr<BenchmarkRunner> mBenchmarkRunner;
+        std::unique_ptr<BenchmarkRecorder> mBenchmarkRecorder;
 #ifdef __EMSCRIPTEN__
         MWWorld::DateTimeManager* mWasmTimeManager = nullptr;
         std::unique_ptr<Misc::FrameRateLimiter> mWasmFrameRateLimiter;
@@ -291,6 +301,17 @@ namespace OMW
         void setRandomSeed(unsigned int seed);
 
         void setRecastMaxLogLevel(Debug::Level value) { mMaxRecastLogLevel = value; }
+
+        /// Replay the benchmark track with a fixed time step, write the result and quit.
+        ///
+        /// \param output Result file, benchmark.json in the user data directory when empty.
+        void setBenchmark(const std::filesystem::path& track, const std::filesystem::path& output, float timeStep);
+
+        /// Record the player camera into a benchmark track while playing.
+        void setBenchmarkRecordFile(const std::filesystem::path& track) { mBenchmarkRecordFile = track; }
+
+        /// Create the window hidden, rendering still happens.
+        void setHiddenWindow(bool value) { mHiddenWindow = value; }
     };
 }
 
@@ -167,7 +167,23 @@ bool parseOptions(int argc, char** argv, OMW::Engine& engine, Files::Configurati
     engine.setSoundUsage(!variables["no-sound"].as<bool>());
     engine.setActivationDistanceOverride(variables["activate-dist"].as<int>());
     engine.enableFontExport(variables["export-fonts"].as<bool>());
-    engine.setRandomSeed(variables["random-seed"].as<unsigned int>());
+
+    // benchmark
+    const auto benchmark = variables["benchmark"].as<Files::MaybeQuotedPath>().u8string();
+    const float benchmarkTimeStep = variables["benchmark-time-step"].as<float>();
+    if (!benchmark.empty() && !(benchmarkTimeStep > 0))
+    {
+        Log(Debug::Error) << "benchmark-time-step has to be positive. Aborting...";
+        return false;
+    }
+    engine.setBenchmark(
+        benchmark, variables["benchmark-output"].as<Files::MaybeQuotedPath>().u8string(), benchmarkTimeStep);
+    engine.setBenchmarkRecordFile(variables["benchmark-record"].as<Files::MaybeQuotedPath>().u8string());
+    engine.setHiddenWindow(variables["hidden-window"].as<bool>());
+
+    // Benchmark runs have to be reproducible
+    const bpo::variable_value& randomSeed = variables["random-seed"];
+    engine.setRandomSeed(randomSeed.defaulted() && !benchmark.empty() ? 0 : randomSeed.as<unsigned int>());
 
     return true;
 }
@@ -77,6 +77,38 @@ namespace
         }
         return true;
     }
+
+    MWWorld::DialogueSpeaker makeDialogueSpeaker(const MWWorld::Ptr& actor)
+    {
+        MWWorld::DialogueSpeaker result;
+        result.mId = actor.getCellRef().getRefId();
+        result.mIsCreature = actor.getType() != ESM::NPC::sRecordId;
+        if (!result.mIsCreature)
+        {
+            const ESM::NPC& npc = *actor.get<ESM::NPC>()->mBase;
+            result.mRace = npc.mRace;
+            result.mClass = npc.mClass;
+            result.mPrimaryFaction = actor.getClass().getPrimaryFaction(actor);
+            result.mIsFemale = (npc.mFlags & ESM::NPC::Female) != 0;
+        }
+        return result;
+    }
+
+    // Visits INFOs in the dialogue order skipping those which can't be said by the speaker when possible
+    template <class Visitor>
+    void visitInfos(const ESM::Dialogue& dialogue, const MWWorld::DialogueSpeaker& speaker, Visitor&& visitor)
+    {
+        const MWWorld::DialogueInfoIndex* index
+            = MWBase::Environment::get().getESMStore()->get<ESM::Dialogue>().searchInfoIndex(dialogue);
+        if (index != nullptr)
+        {
+            index->visitCandidates(speaker, visitor);
+            return;
+        }
+        for (const ESM::DialInfo& info : dialogue.mInfo)
+            if (!visitor(info))
+                return;
+    }
 }
 
 bool MWDialogue::Filter::testActor(const ESM::DialInfo& info) const
@@ -741,21 +773,22 @@ std::vector<MWDialogue::Filter::Response> MWDialogue::Filter::list(
 
     bool infoRefusal = false;
 
+    const MWWorld::DialogueSpeaker speaker = makeDialogueSpeaker(mActor);
+
     // Iterate over topic responses to find a matching one
-    for (const auto& info : dialogue.mInfo)
-    {
+    visitInfos(dialogue, speaker, [&](const ESM::DialInfo& info) {
         if (testActor(info) && testPlayer(info) && testSelectStructs(info))
         {
             if (testDisposition(info, invertDisposition))
             {
                 infos.emplace_back(&dialogue, &info);
-                if (!searchAll)
-                    break;
+                return searchAll;
             }
             else
                 infoRefusal = true;
         }
-    }
+        return true;
+    });
 
     if (infos.empty() && infoRefusal && fallbackToInfoRefusal)
     {
@@ -766,14 +799,15 @@ std::vector<MWDialogue::Filter::Response> MWDialogue::Filter::list(
 
         const ESM::Dialogue& infoRefusalDialogue = *dialogues.find(ESM::RefId::stringRefId("Info Refusal"));
 
-        for (const auto& info : infoRefusalDialogue.mInfo)
+        visitInfos(infoRefusalDialogue, speaker, [&](const ESM::DialInfo& info) {
             if (testActor(info) && testPlayer(info) && testSelectStructs(info)
                 && testDisposition(info, invertDisposition))
             {
                 infos.emplace_back(&infoRefusalDialogue, &info);
-                if (!searchAll)
-                    break;
+                return searchAll;
             }
+            return true;
+        });
     }
 
     return infos;
@@ -308,6 +308,7 @@ namespace MWGui
 
         if (useShaders)
             mGuiPlatform->getRenderManagerPtr()->enableShaders(mResourceSystem->getSceneManager()->getShaderManager());
+        mGuiPlatform->getRenderManagerPtr()->setTextureAtlasEnabled(Settings::gui().mTextureAtlas);
 
         mStatsWatcher = std::make_unique<StatsWatcher>();
     }
@@ -14,6 +14,7 @@
 #include <components/resource/scenemanager.hpp>
 #include <components/shader/shadermanager.hpp>
 
+#include <components/debug/tracing.hpp>
 #include <components/lua/luastate.hpp>
 
 namespace MWLua
@@ -57,6 +58,10 @@ namespace MWLua
 
         api["reloadLua"] = []() { MWBase::Environment::get().getLuaManager()->reloadAllScripts(); };
 
+        api["isTracingEnabled"] = []() { return Debug::Tracing::isEnabled(); };
+        api["setTracingEnabled"] = [](bool value) { Debug::Tracing::setEnabled(value); };
+        api["dumpTrace"] = [context]() { context.mLuaManager->addAction([] { Debug::Tracing::dump(); }); };
+
         api["NAV_MESH_RENDER_MODE"]
             = LuaUtil::makeStrictReadOnly(LuaUtil::tableFromPairs<std::string_view, Settings::NavMeshRenderMode>(view,
                 {
@@ -15,6 +15,7 @@
 #include <osg/Stats>
 
 #include "components/debug/debuglog.hpp"
+#include "components/debug/tracing.hpp"
 #include "components/misc/convert.hpp"
 #include <components/misc/barrier.hpp>
 #include <components/settings/values.hpp>
@@ -522,6 +523,8 @@ namespace MWPhysics
     {
         assert(mSimulations != &simulations);
 
+        OPENMW_TRACE_ZONE("PhysicsTaskScheduler::applyQueuedMovements");
+
         waitForWorkers();
         prepareWork(timeAccum, simulations, frameStart, frameNumber, stats);
         if (mWorkersSync != nullptr)
@@ -759,6 +762,7 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::worker()
     {
+        Debug::Tracing::setThreadName("PhysicsWorker");
         mWorkersSync->runWorker([this] {
             std::shared_lock lock(mSimulationMutex);
             doSimulation();
@@ -793,6 +797,8 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::doSimulation()
     {
+        OPENMW_TRACE_ZONE("PhysicsTaskScheduler::doSimulation");
+
         while (mRemainingSteps)
         {
 #if __cplusplus >= 202002L
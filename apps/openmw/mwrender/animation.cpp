@@ -600,6 +600,13 @@ namespace MWRender
             mSkeleton->setActive(static_cast<SceneUtil::Skeleton::ActiveType>(active));
     }
 
+    void Animation::setSkeletonLodSettings(const SceneUtil::Skeleton::LodSettings& settings)
+    {
+        mSkeletonLodSettings = settings;
+        if (mSkeleton)
+            mSkeleton->setLodSettings(mSkeletonLodSettings);
+    }
+
     void Animation::updatePtr(const MWWorld::Ptr& ptr)
     {
         mPtr = ptr;
@@ -1654,6 +1661,9 @@ namespace MWRender
             mInsert->addChild(mObjectRoot);
         }
 
+        if (mSkeleton)
+            mSkeleton->setLodSettings(mSkeletonLodSettings);
+
         // osgAnimation formats with skeletons should have their nodemap be bone instances
         // FIXME: better way to detect osgAnimation here instead of relying on extension?
         mRequiresBoneMap = mSkeleton != nullptr && !Misc::StringUtils::ciEndsWith(model, ".nif");
@@ -13,6 +13,7 @@
 #include <components/sceneutil/animblendrules.hpp>
 #include <components/sceneutil/controller.hpp>
 #include <components/sceneutil/nodecallback.hpp>
+#include <components/sceneutil/skeleton.hpp>
 #include <components/sceneutil/textkeymap.hpp>
 #include <components/sceneutil/util.hpp>
 #include <components/vfs/pathutil.hpp>
@@ -41,7 +42,6 @@ namespace SceneUtil
     class KeyframeController;
     class LightSource;
     class LightListCallback;
-    class Skeleton;
     struct LightCommon;
 }
 
@@ -187,6 +187,7 @@ namespace MWRender
 
         osg::ref_ptr<osg::Group> mObjectRoot;
         SceneUtil::Skeleton* mSkeleton;
+        SceneUtil::Skeleton::LodSettings mSkeletonLodSettings;
 
         // The node expected to accumulate movement during movement animations.
         osg::ref_ptr<osg::Node> mAccumRoot;
@@ -331,6 +332,10 @@ namespace MWRender
         /// 0 = Inactive, 1 = Active in place, 2 = Active
         void setActive(int active);
 
+        /// Set the update rate LOD of the object skeleton, kept when the object root is rebuilt.
+        /// @see SceneUtil::Skeleton::setLodSettings
+        void setSkeletonLodSettings(const SceneUtil::Skeleton::LodSettings& settings);
+
         osg::Group* getOrCreateObjectRoot();
 
         osg::Group* getObjectRoot();
@@ -36,6 +36,7 @@
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/riggeometryosgaextension.hpp>
+#include <components/sceneutil/uploadscheduler.hpp>
 #include <components/sceneutil/util.hpp>
 #include <components/settings/values.hpp>
 #include <components/vfs/manager.hpp>
@@ -962,7 +963,7 @@ namespace MWRender
         {
             auto compileSet = new osgUtil::IncrementalCompileOperation::CompileSet(group);
             compileSet->buildCompileMap(ico->getContextSet(), stateToCompile);
-            ico->add(compileSet, false);
+            SceneUtil::addToCompile(*ico, compileSet, worldCenter);
         }
 
         group->getBound();
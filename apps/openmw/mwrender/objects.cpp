@@ -7,6 +7,7 @@
 #include <components/misc/strings/algorithm.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/unrefqueue.hpp>
+#include <components/settings/values.hpp>
 
 #include "../mwworld/class.hpp"
 #include "../mwworld/ptr.hpp"
@@ -22,6 +23,19 @@
 
 namespace MWRender
 {
+    namespace
+    {
+        SceneUtil::Skeleton::LodSettings makeSkeletonLodSettings()
+        {
+            SceneUtil::Skeleton::LodSettings settings;
+            settings.mEnabled = Settings::camera().mAnimationLod;
+            settings.mHalfRatePixelSize = Settings::camera().mAnimationLodHalfRatePixelSize;
+            settings.mQuarterRatePixelSize = Settings::camera().mAnimationLodQuarterRatePixelSize;
+            settings.mHalfRateDistance = Settings::camera().mAnimationLodHalfRateDistance;
+            settings.mQuarterRateDistance = Settings::camera().mAnimationLodQuarterRateDistance;
+            return settings;
+        }
+    }
 
     Objects::Objects(Resource::ResourceSystem* resourceSystem, const osg::ref_ptr<osg::Group>& rootNode,
         SceneUtil::UnrefQueue& unrefQueue)
@@ -75,20 +89,25 @@ namespace MWRender
 
         // Diagnostics
         PerformanceToolkit::VisibilityTracker::attach(ptr.getRefData().getBaseNode());
+    }
 
-        // Phase 1: Occlusion
+    void Objects::insertEnd(const MWWorld::Ptr& ptr, bool occluder)
+    {
+        // Phase 1: Occlusion, the model has to be attached to the base node to be measured
+        osg::Group* baseNode = ptr.getRefData().getBaseNode();
         auto& scanner = PerformanceToolkit::Scanner::getInstance();
-        float score = scanner.scoreOccluderCandidate(ptr.getRefData().getBaseNode());
-        
-        auto audit = scanner.auditNode(ptr.getRefData().getBaseNode());
+        float score = scanner.scoreOccluderCandidate(baseNode);
 
-        if (score > 1000.0f) // Arbitrary threshold for "Big enough to be an occluder"
+        auto audit = scanner.auditNode(baseNode);
+
+        if (occluder && score > 1000.0f) // Arbitrary threshold for "Big enough to be an occluder"
         {
-            PerformanceToolkit::OcclusionSystem::getInstance().registerOccluder(ptr.getRefData().getBaseNode());
+            PerformanceToolkit::OcclusionSystem::getInstance().registerOccluder(baseNode);
         }
         else if (audit.drawCalls > 2 || audit.triangleCount > 5000) // Only occlude if it's "expensive"
         {
-            PerformanceToolkit::OcclusionSystem::getInstance().wrapOccludee(cellnode.get(), ptr.getRefData().getBaseNode(), audit.drawCalls);
+            PerformanceToolkit::OcclusionSystem::getInstance().wrapOccludee(
+                baseNode->getParent(0), baseNode, audit.drawCalls);
         }
     }
 
@@ -110,6 +129,8 @@ namespace MWRender
             new ObjectAnimation(ptr, animationMesh, mResourceSystem, animated, allowLight));
 
         mObjects.emplace(ptr.mRef, std::move(anim));
+
+        insertEnd(ptr, true);
     }
 
     void Objects::insertCreature(const MWWorld::Ptr& ptr, const std::string& mesh, bool weaponsShields)
@@ -131,8 +152,12 @@ namespace MWRender
         else
             anim = new CreatureAnimation(ptr, animationMesh, mResourceSystem, animated);
 
+        anim->setSkeletonLodSettings(makeSkeletonLodSettings());
+
         if (mObjects.emplace(ptr.mRef, anim).second)
             ptr.getClass().getContainerStore(ptr).setContListener(static_cast<ActorAnimation*>(anim.get()));
+
+        insertEnd(ptr, false);
     }
 
     void Objects::insertNPC(const MWWorld::Ptr& ptr)
@@ -144,12 +169,14 @@ namespace MWRender
         {
             osg::ref_ptr<ESM4NpcAnimation> anim(
                 new ESM4NpcAnimation(ptr, osg::ref_ptr<osg::Group>(ptr.getRefData().getBaseNode()), mResourceSystem));
+            anim->setSkeletonLodSettings(makeSkeletonLodSettings());
             mObjects.emplace(ptr.mRef, anim);
         }
         else
         {
             osg::ref_ptr<NpcAnimation> anim(
                 new NpcAnimation(ptr, osg::ref_ptr<osg::Group>(ptr.getRefData().getBaseNode()), mResourceSystem));
+            anim->setSkeletonLodSettings(makeSkeletonLodSettings());
 
             if (mObjects.emplace(ptr.mRef, anim).second)
             {
@@ -157,6 +184,8 @@ namespace MWRender
                 ptr.getClass().getInventoryStore(ptr).setContListener(anim.get());
             }
         }
+
+        insertEnd(ptr, false);
     }
 
     bool Objects::removeObject(const MWWorld::Ptr& ptr)
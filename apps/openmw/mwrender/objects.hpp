@@ -67,6 +67,9 @@ namespace MWRender
 
         void insertBegin(const MWWorld::Ptr& ptr);
 
+        /// Set up occlusion culling once the model is attached. Actors move and animate, so they are never occluders.
+        void insertEnd(const MWWorld::Ptr& ptr, bool occluder);
+
     public:
         Objects(Resource::ResourceSystem* resourceSystem, const osg::ref_ptr<osg::Group>& rootNode,
             SceneUtil::UnrefQueue& unrefQueue);
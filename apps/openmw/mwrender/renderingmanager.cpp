@@ -18,6 +18,7 @@
 #include <osgViewer/Viewer>
 
 #include <components/nifosg/nifloader.hpp>
+#include <components/nifosg/particle.hpp>
 
 #include <components/debug/debuglog.hpp>
 
@@ -39,7 +40,9 @@
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
+#include <components/sceneutil/skeleton.hpp>
 #include <components/sceneutil/statesetupdater.hpp>
+#include <components/sceneutil/uploadscheduler.hpp>
 #include <components/sceneutil/visitor.hpp>
 #include <components/sceneutil/workqueue.hpp>
 #include <components/sceneutil/writescene.hpp>
@@ -50,6 +53,7 @@
 
 #include <components/misc/constants.hpp>
 
+#include <components/terrain/compositemapcache.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 #include <components/terrain/terraingrid.hpp>
 
@@ -91,6 +95,8 @@
 #include "vismask.hpp"
 #include "water.hpp"
 
+#include "../../performance_toolkit/occlusion/occlusion_system.hpp"
+
 namespace MWRender
 {
     class PerViewUniformStateUpdater final : public SceneUtil::StateSetUpdater
@@ -315,7 +321,7 @@ namespace MWRender
     RenderingManager::RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
         Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
         DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore,
-        SceneUtil::UnrefQueue& unrefQueue)
+        SceneUtil::UnrefQueue& unrefQueue, const std::filesystem::path& userDataPath)
         : mSkyBlending(Settings::fog().mSkyBlending)
         , mViewer(viewer)
         , mRootNode(rootNode)
@@ -485,11 +491,18 @@ namespace MWRender
         mPathgrid = std::make_unique<Pathgrid>(mRootNode);
 
         mObjects = std::make_unique<Objects>(mResourceSystem, sceneRoot, unrefQueue);
+        PerformanceToolkit::OcclusionSystem::getInstance().setJobSystem(mWorkQueue->getJobSystem());
+        PerformanceToolkit::OcclusionSystem::getInstance().setBackend(Settings::camera().mSoftwareOcclusionCulling
+                ? PerformanceToolkit::OcclusionBackend::Software
+                : PerformanceToolkit::OcclusionBackend::HardwareQueries);
 
         if (getenv("OPENMW_DONT_PRECOMPILE") == nullptr)
         {
-            mViewer->setIncrementalCompileOperation(new osgUtil::IncrementalCompileOperation);
-            mViewer->getIncrementalCompileOperation()->setTargetFrameRate(Settings::cells().mTargetFramerate);
+            mUploadScheduler = new SceneUtil::UploadScheduler;
+            mUploadScheduler->setTargetFrameRate(Settings::cells().mTargetFramerate);
+            mUploadScheduler->setMaxBytesPerFrame(Settings::cells().mUploadBytesPerFrame);
+            mUploadScheduler->setMaxTimePerFrame(Settings::cells().mUploadTimePerFrame / 1000.0);
+            mViewer->setIncrementalCompileOperation(mUploadScheduler);
         }
 
         mDebugDraw = new Debug::DebugDrawer(mResourceSystem->getSceneManager()->getShaderManager());
@@ -509,6 +522,10 @@ namespace MWRender
         mTerrainStorage = std::make_unique<TerrainStorage>(mResourceSystem, normalMapPattern, heightMapPattern,
             useTerrainNormalMaps, specularMapPattern, useTerrainSpecularMaps);
 
+        if (Settings::terrain().mCompositeMapCache)
+            mCompositeMapCache
+                = std::make_unique<Terrain::CompositeMapCache>(userDataPath / "compositemaps", mWorkQueue.get());
+
         WorldspaceChunkMgr& chunkMgr = getWorldspaceChunkMgr(ESM::Cell::sDefaultWorldspaceId);
         mTerrain = chunkMgr.mTerrain.get();
         mGroundcover = chunkMgr.mGroundcover.get();
@@ -600,6 +617,17 @@ namespace MWRender
         NifOsg::Loader::setHiddenNodeMask(Mask_UpdateVisitor);
         NifOsg::Loader::setIntersectionDisabledNodeMask(Mask_Effect);
         NifOsg::Loader::setSoftEffectEnabled(Settings::shaders().mSoftParticles);
+
+        NifOsg::ParticleSystem::LodSettings particleLodSettings;
+        particleLodSettings.mEnabled = Settings::camera().mParticleLod;
+        particleLodSettings.mFullDetailPixelSize = Settings::camera().mParticleLodFullDetailPixelSize;
+        particleLodSettings.mFullDetailDistance = Settings::camera().mParticleLodFullDetailDistance;
+        particleLodSettings.mOffscreenInterval
+            = static_cast<unsigned int>(Settings::camera().mParticleLodOffscreenInterval.get());
+        particleLodSettings.mBudget = Settings::camera().mParticleBudget;
+        NifOsg::ParticleSystem::setLodSettings(particleLodSettings);
+        NifOsg::ParticleProgram::setBatchedOperators(Settings::shaders().mBatchedParticleAffectors);
+
         Nif::Reader::setLoadUnsupportedFiles(Settings::models().mLoadUnsupportedNifFiles);
 
         mStateUpdater->setFogEnd(mViewDistance);
@@ -629,6 +657,7 @@ namespace MWRender
 
     RenderingManager::~RenderingManager()
     {
+        PerformanceToolkit::OcclusionSystem::getInstance().setJobSystem(nullptr);
         // let background loading thread finish before we delete anything else
         mWorkQueue = nullptr;
     }
@@ -941,6 +970,8 @@ namespace MWRender
             updateProjectionMatrix();
         }
         mCamera->update(dt, paused);
+        if (mUploadScheduler != nullptr)
+            mUploadScheduler->setViewPoint(mCamera->getPosition());
 
         bool isUnderwater = mWater->isUnderwater(mCamera->getPosition());
 
@@ -1516,6 +1547,9 @@ namespace MWRender
                 mTerrainStorage.get(), Mask_Terrain, worldspace, expiryDelay, Mask_PreCompile, Mask_Debug);
 
         newChunkMgr.mTerrain->setTargetFrameRate(Settings::cells().mTargetFramerate);
+        newChunkMgr.mTerrain->setCompactVertices(Settings::terrain().mCompactVertices
+            && !(Settings::shadows().mEnableShadows && Settings::shadows().mTerrainShadows));
+        newChunkMgr.mTerrain->setCompositeMapCache(mCompositeMapCache.get());
         float distanceMult = std::cos(osg::DegreesToRadians(std::min(mFieldOfView, 140.f)) / 2.f);
         newChunkMgr.mTerrain->setViewDistance(mViewDistance * (distanceMult ? 1.f / distanceMult : 1.f));
         newChunkMgr.mTerrain->enableHeightCullCallback(Settings::terrain().mWaterCulling);
@@ -1530,6 +1564,20 @@ namespace MWRender
         if (stats->collectStats("resource"))
         {
             mTerrain->reportStats(frameNumber, stats);
+
+            const SceneUtil::Skeleton::LodStats animationLod = SceneUtil::Skeleton::getLodStats(frameNumber);
+            stats->setAttribute(frameNumber, "Animation FullRate", static_cast<double>(animationLod.mFullRate));
+            stats->setAttribute(frameNumber, "Animation HalfRate", static_cast<double>(animationLod.mHalfRate));
+            stats->setAttribute(frameNumber, "Animation QuarterRate", static_cast<double>(animationLod.mQuarterRate));
+            stats->setAttribute(frameNumber, "Animation Offscreen", static_cast<double>(animationLod.mOffscreen));
+
+            const NifOsg::ParticleSystem::LodStats particleLod = NifOsg::ParticleSystem::getLodStats(frameNumber);
+            stats->setAttribute(frameNumber, "Particle Visible", static_cast<double>(particleLod.mVisible));
+            stats->setAttribute(frameNumber, "Particle Offscreen", static_cast<double>(particleLod.mOffscreen));
+            stats->setAttribute(frameNumber, "Particle OverBudget", static_cast<double>(particleLod.mOverBudget));
+            stats->setAttribute(frameNumber, "Particle Count", static_cast<double>(particleLod.mParticles));
+
+            mWater->reportStats(frameNumber, *stats);
         }
     }
 
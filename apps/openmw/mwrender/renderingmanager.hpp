@@ -14,6 +14,7 @@
 #include <osgUtil/IncrementalCompileOperation>
 
 #include <deque>
+#include <filesystem>
 #include <memory>
 #include <span>
 #include <unordered_map>
@@ -50,6 +51,7 @@ namespace ESM
 namespace Terrain
 {
     class World;
+    class CompositeMapCache;
 }
 
 namespace Fallback
@@ -62,6 +64,7 @@ namespace SceneUtil
     class ShadowManager;
     class WorkQueue;
     class LightManager;
+    class UploadScheduler;
     class UnrefQueue;
 }
 
@@ -113,7 +116,7 @@ namespace MWRender
         RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
             Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
             DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore,
-            SceneUtil::UnrefQueue& unrefQueue);
+            SceneUtil::UnrefQueue& unrefQueue, const std::filesystem::path& userDataPath);
         ~RenderingManager();
 
         osgUtil::IncrementalCompileOperation* getIncrementalCompileOperation();
@@ -312,6 +315,7 @@ namespace MWRender
         Resource::ResourceSystem* mResourceSystem;
 
         osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        osg::ref_ptr<SceneUtil::UploadScheduler> mUploadScheduler;
 
         osg::ref_ptr<osg::Light> mSunLight;
 
@@ -323,6 +327,7 @@ namespace MWRender
         std::unique_ptr<Pathgrid> mPathgrid;
         std::unique_ptr<Objects> mObjects;
         std::unique_ptr<Water> mWater;
+        std::unique_ptr<Terrain::CompositeMapCache> mCompositeMapCache;
         std::unordered_map<ESM::RefId, WorldspaceChunkMgr> mWorldspaceChunks;
         Terrain::World* mTerrain;
         std::unique_ptr<TerrainStorage> mTerrainStorage;
@@ -1,5 +1,6 @@
 #include "water.hpp"
 
+#include <mutex>
 #include <sstream>
 
 #include <osg/ClipNode>
@@ -10,10 +11,12 @@
 #include <osg/Group>
 #include <osg/Material>
 #include <osg/PositionAttitudeTransform>
+#include <osg/Stats>
 #include <osg/ViewportIndexed>
 
 #include <osgUtil/CullVisitor>
 #include <osgUtil/IncrementalCompileOperation>
+#include <osgUtil/RenderStage>
 
 #include <components/resource/imagemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
@@ -59,8 +62,10 @@ namespace MWRender
         {
         public:
             /// @param cullPlane The culling plane (in world space).
-            PlaneCullCallback(const osg::Plane* cullPlane)
+            /// @param cullDistance Distance along the view direction beyond which everything is culled, 0 for no limit.
+            PlaneCullCallback(const osg::Plane* cullPlane, const float* cullDistance)
                 : mCullPlane(cullPlane)
+                , mCullDistance(cullDistance)
             {
             }
 
@@ -78,6 +83,10 @@ namespace MWRender
 
                 cv->getProjectionCullingStack().back().getFrustum().add(plane);
 
+                // in eye space, keeps z >= -distance
+                if (*mCullDistance > 0)
+                    cv->getProjectionCullingStack().back().getFrustum().add(osg::Plane(0, 0, 1, *mCullDistance));
+
                 traverse(node, cv);
 
                 // undo
@@ -86,6 +95,7 @@ namespace MWRender
 
         private:
             const osg::Plane* mCullPlane;
+            const float* mCullDistance;
         };
 
         class FlipCallback : public SceneUtil::NodeCallback<FlipCallback, osg::Node*, osgUtil::CullVisitor*>
@@ -133,7 +143,7 @@ namespace MWRender
     public:
         ClipCullNode()
         {
-            addCullCallback(new PlaneCullCallback(&mPlane));
+            addCullCallback(new PlaneCullCallback(&mPlane, &mCullDistance));
 
             mClipNodeTransform = new osg::Group;
             mClipNodeTransform->addCullCallback(new FlipCallback(&mPlane));
@@ -157,11 +167,15 @@ namespace MWRender
             mClipNode->setCullingActive(false);
         }
 
+        /// Cull everything further than the distance along the view direction, 0 for no limit.
+        void setCullDistance(float distance) { mCullDistance = distance; }
+
     private:
         osg::ref_ptr<osg::Group> mClipNodeTransform;
         osg::ref_ptr<osg::ClipNode> mClipNode;
 
         osg::Plane mPlane;
+        float mCullDistance = 0;
     };
 
     /// This callback on the Camera has the effect of a RELATIVE_RF_INHERIT_VIEWPOINT transform mode (which does not
@@ -181,6 +195,53 @@ namespace MWRender
         }
     };
 
+    /// Counts the drawables culled for the camera this callback is attached to, must be added as its last cull
+    /// callback.
+    class CountDrawablesCallback
+        : public SceneUtil::NodeCallback<CountDrawablesCallback, osg::Node*, osgUtil::CullVisitor*>
+    {
+    public:
+        void operator()(osg::Node* node, osgUtil::CullVisitor* cv)
+        {
+            traverse(node, cv);
+
+            const unsigned int frameNumber = cv->getFrameStamp()->getFrameNumber();
+            const std::size_t count = countLeaves(*cv->getCurrentRenderBin()->getStage());
+
+            const std::lock_guard lock(mMutex);
+            if (mFrameNumber != frameNumber)
+            {
+                mFrameNumber = frameNumber;
+                mLastCount = mCount;
+                mCount = 0;
+            }
+            mCount += count;
+        }
+
+        /// Number of drawables of the last fully culled frame.
+        std::size_t getLastCount() const
+        {
+            const std::lock_guard lock(mMutex);
+            return mLastCount;
+        }
+
+    private:
+        mutable std::mutex mMutex;
+        unsigned int mFrameNumber = 0;
+        std::size_t mCount = 0;
+        std::size_t mLastCount = 0;
+
+        static std::size_t countLeaves(const osgUtil::RenderBin& bin)
+        {
+            std::size_t count = bin.getRenderLeafList().size();
+            for (const osgUtil::StateGraph* graph : bin.getStateGraphList())
+                count += graph->_leaves.size();
+            for (const auto& [number, child] : bin.getRenderBinList())
+                count += countLeaves(*child);
+            return count;
+        }
+    };
+
     /// Moves water mesh away from the camera slightly if the camera gets too close on the Z axis.
     /// The offset works around graphics artifacts that occurred with the GL_DEPTH_CLAMP when the camera gets extremely
     /// close to the mesh (seen on NVIDIA at least). Must be added as a Cull callback.
@@ -323,14 +384,18 @@ namespace MWRender
             setInterior(isInterior);
             setDepthBufferInternalFormat(GL_DEPTH24_STENCIL8);
             mClipCullNode = new ClipCullNode;
+            mClipCullNode->setCullDistance(Settings::water().mReflectionDistance);
+            mCountDrawablesCallback = new CountDrawablesCallback;
         }
 
         void setDefaults(osg::Camera* camera) override
         {
             camera->setReferenceFrame(osg::Camera::RELATIVE_RF);
             camera->setSmallFeatureCullingPixelSize(Settings::water().mSmallFeatureCullingPixelSize);
+            camera->setLODScale(Settings::water().mReflectionLodScale);
             camera->setName("ReflectionCamera");
             camera->addCullCallback(new InheritViewPointCallback);
+            camera->addCullCallback(mCountDrawablesCallback);
 
             // Inform the shader that we're in a reflection
             camera->getOrCreateStateSet()->addUniform(new osg::Uniform("isReflection", true));
@@ -380,6 +445,8 @@ namespace MWRender
                 mNodeMask = calcNodeMask() & ~sToggleWorldMask;
         }
 
+        std::size_t getNumDrawables() const { return mCountDrawablesCallback->getLastCount(); }
+
     private:
         unsigned int calcNodeMask()
         {
@@ -400,6 +467,7 @@ namespace MWRender
         }
 
         osg::ref_ptr<ClipCullNode> mClipCullNode;
+        osg::ref_ptr<CountDrawablesCallback> mCountDrawablesCallback;
         osg::ref_ptr<osg::Node> mScene;
         osg::Node::NodeMask mNodeMask;
         osg::Matrix mViewMatrix{ osg::Matrix::identity() };
@@ -720,6 +788,12 @@ namespace MWRender
         updateWaterMaterial();
     }
 
+    void Water::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        const std::size_t drawables = mReflection != nullptr ? mReflection->getNumDrawables() : 0;
+        stats.setAttribute(frameNumber, "Water Reflection Drawables", static_cast<double>(drawables));
+    }
+
     Water::~Water()
     {
         mParent->removeChild(mWaterNode);
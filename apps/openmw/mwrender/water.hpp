@@ -18,6 +18,7 @@ namespace osg
     class Geometry;
     class Node;
     class Callback;
+    class Stats;
 }
 
 namespace osgUtil
@@ -121,6 +122,8 @@ namespace MWRender
 
         void processChangedSettings(const Settings::CategorySettingVector& settings);
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         void showWorld(bool show);
     };
 
@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <atomic>
 #include <limits>
+#include <mutex>
 #include <span>
+#include <vector>
 
 #include <osg/Stats>
 
@@ -11,6 +13,7 @@
 #include <components/esm3/loadcell.hpp>
 #include <components/loadinglistener/reporter.hpp>
 #include <components/misc/constants.hpp>
+#include <components/misc/jobsystem.hpp>
 #include <components/misc/pathhelpers.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/algorithm.hpp>
@@ -48,6 +51,15 @@ namespace MWWorld
             const auto predicate = [&](const PositionCellGrid& v) { return contains(container, v, tolerance); };
             return std::ranges::all_of(contained, predicate);
         }
+
+        // Number of meshes converted by a single job when a cell meshes are preloaded in parallel
+        constexpr std::size_t meshesPerJob = 4;
+
+        VFS::Path::Normalized getMeshPath(std::string_view model, const VFS::Manager& vfs)
+        {
+            const VFS::Path::Normalized mesh = Misc::ResourceHelpers::correctMeshPath(VFS::Path::Normalized(model));
+            return Misc::ResourceHelpers::correctActorModelPath(mesh, &vfs);
+        }
     }
 
     struct ListModelsVisitor
@@ -69,7 +81,8 @@ namespace MWWorld
         /// Constructor to be called from the main thread.
         explicit PreloadItem(MWWorld::CellStore* cell, Resource::SceneManager* sceneManager,
             Resource::BulletShapeManager* bulletShapeManager, Resource::KeyframeManager* keyframeManager,
-            Terrain::World* terrain, MWRender::LandManager* landManager, bool preloadInstances)
+            Terrain::World* terrain, MWRender::LandManager* landManager, Misc::JobSystem* jobSystem,
+            bool preloadInstances)
             : mIsExterior(cell->getCell()->isExterior())
             , mCellLocation(cell->getCell()->getExteriorCellLocation())
             , mCellId(cell->getCell()->getId())
@@ -78,6 +91,7 @@ namespace MWWorld
             , mKeyframeManager(keyframeManager)
             , mTerrain(terrain)
             , mLandManager(landManager)
+            , mJobSystem(jobSystem)
             , mPreloadInstances(preloadInstances)
             , mAbort(false)
         {
@@ -106,47 +120,59 @@ namespace MWWorld
                 }
             }
 
-            VFS::Path::Normalized mesh;
-            VFS::Path::Normalized kfname;
-            for (std::string_view path : mMeshes)
-            {
-                if (mAbort)
-                    break;
-
-                try
+            // Meshes of the same cell are converted concurrently by the worker threads
+            const auto preloadMeshes = [&](std::size_t begin, std::size_t end) {
+                std::vector<osg::ref_ptr<const osg::Object>> preloaded;
+                for (std::string_view path : std::span(mMeshes).subspan(begin, end - begin))
                 {
-                    const VFS::Manager& vfs = *mSceneManager->getVFS();
-                    mesh = Misc::ResourceHelpers::correctMeshPath(VFS::Path::Normalized(path));
-                    mesh = Misc::ResourceHelpers::correctActorModelPath(mesh, &vfs);
-
-                    if (!vfs.exists(mesh))
-                        continue;
-
-                    constexpr VFS::Path::ExtensionView nif("nif");
-                    if (Misc::getFileName(mesh).starts_with('x') && mesh.extension() == nif)
-                    {
-                        kfname = mesh;
-                        constexpr VFS::Path::ExtensionView kf("kf");
-                        kfname.changeExtension(kf);
-                        if (vfs.exists(kfname))
-                            mPreloadedObjects.insert(mKeyframeManager->get(kfname));
-                    }
-
-                    mPreloadedObjects.insert(mSceneManager->getTemplate(mesh));
-                    if (mPreloadInstances)
-                        mPreloadedObjects.insert(mBulletShapeManager->cacheInstance(mesh));
-                    else
-                        mPreloadedObjects.insert(mBulletShapeManager->getShape(mesh));
+                    if (mAbort)
+                        break;
+                    preloadMesh(path, preloaded);
                 }
-                catch (const std::exception& e)
+                const std::lock_guard lock(mPreloadedObjectsMutex);
+                mPreloadedObjects.insert(preloaded.begin(), preloaded.end());
+            };
+
+            if (mJobSystem != nullptr)
+                mJobSystem->parallelFor(0, mMeshes.size(), meshesPerJob, preloadMeshes);
+            else
+                preloadMeshes(0, mMeshes.size());
+        }
+
+    private:
+        void preloadMesh(std::string_view path, std::vector<osg::ref_ptr<const osg::Object>>& preloaded)
+        {
+            try
+            {
+                const VFS::Manager& vfs = *mSceneManager->getVFS();
+                const VFS::Path::Normalized mesh = getMeshPath(path, vfs);
+
+                if (!vfs.exists(mesh))
+                    return;
+
+                constexpr VFS::Path::ExtensionView nif("nif");
+                if (Misc::getFileName(mesh).starts_with('x') && mesh.extension() == nif)
                 {
-                    Log(Debug::Warning) << "Failed to preload mesh \"" << path << "\" from cell " << mCellId << ": "
-                                        << e.what();
+                    VFS::Path::Normalized kfname = mesh;
+                    constexpr VFS::Path::ExtensionView kf("kf");
+                    kfname.changeExtension(kf);
+                    if (vfs.exists(kfname))
+                        preloaded.emplace_back(mKeyframeManager->get(kfname));
                 }
+
+                preloaded.emplace_back(mSceneManager->getTemplate(mesh));
+                if (mPreloadInstances)
+                    preloaded.emplace_back(mBulletShapeManager->cacheInstance(mesh));
+                else
+                    preloaded.emplace_back(mBulletShapeManager->getShape(mesh));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to preload mesh \"" << path << "\" from cell " << mCellId << ": "
+                                    << e.what();
             }
         }
 
-    private:
         bool mIsExterior;
         ESM::ExteriorCellLocation mCellLocation;
         ESM::RefId mCellId;
@@ -156,6 +182,7 @@ namespace MWWorld
         Resource::KeyframeManager* mKeyframeManager;
         Terrain::World* mTerrain;
         MWRender::LandManager* mLandManager;
+        Misc::JobSystem* mJobSystem;
         bool mPreloadInstances;
 
         std::atomic<bool> mAbort;
@@ -163,6 +190,7 @@ namespace MWWorld
         osg::ref_ptr<Terrain::View> mTerrainView;
 
         // keep a ref to the loaded objects to make sure it stays loaded as long as this cell is in the preloaded state
+        std::mutex mPreloadedObjectsMutex;
         std::set<osg::ref_ptr<const osg::Object>> mPreloadedObjects;
     };
 
@@ -283,13 +311,33 @@ namespace MWWorld
         }
 
         osg::ref_ptr<PreloadItem> item(new PreloadItem(&cell, mResourceSystem->getSceneManager(), mBulletShapeManager,
-            mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
+            mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mWorkQueue->getJobSystem(),
+            mPreloadInstances));
         mWorkQueue->addWorkItem(item);
 
         mPreloadCells.emplace(&cell, PreloadEntry(timestamp, item));
         ++mAdded;
     }
 
+    void CellPreloader::preloadTemplates(const CellStore& cell, Misc::JobPriority priority)
+    {
+        std::vector<std::string_view> models;
+        ListModelsVisitor visitor{ models };
+        cell.forEachConst(visitor);
+
+        std::sort(models.begin(), models.end());
+        models.erase(std::unique(models.begin(), models.end()), models.end());
+
+        Resource::SceneManager& sceneManager = *mResourceSystem->getSceneManager();
+        const VFS::Manager& vfs = *sceneManager.getVFS();
+        for (std::string_view model : models)
+        {
+            const VFS::Path::Normalized mesh = getMeshPath(model, vfs);
+            if (vfs.exists(mesh))
+                sceneManager.getTemplateAsync(mesh, priority);
+        }
+    }
+
     void CellPreloader::notifyLoaded(CellStore* cell)
     {
         PreloadMap::iterator found = mPreloadCells.find(cell);
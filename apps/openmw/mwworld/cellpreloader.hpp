@@ -3,6 +3,7 @@
 
 #include "positioncellgrid.hpp"
 
+#include <components/misc/jobsystem.hpp>
 #include <components/sceneutil/workqueue.hpp>
 
 #include <osg/ref_ptr>
@@ -53,6 +54,11 @@ namespace MWWorld
         /// @note The cell itself must be in State_Loaded or State_Preloaded.
         void preload(MWWorld::CellStore& cell, double timestamp);
 
+        /// Ask the worker threads to convert the meshes of the cell which is about to be loaded. The loading thread
+        /// takes over the conversions which are not started when it needs them.
+        /// @note The cell must be in State_Loaded.
+        void preloadTemplates(const MWWorld::CellStore& cell, Misc::JobPriority priority);
+
         void notifyLoaded(MWWorld::CellStore* cell);
 
         void clear();
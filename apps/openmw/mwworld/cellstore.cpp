@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <fstream>
+#include <limits>
 
 #include <components/debug/debuglog.hpp>
 
@@ -408,7 +409,7 @@ namespace MWWorld
 
         if (const X* ptr = store.search(ref.mRefID))
         {
-            typename std::list<LiveRef>::iterator iter = std::find(mList.begin(), mList.end(), ref.mRefNum);
+            typename List::iterator iter = std::find(mList.begin(), mList.end(), ref.mRefNum);
 
             LiveRef liveCellRef(ref, ptr);
 
@@ -580,6 +581,46 @@ namespace MWWorld
         CellStoreImp::forEachInternal(visitor, const_cast<CellStore&>(*this), includeDeleted);
         visitor.merge();
         mMergedRefsNeedsUpdate = false;
+        mMergedRefsIndexNeedsUpdate = true;
+    }
+
+    LiveCellRefBase* CellStore::findMergedRef(const ESM::RefId& id) const
+    {
+        constexpr std::uint32_t noIndex = std::numeric_limits<std::uint32_t>::max();
+
+        if (mMergedRefsNeedsUpdate)
+            updateMergedRefs();
+
+        if (mMergedRefsIndexNeedsUpdate)
+        {
+            mMergedRefsIndex.clear();
+            mMergedRefsNextSameId.assign(mMergedRefs.size(), noIndex);
+            // Go backwards to keep the first ref with the given id at the head of the chain
+            for (std::size_t i = mMergedRefs.size(); i > 0; --i)
+            {
+                const std::uint32_t index = static_cast<std::uint32_t>(i - 1);
+                const auto [it, inserted] = mMergedRefsIndex.emplace(mMergedRefs[index]->mRef.getRefId(), index);
+                if (!inserted)
+                {
+                    mMergedRefsNextSameId[index] = it->second;
+                    it->second = index;
+                }
+            }
+            mMergedRefsIndexNeedsUpdate = false;
+        }
+
+        const auto it = mMergedRefsIndex.find(id);
+        if (it == mMergedRefsIndex.end())
+            return nullptr;
+
+        for (std::uint32_t index = it->second; index != noIndex; index = mMergedRefsNextSameId[index])
+        {
+            LiveCellRefBase* const ref = mMergedRefs[index];
+            if (isAccessible(ref->mData, ref->mRef))
+                return ref;
+        }
+
+        return nullptr;
     }
 
     bool CellStore::movedHere(const MWWorld::Ptr& ptr) const
@@ -641,38 +682,33 @@ namespace MWWorld
         return searchConst(id).isEmpty();
     }
 
-    template <typename PtrType>
-    struct SearchVisitor
-    {
-        PtrType mFound;
-        const ESM::RefId& mIdToFind;
-        SearchVisitor(const ESM::RefId& id)
-            : mIdToFind(id)
-        {
-        }
-        bool operator()(const PtrType& ptr)
-        {
-            if (ptr.getCellRef().getRefId() == mIdToFind)
-            {
-                mFound = ptr;
-                return false;
-            }
-            return true;
-        }
-    };
-
     Ptr CellStore::search(const ESM::RefId& id)
     {
-        SearchVisitor<MWWorld::Ptr> searchVisitor(id);
-        forEach(searchVisitor);
-        return searchVisitor.mFound;
+        if (mState != State_Loaded)
+            return Ptr();
+
+        LiveCellRefBase* const ref = findMergedRef(id);
+
+        if (!mMergedRefs.empty())
+            mHasState = true;
+
+        if (ref == nullptr)
+            return Ptr();
+
+        return Ptr(ref, this);
     }
 
     ConstPtr CellStore::searchConst(const ESM::RefId& id) const
     {
-        SearchVisitor<MWWorld::ConstPtr> searchVisitor(id);
-        forEachConst(searchVisitor);
-        return searchVisitor.mFound;
+        if (mState != State_Loaded)
+            return ConstPtr();
+
+        const LiveCellRefBase* const ref = findMergedRef(id);
+
+        if (ref == nullptr)
+            return ConstPtr();
+
+        return ConstPtr(ref, this);
     }
 
     class RefNumSearchVisitor
@@ -2,6 +2,7 @@
 #define GAME_MWWORLD_CELLSTORE_H
 
 #include <algorithm>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <stdexcept>
@@ -9,6 +10,7 @@
 #include <string_view>
 #include <tuple>
 #include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 #include "cell.hpp"
@@ -392,6 +394,13 @@ namespace MWWorld
         mutable std::vector<LiveCellRefBase*> mMergedRefs;
         mutable bool mMergedRefsNeedsUpdate = false;
 
+        // Index of mMergedRefs by RefId, built on the first search after mMergedRefs change. Maps the id to the
+        // position of the first ref with this id, positions of the following refs with the same id are chained in
+        // mMergedRefsNextSameId.
+        mutable std::unordered_map<ESM::RefId, std::uint32_t> mMergedRefsIndex;
+        mutable std::vector<std::uint32_t> mMergedRefsNextSameId;
+        mutable bool mMergedRefsIndexNeedsUpdate = true;
+
         // Get the Ptr for the given ref which originated from this cell (possibly moved to another cell at this point).
         Ptr getCurrentPtr(MWWorld::LiveCellRefBase* ref);
 
@@ -402,6 +411,9 @@ namespace MWWorld
         void requestMergedRefsUpdate();
         void updateMergedRefs(bool includeDeleted = false) const;
 
+        /// Find the first accessible merged ref with the given id using mMergedRefsIndex.
+        LiveCellRefBase* findMergedRef(const ESM::RefId& id) const;
+
         // (item, max charge)
         typedef std::vector<std::pair<LiveCellRefBase*, float>> TRechargingItems;
         TRechargingItems mRechargingItems;
@@ -0,0 +1,115 @@
+#include "contentsnapshot.hpp"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/files/openfile.hpp>
+#include <components/misc/strings/lower.hpp>
+#include <components/toutf8/toutf8.hpp>
+
+#include "esmstore.hpp"
+
+namespace MWWorld
+{
+    namespace
+    {
+        // Increment when the set of stored records or the way they are stored changes
+        constexpr std::uint32_t snapshotVersion = 1;
+
+        constexpr std::string_view snapshotAuthor = "OpenMW";
+
+        template <class T>
+        void writeValue(std::ostream& stream, const T& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
+
+    std::string makeContentSnapshotKey(std::span<const std::filesystem::path> files, ToUTF8::Utf8Encoder* encoder)
+    {
+        std::stringstream data;
+        writeValue(data, snapshotVersion);
+        writeValue(data, ESM::CurrentContentFormatVersion);
+        writeValue(data, ESM::CurrentSaveGameFormatVersion);
+
+        // Records are stored in UTF-8 so the result depends on the source encoding
+        if (encoder != nullptr)
+        {
+            std::string legacy;
+            for (int c = 0x80; c <= 0xff; ++c)
+                legacy.push_back(static_cast<char>(c));
+            data << encoder->getUtf8(legacy);
+        }
+
+        for (const std::filesystem::path& file : files)
+        {
+            const std::string fileName = Files::pathToUnicodeString(file);
+            auto stream = Files::openBinaryInputFileStream(file);
+            data << Misc::StringUtils::lowerCase(Files::pathToUnicodeString(file.filename())) << '\0';
+            writeValue(data, Files::getHash(fileName, *stream));
+        }
+
+        data.seekg(0);
+        const std::array<std::uint64_t, 2> hash = Files::getHash("content snapshot key", data);
+
+        std::ostringstream result;
+        result << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1];
+        return result.str();
+    }
+
+    bool hasContentSnapshot(const std::filesystem::path& path, std::string_view key)
+    {
+        if (!std::filesystem::exists(path))
+            return false;
+
+        try
+        {
+            ESM::ESMReader reader;
+            reader.open(path);
+            return reader.getAuthor() == snapshotAuthor && reader.getDesc() == key;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read content snapshot " << path << ": " << e.what();
+            return false;
+        }
+    }
+
+    void loadContentSnapshot(const std::filesystem::path& path, ESMStore& store, Loading::Listener* listener)
+    {
+        ESM::ESMReader reader;
+        reader.open(path);
+        ESM::Dialogue* dialogue = nullptr;
+        store.load(reader, listener, dialogue);
+    }
+
+    void saveContentSnapshot(const std::filesystem::path& path, std::string_view key, const ESMStore& store)
+    {
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+
+        {
+            std::ofstream stream(tmpPath, std::ios::binary);
+            stream.exceptions(std::ios::failbit | std::ios::badbit);
+
+            ESM::ESMWriter writer;
+            writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+            writer.setAuthor(snapshotAuthor);
+            writer.setDescription(key);
+            writer.save(stream);
+            store.writeSnapshot(writer);
+            writer.close();
+        }
+
+        std::filesystem::rename(tmpPath, path);
+    }
+}
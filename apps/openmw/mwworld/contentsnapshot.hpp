@@ -0,0 +1,37 @@
+#ifndef OPENMW_MWWORLD_CONTENTSNAPSHOT_H
+#define OPENMW_MWWORLD_CONTENTSNAPSHOT_H
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace Loading
+{
+    class Listener;
+}
+
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
+
+    /// Identifies the content of the content files in load order, the encoding and the format used to store them.
+    std::string makeContentSnapshotKey(std::span<const std::filesystem::path> files, ToUTF8::Utf8Encoder* encoder);
+
+    /// @return true if the snapshot file exists and was created for the same key.
+    bool hasContentSnapshot(const std::filesystem::path& path, std::string_view key);
+
+    /// Load the records written by saveContentSnapshot into the store.
+    void loadContentSnapshot(const std::filesystem::path& path, ESMStore& store, Loading::Listener* listener);
+
+    /// Save the records of the store which are loaded independently of the load state, see ESMStore::writeSnapshot.
+    /// Should be called after loading all content files and before ESMStore::setUp.
+    void saveContentSnapshot(const std::filesystem::path& path, std::string_view key, const ESMStore& store);
+}
+
+#endif
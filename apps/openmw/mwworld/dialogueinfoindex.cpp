@@ -0,0 +1,57 @@
+#include "dialogueinfoindex.hpp"
+
+#include <components/esm3/loaddial.hpp>
+#include <components/esm3/loadinfo.hpp>
+
+namespace MWWorld
+{
+    DialogueInfoIndex::DialogueInfoIndex(const ESM::Dialogue& dialogue)
+    {
+        std::uint32_t order = 0;
+        for (const ESM::DialInfo& info : dialogue.mInfo)
+        {
+            const Entry entry{
+                .mOrder = order++,
+                .mFactionLess = info.mFactionLess,
+                .mGender = info.mData.mGender,
+                .mClass = info.mClass,
+                .mFaction = info.mFaction,
+                .mInfo = &info,
+            };
+            if (!info.mActor.empty())
+                mByActor[info.mActor].push_back(entry);
+            else if (!info.mRace.empty())
+                mByRace[info.mRace].push_back(entry);
+            else
+                mAny.push_back(entry);
+        }
+    }
+
+    bool DialogueInfoIndex::matches(const Entry& entry, const DialogueSpeaker& speaker)
+    {
+        if (!entry.mClass.empty() && entry.mClass != speaker.mClass)
+            return false;
+
+        if (entry.mFactionLess)
+        {
+            if (!speaker.mPrimaryFaction.empty())
+                return false;
+        }
+        else if (!entry.mFaction.empty() && entry.mFaction != speaker.mPrimaryFaction)
+            return false;
+
+        if (entry.mGender == (speaker.mIsFemale ? ESM::DialInfo::Male : ESM::DialInfo::Female))
+            return false;
+
+        return true;
+    }
+
+    const DialogueInfoIndex::Entries* DialogueInfoIndex::find(
+        const std::unordered_map<ESM::RefId, Entries>& entries, const ESM::RefId& id)
+    {
+        const auto it = entries.find(id);
+        if (it == entries.end())
+            return nullptr;
+        return &it->second;
+    }
+}
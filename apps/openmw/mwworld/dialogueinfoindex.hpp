@@ -0,0 +1,112 @@
+#ifndef OPENMW_APPS_OPENMW_MWWORLD_DIALOGUEINFOINDEX_H
+#define OPENMW_APPS_OPENMW_MWWORLD_DIALOGUEINFOINDEX_H
+
+#include <components/esm/refid.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace ESM
+{
+    struct Dialogue;
+    struct DialInfo;
+}
+
+namespace MWWorld
+{
+    // Properties of the speaker which don't change during the game and are checked by INFO records
+    struct DialogueSpeaker
+    {
+        ESM::RefId mId;
+        bool mIsCreature = false;
+        ESM::RefId mRace;
+        ESM::RefId mClass;
+        ESM::RefId mPrimaryFaction;
+        bool mIsFemale = false;
+    };
+
+    /// \brief Dialogue INFOs partitioned by the speaker id and race.
+    ///
+    /// Allows to skip INFOs which can't be said by the speaker without evaluating their conditions.
+    class DialogueInfoIndex
+    {
+    public:
+        explicit DialogueInfoIndex(const ESM::Dialogue& dialogue);
+
+        /// Calls \a visitor for INFOs matching the speaker id, race, class, faction and sex in the dialogue order
+        /// until it returns false. Other conditions are left to the caller.
+        template <class Visitor>
+        void visitCandidates(const DialogueSpeaker& speaker, Visitor&& visitor) const;
+
+    private:
+        struct Entry
+        {
+            std::uint32_t mOrder;
+            bool mFactionLess;
+            signed char mGender;
+            ESM::RefId mClass;
+            ESM::RefId mFaction;
+            const ESM::DialInfo* mInfo;
+        };
+
+        using Entries = std::vector<Entry>;
+
+        // INFOs for a specific speaker
+        std::unordered_map<ESM::RefId, Entries> mByActor;
+        // INFOs for any speaker of a specific race
+        std::unordered_map<ESM::RefId, Entries> mByRace;
+        // INFOs for any NPC
+        Entries mAny;
+
+        static bool matches(const Entry& entry, const DialogueSpeaker& speaker);
+
+        static const Entries* find(const std::unordered_map<ESM::RefId, Entries>& entries, const ESM::RefId& id);
+    };
+
+    template <class Visitor>
+    void DialogueInfoIndex::visitCandidates(const DialogueSpeaker& speaker, Visitor&& visitor) const
+    {
+        const Entries* const byActor = find(mByActor, speaker.mId);
+
+        // Creatures can only say INFOs specific to their id
+        if (speaker.mIsCreature)
+        {
+            if (byActor != nullptr)
+                for (const Entry& entry : *byActor)
+                    if (!visitor(*entry.mInfo))
+                        return;
+            return;
+        }
+
+        static const Entries empty;
+        const Entries* const byRace = find(mByRace, speaker.mRace);
+        const Entries* const lists[] = { byActor != nullptr ? byActor : &empty,
+            byRace != nullptr ? byRace : &empty, &mAny };
+        std::size_t positions[] = { 0, 0, 0 };
+
+        // Merge sorted lists to preserve the order
+        while (true)
+        {
+            std::size_t next = std::size(lists);
+            std::uint32_t nextOrder = std::numeric_limits<std::uint32_t>::max();
+            for (std::size_t i = 0; i < std::size(lists); ++i)
+            {
+                if (positions[i] < lists[i]->size() && (*lists[i])[positions[i]].mOrder < nextOrder)
+                {
+                    next = i;
+                    nextOrder = (*lists[i])[positions[i]].mOrder;
+                }
+            }
+            if (next == std::size(lists))
+                return;
+            const Entry& entry = (*lists[next])[positions[next]++];
+            if (matches(entry, speaker) && !visitor(*entry.mInfo))
+                return;
+        }
+    }
+}
+
+#endif
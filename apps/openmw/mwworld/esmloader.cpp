@@ -1,8 +1,12 @@
 #include "esmloader.hpp"
 #include "esmstore.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <thread>
 
+#include <components/debug/debuglog.hpp>
 #include <components/esm/format.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/readerscache.hpp>
@@ -11,11 +15,144 @@
 #include <components/files/openfile.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/sceneutil/workqueue.hpp>
+#include <components/toutf8/toutf8.hpp>
 
 #include "../mwbase/environment.hpp"
 
 namespace MWWorld
 {
+    namespace
+    {
+        // Number of records parsed by a single work item
+        constexpr std::size_t recordsPerStagedRange = 4096;
+
+        class StageRangeWorkItem final : public SceneUtil::WorkItem
+        {
+        public:
+            StageRangeWorkItem(const ESMStore& store, const std::optional<ToUTF8::Utf8Encoder>& encoder,
+                const std::filesystem::path& path, int index, const ESM::ESM_Context& context, std::size_t end,
+                StagedRecordRange& range)
+                : mStore(store)
+                , mEncoder(encoder)
+                , mPath(path)
+                , mIndex(index)
+                , mContext(context)
+                , mEnd(end)
+                , mRange(range)
+            {
+            }
+
+            void doWork() override
+            {
+                try
+                {
+                    ESM::ESMReader reader;
+                    if (mEncoder.has_value())
+                        reader.setEncoder(&*mEncoder);
+                    reader.setIndex(mIndex);
+                    reader.open(mPath);
+                    reader.restoreContext(mContext);
+                    mStore.stageRecords(reader, mEnd, mRange);
+                }
+                catch (const std::exception& e)
+                {
+                    // The records are parsed again by EsmLoader::load which reports the error
+                    Log(Debug::Verbose) << "Failed to stage records of " << mPath << ": " << e.what();
+                    mRange.mRecords.clear();
+                }
+            }
+
+        private:
+            const ESMStore& mStore;
+            std::optional<ToUTF8::Utf8Encoder> mEncoder;
+            const std::filesystem::path mPath;
+            const int mIndex;
+            const ESM::ESM_Context mContext;
+            const std::size_t mEnd;
+            StagedRecordRange& mRange;
+        };
+
+        class StageFileWorkItem final : public SceneUtil::WorkItem
+        {
+        public:
+            StageFileWorkItem(const ESMStore& store, const ToUTF8::Utf8Encoder* encoder,
+                const std::filesystem::path& path, int index, SceneUtil::WorkQueue& workQueue,
+                std::vector<StagedRecordRange>& ranges, std::vector<osg::ref_ptr<SceneUtil::WorkItem>>& rangeItems)
+                : mStore(store)
+                , mPath(path)
+                , mIndex(index)
+                , mWorkQueue(workQueue)
+                , mRanges(ranges)
+                , mRangeItems(rangeItems)
+            {
+                if (encoder != nullptr)
+                    mEncoder = *encoder;
+            }
+
+            void doWork() override
+            {
+                std::vector<ESM::ESM_Context> contexts;
+
+                try
+                {
+                    auto stream = Files::openBinaryInputFileStream(mPath);
+                    if (ESM::readFormat(*stream) != ESM::Format::Tes3)
+                        return;
+                    stream->seekg(0);
+
+                    ESM::ESMReader reader;
+                    reader.setIndex(mIndex);
+                    reader.open(std::move(stream), mPath);
+
+                    for (std::size_t count = 0; reader.hasMoreRecs(); ++count)
+                    {
+                        if (count % recordsPerStagedRange == 0)
+                            contexts.push_back(reader.getContext());
+                        reader.getRecName();
+                        reader.getRecHeader();
+                        reader.skipRecord();
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Verbose) << "Failed to stage records of " << mPath << ": " << e.what();
+                    return;
+                }
+
+                mRanges.resize(contexts.size());
+                for (std::size_t i = 0; i < contexts.size(); ++i)
+                    mRanges[i].mBegin = contexts[i].filePos;
+
+                // Add to the front of the queue to finish the ranges of the file before starting the next one
+                for (std::size_t i = 0; i < contexts.size(); ++i)
+                {
+                    const std::size_t end
+                        = i + 1 < contexts.size() ? mRanges[i + 1].mBegin : std::numeric_limits<std::size_t>::max();
+                    osg::ref_ptr<SceneUtil::WorkItem> item
+                        = new StageRangeWorkItem(mStore, mEncoder, mPath, mIndex, contexts[i], end, mRanges[i]);
+                    mRangeItems.push_back(item);
+                    mWorkQueue.addWorkItem(std::move(item), true);
+                }
+            }
+
+        private:
+            const ESMStore& mStore;
+            std::optional<ToUTF8::Utf8Encoder> mEncoder;
+            const std::filesystem::path mPath;
+            const int mIndex;
+            SceneUtil::WorkQueue& mWorkQueue;
+            std::vector<StagedRecordRange>& mRanges;
+            std::vector<osg::ref_ptr<SceneUtil::WorkItem>>& mRangeItems;
+        };
+    }
+
+    struct EsmLoader::StagedFile
+    {
+        osg::ref_ptr<SceneUtil::WorkItem> mFileItem;
+        std::vector<osg::ref_ptr<SceneUtil::WorkItem>> mRangeItems;
+        std::vector<StagedRecordRange> mRanges;
+    };
 
     EsmLoader::EsmLoader(MWWorld::ESMStore& store, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
         std::vector<int>& esmVersions)
@@ -28,6 +165,39 @@ namespace MWWorld
     {
     }
 
+    EsmLoader::~EsmLoader()
+    {
+        // Work items refer to the staged files
+        if (mWorkQueue != nullptr)
+            mWorkQueue->stop();
+    }
+
+    void EsmLoader::stage(const std::vector<std::pair<std::filesystem::path, int>>& files, std::size_t numThreads)
+    {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        // Work items would run inline without any benefit
+        numThreads = 0;
+#else
+        numThreads = std::min<std::size_t>(numThreads, std::max(1u, std::thread::hardware_concurrency()) - 1);
+#endif
+        if (numThreads == 0 || files.empty())
+            return;
+
+        if (mWorkQueue == nullptr)
+            mWorkQueue = new SceneUtil::WorkQueue(numThreads);
+
+        for (const auto& [path, index] : files)
+        {
+            auto& staged = mStagedFiles[index];
+            if (staged != nullptr)
+                continue;
+            staged = std::make_unique<StagedFile>();
+            staged->mFileItem = new StageFileWorkItem(
+                mStore, mEncoder, path, index, *mWorkQueue, staged->mRanges, staged->mRangeItems);
+            mWorkQueue->addWorkItem(staged->mFileItem);
+        }
+    }
+
     void EsmLoader::load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener)
     {
 
@@ -55,7 +225,19 @@ namespace MWWorld
                   "Please run the launcher to fix this issue.");
 
                 mESMVersions[index] = reader->getVer();
-                mStore.load(*reader, listener, mDialogue);
+
+                std::unique_ptr<StagedFile> staged;
+                if (const auto it = mStagedFiles.find(index); it != mStagedFiles.end())
+                {
+                    staged = std::move(it->second);
+                    mStagedFiles.erase(it);
+                    staged->mFileItem->waitTillDone();
+                    for (const osg::ref_ptr<SceneUtil::WorkItem>& item : staged->mRangeItems)
+                        item->waitTillDone();
+                }
+
+                mStore.load(*reader, listener, mDialogue,
+                    staged != nullptr ? std::span<StagedRecordRange>(staged->mRanges) : std::span<StagedRecordRange>());
 
                 if (!mMasterFileFormat.has_value()
                     && (Misc::StringUtils::ciEndsWith(reader->getName().u8string(), u8".esm")
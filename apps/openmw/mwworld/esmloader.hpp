@@ -2,9 +2,13 @@
 #define ESMLOADER_HPP
 
 #include <map>
+#include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
+#include <osg/ref_ptr>
+
 #include "contentloader.hpp"
 
 namespace ToUTF8
@@ -18,6 +22,11 @@ namespace ESM
     struct Dialogue;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWWorld
 {
 
@@ -28,11 +37,19 @@ namespace MWWorld
         explicit EsmLoader(MWWorld::ESMStore& store, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
             std::vector<int>& esmVersions);
 
+        ~EsmLoader();
+
         std::optional<int> getMasterFileFormat() const { return mMasterFileFormat; }
 
+        /// Start parsing the records of the given content files and indices on up to numThreads worker threads.
+        /// load() uses the parsed records for these files, so the result is the same as without staging.
+        void stage(const std::vector<std::pair<std::filesystem::path, int>>& files, std::size_t numThreads);
+
         void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) override;
 
     private:
+        struct StagedFile;
+
         ESM::ReadersCache& mReaders;
         MWWorld::ESMStore& mStore;
         ToUTF8::Utf8Encoder* mEncoder;
@@ -40,6 +57,8 @@ namespace MWWorld
         std::optional<int> mMasterFileFormat;
         std::vector<int>& mESMVersions;
         std::map<std::string, int> mNameToIndex;
+        std::map<int, std::unique_ptr<StagedFile>> mStagedFiles;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
     };
 
 } /* namespace MWWorld */
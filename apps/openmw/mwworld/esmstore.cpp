@@ -290,6 +290,31 @@ namespace MWWorld
             return std::apply(
                 [&reader](auto&... x) { return (typedReadRecordESM4(reader, x) || ...); }, store.mStoreImp->mStores);
         }
+
+        template <typename T>
+        static bool isStoredESM4(const Store<T>& /*store*/, ESM::RecNameInts recName)
+        {
+            if constexpr (HasRecordId<T>::value)
+            {
+                if constexpr (ESM::isESM4Rec(T::sRecordId))
+                    return T::sRecordId == recName;
+            }
+            return false;
+        }
+
+        // Records in the child groups of a top group (e.g. references of a cell) are stored only with the parent
+        // records, so a top group can be skipped when its record type is not stored.
+        static bool needsGroup(const ESM4::Reader& reader, const ESMStore& store)
+        {
+            const ESM4::RecordHeader& header = reader.hdr();
+            if (header.group.type != ESM4::Grp_RecordType || (header.group.label.value & ESM::sEsm4RecnameFlag) != 0)
+                return true;
+
+            const auto recName = static_cast<ESM::RecNameInts>(
+                ESM::esm4Recname(static_cast<ESM4::RecordTypes>(header.group.label.value)));
+            return std::apply(
+                [recName](const auto&... x) { return (isStoredESM4(x, recName) || ...); }, store.mStoreImp->mStores);
+        }
     };
 
     int ESMStore::find(const ESM::RefId& id) const
@@ -386,14 +411,50 @@ namespace MWWorld
         return false;
     }
 
-    void ESMStore::load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue)
+    void ESMStore::stageRecords(ESM::ESMReader& esm, std::size_t end, StagedRecordRange& range) const
+    {
+        while (esm.hasMoreRecs() && esm.getFileOffset() < end)
+        {
+            const ESM::RecNameInts recName = static_cast<ESM::RecNameInts>(esm.getRecName().toInt());
+            esm.getRecHeader();
+            if (esm.getRecordFlags() & ESM::FLAG_Ignored)
+            {
+                esm.skipRecord();
+                continue;
+            }
+
+            auto staged = range.mRecords.find(recName);
+            if (staged == range.mRecords.end())
+            {
+                const auto store = mStoreImp->mRecNameToStore.find(recName);
+                std::unique_ptr<StagedRecordsBase> records;
+                if (store != mStoreImp->mRecNameToStore.end())
+                    records = store->second->makeStagedRecords();
+                staged = range.mRecords.emplace(recName, std::move(records)).first;
+            }
+
+            if (staged->second != nullptr)
+                staged->second->parse(esm);
+            else
+                esm.skipRecord();
+        }
+    }
+
+    void ESMStore::load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue,
+        std::span<StagedRecordRange> staged)
     {
         if (listener != nullptr)
             listener->setProgressRange(::EsmLoader::fileProgress);
 
+        auto nextRange = staged.begin();
+        StagedRecordRange* currentRange = nullptr;
+
         // Loop through all records
         while (esm.hasMoreRecs())
         {
+            while (nextRange != staged.end() && nextRange->mBegin <= esm.getFileOffset())
+                currentRange = &*nextRange++;
+
             ESM::NAME n = esm.getRecName();
             esm.getRecHeader();
             if (esm.getRecordFlags() & ESM::FLAG_Ignored)
@@ -406,6 +467,21 @@ namespace MWWorld
             ESM::RecNameInts recName = static_cast<ESM::RecNameInts>(n.toInt());
             const auto& it = mStoreImp->mRecNameToStore.find(recName);
 
+            if (mSkipSnapshotRecords && it != mStoreImp->mRecNameToStore.end() && it->second->isLoadedIndependently())
+            {
+                esm.skipRecord();
+                dialogue = nullptr;
+                continue;
+            }
+
+            StagedRecordsBase* stagedRecords = nullptr;
+            if (currentRange != nullptr)
+            {
+                const auto records = currentRange->mRecords.find(recName);
+                if (records != currentRange->mRecords.end())
+                    stagedRecords = records->second.get();
+            }
+
             if (it == mStoreImp->mRecNameToStore.end())
             {
                 if (recName == ESM::REC_INFO)
@@ -447,7 +523,14 @@ namespace MWWorld
             }
             else
             {
-                RecordId id = it->second->load(esm);
+                RecordId id;
+                if (stagedRecords != nullptr)
+                {
+                    esm.skipRecord();
+                    id = it->second->loadStaged(*stagedRecords);
+                }
+                else
+                    id = it->second->load(esm);
                 if (id.mIsDeleted)
                 {
                     it->second->eraseStatic(id.mId);
@@ -468,6 +551,13 @@ namespace MWWorld
         }
     }
 
+    void ESMStore::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        for (const auto& [_, store] : mStoreImp->mRecNameToStore)
+            if (store->isLoadedIndependently())
+                store->writeStatic(writer);
+    }
+
     void ESMStore::loadESM4(ESM4::Reader& reader, Loading::Listener* listener)
     {
         if (listener != nullptr)
@@ -478,7 +568,8 @@ namespace MWWorld
                 listener->setProgress(::EsmLoader::fileProgress * r.getFileOffset() / r.getFileSize());
             return result;
         };
-        ESM4::ReaderUtils::readAll(reader, visitorRec, [](ESM4::Reader&) {});
+        auto visitorGroup = [this](ESM4::Reader& r) { return ESMStoreImp::needsGroup(r, *this); };
+        ESM4::ReaderUtils::readAll(reader, visitorRec, visitorGroup);
     }
 
     void ESMStore::setIdType(const ESM::RefId& id, ESM::RecNameInts type)
@@ -2,7 +2,9 @@
 #define OPENMW_MWWORLD_ESMSTORE_H
 
 #include <filesystem>
+#include <map>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <tuple>
 #include <unordered_map>
@@ -26,6 +28,7 @@ namespace MWMechanics
 
 namespace ESM
 {
+    class ESMWriter;
     class ReadersCache;
     class Script;
     struct Activator;
@@ -120,6 +123,15 @@ namespace MWWorld
 {
     struct ESMStoreImp;
 
+    /// @brief Records of a part of a content file parsed ahead of ESMStore::load, see ESMStore::stageRecords.
+    struct StagedRecordRange
+    {
+        /// Offset of the first record of the range in the file
+        std::size_t mBegin = 0;
+        /// Parsed records per record type, nullptr for the types that have to be loaded sequentially
+        std::map<ESM::RecNameInts, std::unique_ptr<StagedRecordsBase>> mRecords;
+    };
+
     class ESMStore
     {
         friend struct ESMStoreImp; // This allows StoreImp to extend esmstore without beeing included everywhere
@@ -192,6 +204,7 @@ namespace MWWorld
         std::vector<LuaContent> mLuaContent;
 
         bool mIsSetUpDone = false;
+        bool mSkipSnapshotRecords = false;
 
     public:
         void addOMWScripts(std::filesystem::path filePath) { mLuaContent.push_back(std::move(filePath)); }
@@ -221,9 +234,26 @@ namespace MWWorld
         /// Validate entries in store after loading a save
         void validateDynamic();
 
-        void load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue);
+        /// Parse records from the current position of the reader until the file offset \p end without modifying
+        /// the store.
+        /// @note May run on any thread while load() is running on another one. It only reads the record type to
+        /// store map, which is filled by the constructor and never changed, and calls makeStagedRecords() on the
+        /// stores, which doesn't access their records. load() only writes the records of the stores. \p esm and
+        /// \p range must not be used by other threads.
+        void stageRecords(ESM::ESMReader& esm, std::size_t end, StagedRecordRange& range) const;
+
+        /// @param staged Ranges produced by stageRecords for this file, sorted by offset. Staged records are used
+        /// instead of parsing them again.
+        void load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue,
+            std::span<StagedRecordRange> staged = {});
         void loadESM4(ESM4::Reader& esm, Loading::Listener* listener);
 
+        /// Write the records that stageRecords() can parse, as they are after loading all content files.
+        void writeSnapshot(ESM::ESMWriter& writer) const;
+
+        /// Make load() skip the records written by writeSnapshot() because they are loaded from a snapshot instead.
+        void setSkipSnapshotRecords(bool value) { mSkipSnapshotRecords = value; }
+
         template <class T>
         const Store<T>& get() const
         {
@@ -7,6 +7,7 @@
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 #include <components/detournavigator/agentbounds.hpp>
 #include <components/detournavigator/debug.hpp>
 #include <components/detournavigator/heightfieldshape.hpp>
@@ -17,6 +18,7 @@
 #include <components/esm3/loadcell.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/convert.hpp>
+#include <components/misc/jobsystem.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
@@ -364,6 +366,7 @@ namespace MWWorld
     {
         if (mActiveCells.find(cell) == mActiveCells.end())
             return;
+        OPENMW_TRACE_ZONE("Scene::unloadCell");
         Log(Debug::Info) << "Unloading cell " << cell->getCell()->getDescription();
 
         ListAndResetObjectsVisitor visitor;
@@ -428,6 +431,8 @@ namespace MWWorld
     {
         using DetourNavigator::HeightfieldShape;
 
+        OPENMW_TRACE_ZONE("Scene::loadCell");
+
         assert(mActiveCells.find(&cell) == mActiveCells.end());
         mActiveCells.insert(&cell);
 
@@ -614,6 +619,7 @@ namespace MWWorld
 
     void Scene::changeCellGrid(const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent)
     {
+        OPENMW_TRACE_ZONE("Scene::changeCellGrid");
         const int halfGridSize
             = isEsm4Ext(playerCellIndex.mWorldspace) ? Constants::ESM4CellGridRadius : Constants::CellGridRadius;
         auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
@@ -676,6 +682,14 @@ namespace MWWorld
 
         sortCellsToLoad(playerCellX, playerCellY, cellsPositionsToLoad);
 
+        // Convert the meshes on the worker threads while the cells are loaded, the player's cell goes first
+        for (const auto& [x, y] : cellsPositionsToLoad)
+        {
+            const ESM::ExteriorCellLocation location(x, y, playerCellIndex.mWorldspace);
+            mPreloader->preloadTemplates(mWorld.getWorldModel().getExterior(location),
+                location == playerCellIndex ? Misc::JobPriority::High : Misc::JobPriority::Normal);
+        }
+
         for (const auto& [x, y] : cellsPositionsToLoad)
         {
             ESM::ExteriorCellLocation indexToLoad = { x, y, playerCellIndex.mWorldspace };
@@ -930,6 +944,7 @@ namespace MWWorld
     void Scene::changeToInteriorCell(
         std::string_view cellName, const ESM::Position& position, bool adjustPlayerPos, bool changeEvent)
     {
+        OPENMW_TRACE_ZONE("Scene::changeToInteriorCell");
         CellStore& cell = mWorld.getWorldModel().getInterior(cellName);
         bool useFading = (mCurrentCell != nullptr);
         if (useFading)
@@ -969,6 +984,7 @@ namespace MWWorld
 
         // Load cell.
         mPagedRefs.clear();
+        mPreloader->preloadTemplates(cell, Misc::JobPriority::High);
         loadCell(cell, loadingListener, changeEvent, position.asVec3(), navigatorUpdateGuard.get());
 
         navigatorUpdateGuard.reset();
@@ -997,6 +1013,7 @@ namespace MWWorld
     void Scene::changeToExteriorCell(
         const ESM::RefId& extCellId, const ESM::Position& position, bool adjustPlayerPos, bool changeEvent)
     {
+        OPENMW_TRACE_ZONE("Scene::changeToExteriorCell");
 
         if (changeEvent)
             MWBase::Environment::get().getWindowManager()->fadeScreenOut(0.5);
@@ -1137,6 +1154,7 @@ namespace MWWorld
     {
         if (dt <= 1e-06)
             return;
+        OPENMW_TRACE_ZONE("Scene::preloadCells");
         std::vector<PositionCellGrid> exteriorPositions;
 
         const MWWorld::ConstPtr player = mWorld.getPlayerPtr();
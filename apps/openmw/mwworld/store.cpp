@@ -3,6 +3,7 @@
 #include <iterator>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
 #include <components/debug/debuglog.hpp>
 
@@ -31,6 +32,39 @@ namespace
         return false;
     }
 
+    template <class T>
+    class StagedRecords final : public MWWorld::StagedRecordsBase
+    {
+    public:
+        void parse(ESM::ESMReader& esm) override
+        {
+            auto& [record, isDeleted] = mRecords.emplace_back(T(), false);
+            record.load(esm, isDeleted);
+        }
+
+        std::pair<T, bool>& next()
+        {
+            if (mNext >= mRecords.size())
+                throw std::logic_error("No more staged records of type ESM::REC_"
+                    + std::string(ESM::getRecNameString(T::sRecordId).toStringView()));
+            return mRecords[mNext++];
+        }
+
+    private:
+        std::vector<std::pair<T, bool>> mRecords;
+        std::size_t mNext = 0;
+    };
+
+    template <class T, class = std::void_t<>>
+    struct HasRecordFlags : std::false_type
+    {
+    };
+
+    template <class T>
+    struct HasRecordFlags<T, std::void_t<decltype(T::mRecordFlags)>> : std::true_type
+    {
+    };
+
     std::string_view getGMSTString(const MWWorld::Store<ESM::GameSetting>& settings, std::string_view id)
     {
         const ESM::GameSetting* setting = settings.search(id);
@@ -211,14 +245,7 @@ namespace MWWorld
             bool isDeleted = false;
             record.load(esm, isDeleted);
 
-            std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(record.mId, record);
-            if (inserted.second)
-                mShared.push_back(&inserted.first->second);
-
-            if constexpr (std::is_same_v<Id, ESM::RefId>)
-                return RecordId(record.mId, isDeleted);
-            else
-                return RecordId();
+            return insertLoaded(std::move(record), isDeleted);
         }
         else
         {
@@ -229,6 +256,60 @@ namespace MWWorld
         }
     }
 
+    template <class T, class Id>
+    std::unique_ptr<StagedRecordsBase> TypedDynamicStore<T, Id>::makeStagedRecords() const
+    {
+        if constexpr (!ESM::isESM4Rec(T::sRecordId))
+            return std::make_unique<StagedRecords<T>>();
+        else
+            return nullptr;
+    }
+
+    template <class T, class Id>
+    RecordId TypedDynamicStore<T, Id>::loadStaged(StagedRecordsBase& staged)
+    {
+        if constexpr (!ESM::isESM4Rec(T::sRecordId))
+        {
+            auto& [record, isDeleted] = static_cast<StagedRecords<T>&>(staged).next();
+            return insertLoaded(std::move(record), isDeleted);
+        }
+        else
+            return DynamicStoreBase<Id>::loadStaged(staged);
+    }
+
+    template <class T, class Id>
+    void TypedDynamicStore<T, Id>::writeStatic(ESM::ESMWriter& writer) const
+    {
+        if constexpr (!ESM::isESM4Rec(T::sRecordId))
+        {
+            // The static records are at the beginning of mShared in the order they were inserted
+            for (std::size_t i = 0, n = mStatic.size(); i < n; ++i)
+            {
+                const T& record = *mShared[i];
+                if constexpr (HasRecordFlags<T>::value)
+                    writer.startRecord(T::sRecordId, record.mRecordFlags);
+                else
+                    writer.startRecord(T::sRecordId);
+                record.save(writer);
+                writer.endRecord(T::sRecordId);
+            }
+        }
+    }
+
+    template <class T, class Id>
+    RecordId TypedDynamicStore<T, Id>::insertLoaded(T&& record, bool isDeleted)
+    {
+        const Id id = record.mId;
+        std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(id, std::move(record));
+        if (inserted.second)
+            mShared.push_back(&inserted.first->second);
+
+        if constexpr (std::is_same_v<Id, ESM::RefId>)
+            return RecordId(id, isDeleted);
+        else
+            return RecordId();
+    }
+
     template <class T, class Id>
     void TypedDynamicStore<T, Id>::setUp()
     {
@@ -1055,6 +1136,10 @@ namespace MWWorld
         std::sort(mShared.begin(), mShared.end(),
             [](const ESM::Dialogue* l, const ESM::Dialogue* r) -> bool { return l->mId < r->mId; });
 
+        mInfoIndices.clear();
+        for (const ESM::Dialogue* dial : mShared)
+            mInfoIndices.emplace(dial, DialogueInfoIndex(*dial));
+
         mKeywordSearchModFlag = true;
     }
 
@@ -1110,6 +1195,7 @@ namespace MWWorld
         }
         else
         {
+            mInfoIndices.erase(&found->second);
             found->second.loadData(esm, isDeleted);
             dialogue.mId = found->second.mId;
         }
@@ -1121,6 +1207,9 @@ namespace MWWorld
 
     bool Store<ESM::Dialogue>::eraseStatic(const ESM::RefId& id)
     {
+        if (const auto it = mStatic.find(id); it != mStatic.end())
+            mInfoIndices.erase(&it->second);
+
         if (eraseFromMap(mStatic, id))
             mKeywordSearchModFlag = true;
 
@@ -1139,6 +1228,14 @@ namespace MWWorld
         return std::exchange(mKeywordSearchModFlag, false);
     }
 
+    const DialogueInfoIndex* Store<ESM::Dialogue>::searchInfoIndex(const ESM::Dialogue& dialogue) const
+    {
+        const auto it = mInfoIndices.find(&dialogue);
+        if (it == mInfoIndices.end())
+            return nullptr;
+        return &it->second;
+    }
+
     // ESM4 Cell
     //=========================================================================
 
@@ -5,6 +5,7 @@
 #include <memory>
 #include <set>
 #include <span>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -27,6 +28,8 @@
 #include <components/misc/rng.hpp>
 #include <components/misc/strings/algorithm.hpp>
 
+#include "dialogueinfoindex.hpp"
+
 namespace ESM
 {
     struct LandTexture;
@@ -55,6 +58,16 @@ namespace MWWorld
     {
     }; // Empty interface to be parent of all store types
 
+    /// @brief Records of one type parsed ahead of time, to be inserted into their store in the order they were parsed.
+    class StagedRecordsBase
+    {
+    public:
+        virtual ~StagedRecordsBase() = default;
+
+        /// Parse the current record of the reader without accessing any store. May be called from worker threads.
+        virtual void parse(ESM::ESMReader& esm) = 0;
+    };
+
     template <class Id>
     class DynamicStoreBase : public StoreBase
     {
@@ -71,6 +84,23 @@ namespace MWWorld
         virtual size_t getDynamicSize() const { return 0; }
         virtual RecordId load(ESM::ESMReader& esm) = 0;
 
+        /// Whether loading a record does not depend on the state of this or any other store.
+        virtual bool isLoadedIndependently() const { return false; }
+
+        /// Create a buffer for parsing records independently of the store state, or nullptr if the records of this
+        /// store have to be loaded sequentially.
+        virtual std::unique_ptr<StagedRecordsBase> makeStagedRecords() const { return nullptr; }
+
+        /// Insert the next record of a buffer created by makeStagedRecords(), like load() would have done.
+        virtual RecordId loadStaged(StagedRecordsBase& staged)
+        {
+            throw std::logic_error("Store does not support staged records");
+        }
+
+        /// Write all records loaded from content files, to be read again by load(). Only supported by the stores
+        /// loaded independently.
+        virtual void writeStatic(ESM::ESMWriter& writer) const {}
+
         virtual bool eraseStatic(const Id& id) { return false; }
         virtual void clearDynamic() {}
 
@@ -241,8 +271,15 @@ namespace MWWorld
         bool erase(const T& item);
 
         RecordId load(ESM::ESMReader& esm) override;
+        bool isLoadedIndependently() const override { return !ESM::isESM4Rec(T::sRecordId); }
+        std::unique_ptr<StagedRecordsBase> makeStagedRecords() const override;
+        RecordId loadStaged(StagedRecordsBase& staged) override;
+        void writeStatic(ESM::ESMWriter& writer) const override;
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
         RecordId read(ESM::ESMReader& reader, bool overrideOnly = false) override;
+
+    private:
+        RecordId insertLoaded(T&& record, bool isDeleted);
     };
 
     template <class T>
@@ -511,6 +548,8 @@ namespace MWWorld
 
         mutable bool mKeywordSearchModFlag{ true };
 
+        std::unordered_map<const ESM::Dialogue*, DialogueInfoIndex> mInfoIndices;
+
     public:
         Store();
 
@@ -533,6 +572,9 @@ namespace MWWorld
         void listIdentifier(std::vector<ESM::RefId>& list) const override;
 
         bool getKeywordSearchModFlag() const;
+
+        /// Returns nullptr for dialogues not owned by the store or before setUp.
+        const DialogueInfoIndex* searchInfoIndex(const ESM::Dialogue& dialogue) const;
     };
 
     template <typename T>
@@ -35,6 +35,7 @@
 #include <components/misc/pathhelpers.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
+#include <components/misc/strings/algorithm.hpp>
 
 #include <components/files/collections.hpp>
 
@@ -104,6 +105,7 @@
 #include "weather.hpp"
 
 #include "contentloader.hpp"
+#include "contentsnapshot.hpp"
 #include "esmloader.hpp"
 
 namespace MWWorld
@@ -308,7 +310,7 @@ namespace MWWorld
         }
 
         mRendering = std::make_unique<MWRender::RenderingManager>(
-            viewer, rootNode, mResourceSystem, workQueue, *mNavigator, mGroundcoverStore, unrefQueue);
+            viewer, rootNode, mResourceSystem, workQueue, *mNavigator, mGroundcoverStore, unrefQueue, mUserDataPath);
         mProjectileManager = std::make_unique<ProjectileManager>(
             mRendering->getLightRoot()->asGroup(), mResourceSystem, mRendering.get(), mPhysics.get());
         mRendering->preloadCommonAssets();
@@ -2879,22 +2881,69 @@ namespace MWWorld
         OMWScriptsLoader omwScriptsLoader(mStore);
         gameContentLoader.addLoader(".omwscripts", omwScriptsLoader);
 
-        int idx = 0;
+        std::vector<std::filesystem::path> paths;
+        paths.reserve(content.size());
         for (const std::string& file : content)
         {
             const Files::MultiDirCollection& col = fileCollections.getCollection(Misc::getFileExtension(file));
-            if (col.doesExist(file))
-            {
-                gameContentLoader.load(col.getPath(file), idx, listener);
-            }
-            else
+            if (!col.doesExist(file))
             {
                 std::string message = "Failed loading " + file + ": the content file does not exist";
                 throw std::runtime_error(message);
             }
+            paths.push_back(col.getPath(file));
+        }
+
+        std::vector<std::pair<std::filesystem::path, int>> esmFiles;
+        std::vector<std::filesystem::path> esmPaths;
+        for (std::size_t i = 0; i < paths.size(); ++i)
+        {
+            if (Misc::StringUtils::ciEqual(Misc::getFileExtension(content[i]), "omwscripts"))
+                continue;
+            esmFiles.emplace_back(paths[i], static_cast<int>(i));
+            esmPaths.push_back(paths[i]);
+        }
+
+        const std::filesystem::path snapshotPath = mUserDataPath / "content.snapshot";
+        std::string snapshotKey;
+        bool hasSnapshot = false;
+        if (Settings::general().mContentSnapshot)
+        {
+            snapshotKey = makeContentSnapshotKey(esmPaths, encoder);
+            hasSnapshot = hasContentSnapshot(snapshotPath, snapshotKey);
+        }
+
+        // Records stored in the snapshot don't need to be parsed
+        if (hasSnapshot)
+            mStore.setSkipSnapshotRecords(true);
+        else
+            esmLoader.stage(esmFiles, static_cast<std::size_t>(Settings::general().mContentLoadingNumThreads));
+
+        int idx = 0;
+        for (const std::filesystem::path& path : paths)
+        {
+            gameContentLoader.load(path, idx, listener);
             idx++;
         }
 
+        if (hasSnapshot)
+        {
+            Log(Debug::Info) << "Loading content snapshot " << snapshotPath;
+            mStore.setSkipSnapshotRecords(false);
+            loadContentSnapshot(snapshotPath, mStore, listener);
+        }
+        else if (Settings::general().mContentSnapshot)
+        {
+            try
+            {
+                saveContentSnapshot(snapshotPath, snapshotKey, mStore);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to save content snapshot " << snapshotPath << ": " << e.what();
+            }
+        }
+
         if (const auto v = esmLoader.getMasterFileFormat(); v.has_value() && *v == 0)
             ensureNeededRecords(); // Insert records that may not be present in all versions of master files.
     }
@@ -95,6 +95,23 @@ namespace OpenMW
         addOption("random-seed", bpo::value<unsigned int>()->default_value(Misc::Rng::generateDefaultSeed()),
             "seed value for random number generator");
 
+        addOption("benchmark", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+            "replay a benchmark track over the loaded save game or start cell with a fixed time step, write the "
+            "result and quit (random-seed is 0 unless specified)");
+
+        addOption("benchmark-output",
+            bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+            "benchmark result file (benchmark.json in the user data directory by default)");
+
+        addOption("benchmark-time-step", bpo::value<float>()->default_value(1.0f / 60.0f, "1/60"),
+            "simulation time step in seconds used by benchmark");
+
+        addOption("benchmark-record", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+            "record the player camera into a benchmark track while playing");
+
+        addOption("hidden-window", bpo::value<bool>()->implicit_value(true)->default_value(false),
+            "create the game window hidden, useful to run benchmarks unattended");
+
         return desc;
     }
 }
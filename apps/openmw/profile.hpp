@@ -4,6 +4,8 @@
 #include <osg/Stats>
 #include <osg/Timer>
 
+#include <components/debug/tracing.hpp>
+
 #include <cstddef>
 #include <string>
 
@@ -12,12 +14,14 @@ namespace OMW
     struct UserStats
     {
         const std::string mLabel;
+        const std::string mName;
         const std::string mBegin;
         const std::string mEnd;
         const std::string mTaken;
 
         explicit UserStats(const std::string& label, const std::string& prefix)
             : mLabel(label)
+            , mName(prefix)
             , mBegin(prefix + "_time_begin")
             , mEnd(prefix + "_time_end")
             , mTaken(prefix + "_time_taken")
@@ -117,7 +121,8 @@ namespace OMW
     public:
         explicit ScopedProfile(
             osg::Timer_t frameStart, unsigned int frameNumber, const osg::Timer& timer, osg::Stats& stats)
-            : mScopeStart(timer.tick())
+            : mZone(UserStatsValue<type>::sValue.mLabel.c_str())
+            , mScopeStart(timer.tick())
             , mFrameStart(frameStart)
             , mFrameNumber(frameNumber)
             , mTimer(timer)
@@ -142,6 +147,7 @@ namespace OMW
         }
 
     private:
+        const Debug::Tracing::Zone mZone;
         const osg::Timer_t mScopeStart;
         const osg::Timer_t mFrameStart;
         const unsigned int mFrameNumber;
@@ -0,0 +1,130 @@
+#include "apps/openmw/mwworld/dialogueinfoindex.hpp"
+
+#include <components/esm3/loaddial.hpp>
+#include <components/esm3/loadinfo.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace MWWorld
+{
+    namespace
+    {
+        using namespace testing;
+
+        struct MWWorldDialogueInfoIndexTest : Test
+        {
+            ESM::Dialogue mDialogue;
+            DialogueSpeaker mNpc{
+                .mId = ESM::RefId::stringRefId("npc"),
+                .mIsCreature = false,
+                .mRace = ESM::RefId::stringRefId("dark elf"),
+                .mClass = ESM::RefId::stringRefId("guard"),
+                .mPrimaryFaction = ESM::RefId::stringRefId("hlaalu"),
+                .mIsFemale = false,
+            };
+            DialogueSpeaker mCreature{
+                .mId = ESM::RefId::stringRefId("creature"),
+                .mIsCreature = true,
+            };
+
+            ESM::DialInfo& addInfo(std::string_view id)
+            {
+                ESM::DialInfo& info = mDialogue.mInfo.emplace_back();
+                info.mId = ESM::RefId::stringRefId(id);
+                return info;
+            }
+
+            std::vector<ESM::RefId> getCandidates(const DialogueSpeaker& speaker) const
+            {
+                const DialogueInfoIndex index(mDialogue);
+                std::vector<ESM::RefId> result;
+                index.visitCandidates(speaker, [&](const ESM::DialInfo& info) {
+                    result.push_back(info.mId);
+                    return true;
+                });
+                return result;
+            }
+        };
+
+        TEST_F(MWWorldDialogueInfoIndexTest, emptyDialogueShouldHaveNoCandidates)
+        {
+            EXPECT_THAT(getCandidates(mNpc), IsEmpty());
+        }
+
+        TEST_F(MWWorldDialogueInfoIndexTest, shouldPreserveDialogueOrderForNpc)
+        {
+            addInfo("any1");
+            addInfo("actor").mActor = mNpc.mId;
+            addInfo("race").mRace = mNpc.mRace;
+            addInfo("any2");
+            addInfo("otherActor").mActor = ESM::RefId::stringRefId("other");
+            addInfo("otherRace").mRace = ESM::RefId::stringRefId("nord");
+            addInfo("actor2").mActor = mNpc.mId;
+            EXPECT_THAT(getCandidates(mNpc),
+                ElementsAre(ESM::RefId::stringRefId("any1"), ESM::RefId::stringRefId("actor"),
+                    ESM::RefId::stringRefId("race"), ESM::RefId::stringRefId("any2"),
+                    ESM::RefId::stringRefId("actor2")));
+        }
+
+        TEST_F(MWWorldDialogueInfoIndexTest, creatureShouldOnlyGetInfosForItsId)
+        {
+            addInfo("any");
+            addInfo("race").mRace = mNpc.mRace;
+            addInfo("actor").mActor = mCreature.mId;
+            addInfo("otherActor").mActor = mNpc.mId;
+            EXPECT_THAT(getCandidates(mCreature), ElementsAre(ESM::RefId::stringRefId("actor")));
+        }
+
+        TEST_F(MWWorldDialogueInfoIndexTest, shouldSkipInfosForOtherClass)
+        {
+            addInfo("class").mClass = mNpc.mClass;
+            addInfo("otherClass").mClass = ESM::RefId::stringRefId("thief");
+            EXPECT_THAT(getCandidates(mNpc), ElementsAre(ESM::RefId::stringRefId("class")));
+        }
+
+        TEST_F(MWWorldDialogueInfoIndexTest, shouldSkipInfosForOtherFaction)
+        {
+            addInfo("faction").mFaction = mNpc.mPrimaryFaction;
+            addInfo("otherFaction").mFaction = ESM::RefId::stringRefId("redoran");
+            addInfo("factionLess").mFactionLess = true;
+            EXPECT_THAT(getCandidates(mNpc), ElementsAre(ESM::RefId::stringRefId("faction")));
+        }
+
+        TEST_F(MWWorldDialogueInfoIndexTest, factionLessInfoShouldMatchNpcWithoutFaction)
+        {
+            addInfo("factionLess").mFactionLess = true;
+            mNpc.mPrimaryFaction = ESM::RefId();
+            EXPECT_THAT(getCandidates(mNpc), ElementsAre(ESM::RefId::stringRefId("factionLess")));
+        }
+
+        TEST_F(MWWorldDialogueInfoIndexTest, shouldSkipInfosForOtherSex)
+        {
+            addInfo("male").mData.mGender = ESM::DialInfo::Male;
+            addInfo("female").mData.mGender = ESM::DialInfo::Female;
+            addInfo("any").mData.mGender = ESM::DialInfo::NA;
+            EXPECT_THAT(
+                getCandidates(mNpc), ElementsAre(ESM::RefId::stringRefId("male"), ESM::RefId::stringRefId("any")));
+            mNpc.mIsFemale = true;
+            EXPECT_THAT(
+                getCandidates(mNpc), ElementsAre(ESM::RefId::stringRefId("female"), ESM::RefId::stringRefId("any")));
+        }
+
+        TEST_F(MWWorldDialogueInfoIndexTest, visitorShouldStopWhenReturnsFalse)
+        {
+            addInfo("any1");
+            addInfo("actor").mActor = mNpc.mId;
+            addInfo("any2");
+            const DialogueInfoIndex index(mDialogue);
+            std::vector<ESM::RefId> visited;
+            index.visitCandidates(mNpc, [&](const ESM::DialInfo& info) {
+                visited.push_back(info.mId);
+                return visited.size() < 2;
+            });
+            EXPECT_THAT(visited, ElementsAre(ESM::RefId::stringRefId("any1"), ESM::RefId::stringRefId("actor")));
+        }
+    }
+}
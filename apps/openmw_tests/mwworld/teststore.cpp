@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <array>
 #include <fstream>
+#include <limits>
 #include <span>
 
 #include <boost/program_options/options_description.hpp>
@@ -419,6 +420,107 @@ TYPED_TEST_P(StoreTest, overwrite_test)
     }
 }
 
+/// Tests loading of records parsed ahead of time.
+TYPED_TEST_P(StoreTest, staged_load_test)
+{
+    using RecordType = TypeParam;
+
+    for (const ESM::FormatVersion formatVersion : getFormats())
+    {
+        SCOPED_TRACE("FormatVersion: " + std::to_string(formatVersion));
+
+        const ESM::RefId recordId = ESM::RefId::stringRefId("foobar");
+
+        RecordType record;
+        if constexpr (hasBlankFunction<RecordType>)
+            record.blank();
+        record.mId = recordId;
+        record.mModel = "the_staged_model";
+
+        ESM::ESMReader reader;
+        ESM::Dialogue* dialogue = nullptr;
+        MWWorld::ESMStore esmStore;
+
+        std::vector<MWWorld::StagedRecordRange> staged(1);
+        reader.open(getEsmFile(record, false, formatVersion), "filename");
+        staged[0].mBegin = reader.getFileOffset();
+        esmStore.stageRecords(reader, std::numeric_limits<std::size_t>::max(), staged[0]);
+
+        ASSERT_EQ(staged[0].mRecords.size(), 1);
+        EXPECT_EQ(staged[0].mRecords.begin()->first, RecordType::sRecordId);
+        EXPECT_NE(staged[0].mRecords.begin()->second, nullptr);
+
+        // the file has the same layout but different data, so the staged record is expected to be used
+        record.mModel = "the_parsed_model";
+        reader.open(getEsmFile(record, false, formatVersion), "filename");
+        esmStore.load(reader, &dummyListener, dialogue, staged);
+
+        esmStore.setUp();
+
+        const RecordType* loadedRec = esmStore.get<RecordType>().search(recordId);
+
+        ASSERT_NE(loadedRec, nullptr);
+
+        EXPECT_EQ(loadedRec->mModel, "the_staged_model");
+    }
+}
+
+/// Tests loading of records from a snapshot instead of content files.
+TYPED_TEST_P(StoreTest, snapshot_test)
+{
+    using RecordType = TypeParam;
+
+    for (const ESM::FormatVersion formatVersion : getFormats())
+    {
+        SCOPED_TRACE("FormatVersion: " + std::to_string(formatVersion));
+
+        const ESM::RefId recordId = ESM::RefId::stringRefId("foobar");
+
+        RecordType record;
+        if constexpr (hasBlankFunction<RecordType>)
+            record.blank();
+        record.mId = recordId;
+        record.mModel = "the_model";
+
+        ESM::ESMReader reader;
+        ESM::Dialogue* dialogue = nullptr;
+
+        auto snapshot = std::make_unique<std::stringstream>();
+
+        {
+            MWWorld::ESMStore esmStore;
+            reader.open(getEsmFile(record, false, formatVersion), "filename");
+            esmStore.load(reader, &dummyListener, dialogue);
+
+            ESM::ESMWriter writer;
+            writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+            writer.save(*snapshot);
+            esmStore.writeSnapshot(writer);
+            writer.close();
+        }
+
+        MWWorld::ESMStore esmStore;
+
+        esmStore.setSkipSnapshotRecords(true);
+        reader.open(getEsmFile(record, false, formatVersion), "filename");
+        esmStore.load(reader, &dummyListener, dialogue);
+        esmStore.setSkipSnapshotRecords(false);
+
+        EXPECT_EQ(esmStore.get<RecordType>().getSize(), 0);
+
+        reader.open(std::move(snapshot), "snapshot");
+        esmStore.load(reader, &dummyListener, dialogue);
+
+        esmStore.setUp();
+
+        const RecordType* loadedRec = esmStore.get<RecordType>().search(recordId);
+
+        ASSERT_NE(loadedRec, nullptr);
+
+        EXPECT_EQ(loadedRec->mModel, "the_model");
+    }
+}
+
 namespace
 {
     using namespace ::testing;
@@ -581,7 +683,7 @@ namespace
         RecordTypesTest, StoreSaveLoadTest, typename AsTestingTypes<RecordTypesWithSave>::Type);
 }
 
-REGISTER_TYPED_TEST_SUITE_P(StoreTest, overwrite_test, delete_test);
+REGISTER_TYPED_TEST_SUITE_P(StoreTest, overwrite_test, delete_test, staged_load_test, snapshot_test);
 
 static_assert(std::tuple_size_v<RecordTypesWithModel> == 19);
 
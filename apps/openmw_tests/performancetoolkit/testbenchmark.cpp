@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include "performance_toolkit/benchmark/benchmark_report.hpp"
+#include "performance_toolkit/benchmark/benchmark_track.hpp"
+
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace PerformanceToolkit
+{
+    namespace
+    {
+        using namespace testing;
+
+        BenchmarkTrack readTrack(const std::string& value)
+        {
+            std::istringstream stream(value);
+            return BenchmarkTrack::read(stream);
+        }
+
+        FrameStats makeFrame(float dt, std::vector<double> subsystems = {})
+        {
+            FrameStats result{};
+            result.dt = dt;
+            result.cpuMainTime = dt / 2;
+            result.cpuSubsystemTimes = std::move(subsystems);
+            return result;
+        }
+
+        TEST(PerformanceToolkitBenchmarkTrackTest, readShouldSkipCommentsAndEmptyLines)
+        {
+            const BenchmarkTrack track = readTrack("# comment\n"
+                                                   "\n"
+                                                   "camera 0 1 2 3 0.5 1.5\n"
+                                                   "  action 0.5 9\n");
+            ASSERT_EQ(track.getCameraKeys().size(), 1);
+            EXPECT_EQ(track.getCameraKeys()[0].position[2], 3);
+            EXPECT_EQ(track.getCameraKeys()[0].yaw, 1.5f);
+            ASSERT_EQ(track.getInputKeys().size(), 1);
+            EXPECT_EQ(track.getInputKeys()[0].action, 9);
+            EXPECT_EQ(track.getDuration(), 0.5);
+        }
+
+        TEST(PerformanceToolkitBenchmarkTrackTest, readShouldThrowOnMalformedLine)
+        {
+            EXPECT_THROW(readTrack("camera 0 1 2\n"), std::runtime_error);
+            EXPECT_THROW(readTrack("action 0 1 2\n"), std::runtime_error);
+            EXPECT_THROW(readTrack("teleport 0\n"), std::runtime_error);
+        }
+
+        TEST(PerformanceToolkitBenchmarkTrackTest, readShouldThrowOnUnsortedKeys)
+        {
+            EXPECT_THROW(readTrack("action 1 9\naction 0 9\n"), std::runtime_error);
+        }
+
+        TEST(PerformanceToolkitBenchmarkTrackTest, writtenTrackShouldBeReadBackUnchanged)
+        {
+            BenchmarkTrack track;
+            track.addCamera(CameraKey{ .time = 0.1, .position = { 1.1f, -2.2f, 3.3f }, .pitch = 0.3f, .yaw = -1.7f });
+            track.addCamera(CameraKey{ .time = 1.0 / 3, .position = { 1e6f, 0, 1e-6f }, .pitch = 0, .yaw = 3.1f });
+            track.addInput(InputKey{ .time = 0.2, .action = 11 });
+
+            std::stringstream stream;
+            track.write(stream);
+            const BenchmarkTrack result = BenchmarkTrack::read(stream);
+
+            ASSERT_EQ(result.getCameraKeys().size(), 2);
+            for (std::size_t i = 0; i < 2; ++i)
+            {
+                EXPECT_EQ(result.getCameraKeys()[i].time, track.getCameraKeys()[i].time);
+                EXPECT_EQ(result.getCameraKeys()[i].position, track.getCameraKeys()[i].position);
+                EXPECT_EQ(result.getCameraKeys()[i].pitch, track.getCameraKeys()[i].pitch);
+                EXPECT_EQ(result.getCameraKeys()[i].yaw, track.getCameraKeys()[i].yaw);
+            }
+            ASSERT_EQ(result.getInputKeys().size(), 1);
+            EXPECT_EQ(result.getInputKeys()[0].time, 0.2);
+            EXPECT_EQ(result.getInputKeys()[0].action, 11);
+        }
+
+        TEST(PerformanceToolkitBenchmarkTrackTest, sampleCameraShouldInterpolateBetweenKeys)
+        {
+            const BenchmarkTrack track = readTrack("camera 1 0 0 0 0 0\ncamera 3 10 20 30 1 0.5\n");
+            const CameraKey key = track.sampleCamera(1.5);
+            EXPECT_FLOAT_EQ(key.position[0], 2.5f);
+            EXPECT_FLOAT_EQ(key.position[1], 5);
+            EXPECT_FLOAT_EQ(key.position[2], 7.5f);
+            EXPECT_FLOAT_EQ(key.pitch, 0.25f);
+            EXPECT_FLOAT_EQ(key.yaw, 0.125f);
+        }
+
+        TEST(PerformanceToolkitBenchmarkTrackTest, sampleCameraShouldClampToTrack)
+        {
+            const BenchmarkTrack track = readTrack("camera 1 1 0 0 0 0\ncamera 3 3 0 0 0 0\n");
+            EXPECT_EQ(track.sampleCamera(0).position[0], 1);
+            EXPECT_EQ(track.sampleCamera(4).position[0], 3);
+        }
+
+        TEST(PerformanceToolkitBenchmarkTrackTest, sampleCameraShouldRotateYawTheShortestWay)
+        {
+            constexpr float pi = std::numbers::pi_v<float>;
+            BenchmarkTrack track;
+            track.addCamera(CameraKey{ .time = 0, .yaw = pi - 0.1f });
+            track.addCamera(CameraKey{ .time = 1, .yaw = -pi + 0.1f });
+            EXPECT_NEAR(track.sampleCamera(0.5).yaw, pi, 1e-5f);
+        }
+
+        TEST(PerformanceToolkitBenchmarkTrackTest, getInputsShouldReturnKeysInHalfOpenInterval)
+        {
+            const BenchmarkTrack track = readTrack("action 0 1\naction 0.5 2\naction 1 3\n");
+            const auto inputs = track.getInputs(0.5, 1);
+            ASSERT_EQ(inputs.size(), 1);
+            EXPECT_EQ(inputs[0].action, 2);
+            EXPECT_TRUE(track.getInputs(1.5, 2).empty());
+        }
+
+        TEST(PerformanceToolkitBenchmarkReportTest, makeBenchmarkResultShouldAggregateFrames)
+        {
+            std::vector<FrameStats> frames;
+            for (int i = 1; i <= 100; ++i)
+                frames.push_back(makeFrame(0.001f * static_cast<float>(i)));
+
+            const BenchmarkResult result = makeBenchmarkResult("scene", std::move(frames), {});
+
+            EXPECT_EQ(result.sceneName, "scene");
+            EXPECT_EQ(result.totalFrames, 100);
+            EXPECT_FLOAT_EQ(result.avgFrameTime, 0.0505f);
+            EXPECT_FLOAT_EQ(result.maxFrameTime, 0.1f);
+            EXPECT_FLOAT_EQ(result.p99FrameTime, 0.1f);
+            EXPECT_FLOAT_EQ(result.minFps, 10);
+            ASSERT_FALSE(result.timings.empty());
+            EXPECT_EQ(result.timings[0].name, "cpuMain");
+            EXPECT_NEAR(result.timings[0].avgTime, 0.02525, 1e-6);
+        }
+
+        TEST(PerformanceToolkitBenchmarkReportTest, makeBenchmarkResultShouldIgnoreMissingSubsystemTimes)
+        {
+            constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+            std::vector<FrameStats> frames;
+            frames.push_back(makeFrame(0.01f, { 0.002, nan }));
+            frames.push_back(makeFrame(0.01f, { 0.004, nan }));
+            const std::vector<std::string> names{ "input", "physicsworker" };
+
+            const BenchmarkResult result = makeBenchmarkResult("scene", std::move(frames), names);
+
+            ASSERT_EQ(result.timings.size(), 5);
+            EXPECT_EQ(result.timings.back().name, "input");
+            EXPECT_DOUBLE_EQ(result.timings.back().avgTime, 0.003);
+            EXPECT_DOUBLE_EQ(result.timings.back().maxTime, 0.004);
+        }
+
+        TEST(PerformanceToolkitBenchmarkReportTest, makeBenchmarkResultShouldHandleNoFrames)
+        {
+            const BenchmarkResult result = makeBenchmarkResult("scene", {}, {});
+            EXPECT_EQ(result.totalFrames, 0);
+            EXPECT_EQ(result.avgFps, 0);
+            EXPECT_TRUE(result.timings.empty());
+        }
+
+        TEST(PerformanceToolkitBenchmarkReportTest, writeBenchmarkResultShouldWriteJson)
+        {
+            std::vector<FrameStats> frames{ makeFrame(0.5f, { 0.25 }) };
+            const std::vector<std::string> names{ "in\"put" };
+            const BenchmarkResult result = makeBenchmarkResult("scene", std::move(frames), names);
+
+            std::ostringstream stream;
+            writeBenchmarkResult(result, stream);
+
+            EXPECT_EQ(stream.str(),
+                "{\n"
+                "  \"scene\": \"scene\",\n"
+                "  \"avgFps\": 2,\n"
+                "  \"minFps\": 2,\n"
+                "  \"avgFrameTime\": 0.5,\n"
+                "  \"maxFrameTime\": 0.5,\n"
+                "  \"p99FrameTime\": 0.5,\n"
+                "  \"totalFrames\": 1,\n"
+                "  \"timings\": {\n"
+                "    \"cpuMain\": { \"avg\": 0.25, \"max\": 0.25, \"p99\": 0.25 },\n"
+                "    \"cpuCull\": { \"avg\": 0, \"max\": 0, \"p99\": 0 },\n"
+                "    \"cpuDraw\": { \"avg\": 0, \"max\": 0, \"p99\": 0 },\n"
+                "    \"gpu\": { \"avg\": 0, \"max\": 0, \"p99\": 0 },\n"
+                "    \"in\\\"put\": { \"avg\": 0.25, \"max\": 0.25, \"p99\": 0.25 }\n"
+                "  }\n"
+                "}\n");
+        }
+    }
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <components/misc/jobsystem.hpp>
+
+#include "performance_toolkit/occlusion/occlusion_rasterizer.hpp"
+
+#include <array>
+#include <vector>
+
+namespace PerformanceToolkit
+{
+    namespace
+    {
+        // Perspective projection with 90 degrees vertical field of view and square aspect ratio looking along -z
+        OcclusionMatrix makeProjection()
+        {
+            constexpr float near = 1;
+            constexpr float far = 1000;
+            OcclusionMatrix result{};
+            result[0] = 1;
+            result[5] = 1;
+            result[10] = (near + far) / (near - far);
+            result[11] = -1;
+            result[14] = 2 * near * far / (near - far);
+            return result;
+        }
+
+        struct Mesh
+        {
+            std::vector<OcclusionVertex> mVertices;
+            std::vector<unsigned> mIndices;
+        };
+
+        // Rectangle in a plane perpendicular to the view direction at the given distance
+        Mesh makeRectangle(float minX, float minY, float maxX, float maxY, float distance)
+        {
+            return Mesh{
+                .mVertices = {
+                    { minX, minY, -distance },
+                    { maxX, minY, -distance },
+                    { maxX, maxY, -distance },
+                    { minX, maxY, -distance },
+                },
+                .mIndices = { 0, 1, 2, 0, 2, 3 },
+            };
+        }
+
+        struct PerformanceToolkitOcclusionRasterizerTest : ::testing::Test
+        {
+            const OcclusionMatrix mProjection = makeProjection();
+            OcclusionRasterizer mRasterizer{ 64, 32 };
+
+            void addOccluder(const Mesh& mesh) { mRasterizer.addOccluder(mesh.mVertices, mesh.mIndices, mProjection); }
+
+            bool isOccluded(const OcclusionVertex& min, const OcclusionVertex& max) const
+            {
+                return mRasterizer.isOccluded(min, max, mProjection);
+            }
+        };
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, nothingShouldBeOccludedWithoutOccluders)
+        {
+            mRasterizer.render();
+            EXPECT_FALSE(isOccluded({ -1, -1, -101 }, { 1, 1, -100 }));
+        }
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, boxBehindOccluderShouldBeOccluded)
+        {
+            addOccluder(makeRectangle(-20, -20, 20, 20, 10));
+            mRasterizer.render();
+            EXPECT_TRUE(isOccluded({ -1, -1, -101 }, { 1, 1, -100 }));
+        }
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, boxInFrontOfOccluderShouldNotBeOccluded)
+        {
+            addOccluder(makeRectangle(-20, -20, 20, 20, 10));
+            mRasterizer.render();
+            EXPECT_FALSE(isOccluded({ -1, -1, -6 }, { 1, 1, -5 }));
+        }
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, boxIntersectingOccluderShouldNotBeOccluded)
+        {
+            addOccluder(makeRectangle(-20, -20, 20, 20, 10));
+            mRasterizer.render();
+            EXPECT_FALSE(isOccluded({ -1, -1, -11 }, { 1, 1, -9 }));
+        }
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, boxPartiallyBehindOccluderShouldNotBeOccluded)
+        {
+            addOccluder(makeRectangle(0, -20, 20, 20, 10));
+            mRasterizer.render();
+            EXPECT_TRUE(isOccluded({ 10, -1, -101 }, { 12, 1, -100 }));
+            EXPECT_FALSE(isOccluded({ -10, -1, -101 }, { 10, 1, -100 }));
+        }
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, boxCrossingNearPlaneShouldNotBeOccluded)
+        {
+            addOccluder(makeRectangle(-20, -20, 20, 20, 10));
+            mRasterizer.render();
+            EXPECT_FALSE(isOccluded({ -1, -1, -100 }, { 1, 1, 1 }));
+        }
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, occluderCrossingNearPlaneShouldBeIgnored)
+        {
+            const Mesh mesh{
+                .mVertices = { { -20, -20, 1 }, { 20, -20, -10 }, { 20, 20, -10 }, { -20, 20, 1 } },
+                .mIndices = { 0, 1, 2, 0, 2, 3 },
+            };
+            addOccluder(mesh);
+            EXPECT_EQ(mRasterizer.getNumTriangles(), 0);
+        }
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, partiallyCoveredPixelsShouldNotBeWritten)
+        {
+            // Covers pixels from the left edge of the screen to the center of the pixel column 16
+            addOccluder(makeRectangle(-20, -20, -0.484375f * 10, 20, 10));
+            mRasterizer.render();
+            EXPECT_GT(mRasterizer.getDepth(15, 16), 0);
+            EXPECT_EQ(mRasterizer.getDepth(16, 16), 0);
+        }
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, partiallyCoveredPixelsAtSilhouetteEdgeShouldNotBeWritten)
+        {
+            // Both triangles are on the left of the shared edge crossing the center of the pixel column 16
+            const float edgeX = -0.484375f * 10;
+            const Mesh mesh{
+                .mVertices = { { edgeX, -20, -10 }, { -20, 0, -10 }, { edgeX, 20, -10 }, { -20, 0, -20 } },
+                .mIndices = { 0, 1, 2, 0, 2, 3 },
+            };
+            addOccluder(mesh);
+            mRasterizer.render();
+            EXPECT_GT(mRasterizer.getDepth(15, 16), 0);
+            EXPECT_EQ(mRasterizer.getDepth(16, 16), 0);
+        }
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, writtenDepthShouldNotBeNearerThanOccluder)
+        {
+            addOccluder(makeRectangle(-20, -20, 20, 20, 10));
+            mRasterizer.render();
+            for (unsigned y = 0; y < mRasterizer.getHeight(); ++y)
+                for (unsigned x = 0; x < mRasterizer.getWidth(); ++x)
+                    EXPECT_LE(mRasterizer.getDepth(x, y), 0.1f) << x << " " << y;
+        }
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, nearestOccluderShouldBeKeptIndependentOfOrder)
+        {
+            OcclusionRasterizer reversed(64, 32);
+            const Mesh near = makeRectangle(-5, -5, 5, 5, 10);
+            const Mesh far = makeRectangle(-50, -50, 50, 50, 50);
+            addOccluder(near);
+            addOccluder(far);
+            mRasterizer.render();
+            reversed.addOccluder(far.mVertices, far.mIndices, mProjection);
+            reversed.addOccluder(near.mVertices, near.mIndices, mProjection);
+            reversed.render();
+            EXPECT_FLOAT_EQ(mRasterizer.getDepth(32, 16), 0.1f);
+            for (unsigned y = 0; y < mRasterizer.getHeight(); ++y)
+                for (unsigned x = 0; x < mRasterizer.getWidth(); ++x)
+                    EXPECT_EQ(mRasterizer.getDepth(x, y), reversed.getDepth(x, y)) << x << " " << y;
+        }
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, renderOnJobSystemShouldProduceSameResult)
+        {
+            Misc::JobSystem jobSystem(3);
+            OcclusionRasterizer parallel(64, 32);
+            const Mesh slope{
+                .mVertices = { { -30, -30, -5 }, { 30, -30, -40 }, { 30, 30, -40 }, { -30, 30, -5 } },
+                .mIndices = { 0, 1, 2, 0, 2, 3 },
+            };
+            addOccluder(slope);
+            mRasterizer.render();
+            parallel.addOccluder(slope.mVertices, slope.mIndices, mProjection);
+            parallel.render(&jobSystem);
+            for (unsigned y = 0; y < mRasterizer.getHeight(); ++y)
+                for (unsigned x = 0; x < mRasterizer.getWidth(); ++x)
+                    EXPECT_EQ(mRasterizer.getDepth(x, y), parallel.getDepth(x, y)) << x << " " << y;
+        }
+
+        TEST_F(PerformanceToolkitOcclusionRasterizerTest, clearShouldResetDepthAndOccluders)
+        {
+            addOccluder(makeRectangle(-20, -20, 20, 20, 10));
+            mRasterizer.render();
+            mRasterizer.clear();
+            EXPECT_EQ(mRasterizer.getNumTriangles(), 0);
+            EXPECT_EQ(mRasterizer.getDepth(32, 16), 0);
+            EXPECT_FALSE(isOccluded({ -1, -1, -101 }, { 1, 1, -100 }));
+        }
+    }
+}
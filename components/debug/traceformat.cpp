@@ -0,0 +1,245 @@
+#include "traceformat.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Debug::Tracing
+{
+    namespace
+    {
+        constexpr std::uint32_t processId = 1;
+
+        std::uint64_t getOrigin(std::span<const ThreadTrace> threads)
+        {
+            std::uint64_t result = std::numeric_limits<std::uint64_t>::max();
+            for (const ThreadTrace& thread : threads)
+                for (const TraceEvent& event : thread.mEvents)
+                    result = std::min(result, event.mBegin);
+            return result == std::numeric_limits<std::uint64_t>::max() ? 0 : result;
+        }
+
+        // Events with the outer zones first, as required to reconstruct nesting
+        std::vector<TraceEvent> sortByBegin(const std::vector<TraceEvent>& events)
+        {
+            std::vector<TraceEvent> result = events;
+            std::sort(result.begin(), result.end(), [](const TraceEvent& l, const TraceEvent& r) {
+                if (l.mBegin != r.mBegin)
+                    return l.mBegin < r.mBegin;
+                return l.mEnd > r.mEnd;
+            });
+            return result;
+        }
+
+        void writeJsonString(std::string_view value, std::ostream& stream)
+        {
+            stream << '"';
+            for (const char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    stream << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                           << std::dec;
+                else
+                    stream << c;
+            }
+            stream << '"';
+        }
+
+        // Microseconds with nanosecond precision without relying on the stream locale
+        void writeMicroseconds(std::uint64_t nanoseconds, std::ostream& stream)
+        {
+            stream << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000;
+        }
+
+        namespace Proto
+        {
+            enum WireType : std::uint32_t
+            {
+                Varint = 0,
+                LengthDelimited = 2,
+            };
+
+            // Field numbers from perfetto/protos/perfetto/trace
+            constexpr std::uint32_t tracePacket = 1;
+            constexpr std::uint32_t tracePacketTimestamp = 8;
+            constexpr std::uint32_t tracePacketTrustedPacketSequenceId = 10;
+            constexpr std::uint32_t tracePacketTrackEvent = 11;
+            constexpr std::uint32_t tracePacketSequenceFlags = 13;
+            constexpr std::uint32_t tracePacketTrackDescriptor = 60;
+            constexpr std::uint32_t trackDescriptorUuid = 1;
+            constexpr std::uint32_t trackDescriptorThread = 4;
+            constexpr std::uint32_t threadDescriptorPid = 1;
+            constexpr std::uint32_t threadDescriptorTid = 2;
+            constexpr std::uint32_t threadDescriptorThreadName = 5;
+            constexpr std::uint32_t trackEventType = 9;
+            constexpr std::uint32_t trackEventTrackUuid = 11;
+            constexpr std::uint32_t trackEventName = 23;
+
+            constexpr std::uint64_t typeSliceBegin = 1;
+            constexpr std::uint64_t typeSliceEnd = 2;
+            constexpr std::uint64_t seqIncrementalStateCleared = 1;
+
+            constexpr std::uint32_t sequenceId = 1;
+
+            void writeVarint(std::uint64_t value, std::string& out)
+            {
+                while (value >= 0x80)
+                {
+                    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+                    value >>= 7;
+                }
+                out.push_back(static_cast<char>(value));
+            }
+
+            void writeVarintField(std::uint32_t field, std::uint64_t value, std::string& out)
+            {
+                writeVarint((field << 3) | Varint, out);
+                writeVarint(value, out);
+            }
+
+            void writeBytesField(std::uint32_t field, std::string_view value, std::string& out)
+            {
+                writeVarint((field << 3) | LengthDelimited, out);
+                writeVarint(value.size(), out);
+                out.append(value);
+            }
+        }
+
+        std::uint64_t getTrackUuid(const ThreadTrace& thread)
+        {
+            return (std::uint64_t{ processId } << 32) | thread.mId;
+        }
+
+        class PerfettoWriter
+        {
+        public:
+            explicit PerfettoWriter(std::ostream& stream)
+                : mStream(stream)
+            {
+            }
+
+            void writeThreadDescriptor(const ThreadTrace& thread)
+            {
+                std::string descriptor;
+                Proto::writeVarintField(Proto::threadDescriptorPid, processId, descriptor);
+                Proto::writeVarintField(Proto::threadDescriptorTid, thread.mId, descriptor);
+                Proto::writeBytesField(Proto::threadDescriptorThreadName, thread.mName, descriptor);
+
+                std::string track;
+                Proto::writeVarintField(Proto::trackDescriptorUuid, getTrackUuid(thread), track);
+                Proto::writeBytesField(Proto::trackDescriptorThread, descriptor, track);
+
+                std::string packet;
+                Proto::writeBytesField(Proto::tracePacketTrackDescriptor, track, packet);
+                writePacket(packet);
+            }
+
+            void writeSlice(std::uint64_t type, std::uint64_t trackUuid, std::uint64_t timestamp, const char* name)
+            {
+                std::string event;
+                Proto::writeVarintField(Proto::trackEventType, type, event);
+                Proto::writeVarintField(Proto::trackEventTrackUuid, trackUuid, event);
+                if (name != nullptr)
+                    Proto::writeBytesField(Proto::trackEventName, name, event);
+
+                std::string packet;
+                Proto::writeVarintField(Proto::tracePacketTimestamp, timestamp, packet);
+                Proto::writeBytesField(Proto::tracePacketTrackEvent, event, packet);
+                writePacket(packet);
+            }
+
+        private:
+            std::ostream& mStream;
+            std::string mBuffer;
+            bool mFirst = true;
+
+            void writePacket(std::string& packet)
+            {
+                Proto::writeVarintField(Proto::tracePacketTrustedPacketSequenceId, Proto::sequenceId, packet);
+                if (mFirst)
+                {
+                    Proto::writeVarintField(
+                        Proto::tracePacketSequenceFlags, Proto::seqIncrementalStateCleared, packet);
+                    mFirst = false;
+                }
+                mBuffer.clear();
+                Proto::writeBytesField(Proto::tracePacket, packet, mBuffer);
+                mStream.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+            }
+        };
+    }
+
+    void writeChromeTrace(std::span<const ThreadTrace> threads, std::ostream& stream)
+    {
+        const std::uint64_t origin = getOrigin(threads);
+        bool first = true;
+        const auto separate = [&] {
+            if (!first)
+                stream << ",\n";
+            first = false;
+        };
+
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+        for (const ThreadTrace& thread : threads)
+        {
+            separate();
+            stream << R"({"name":"thread_name","ph":"M","pid":)" << processId << R"(,"tid":)" << thread.mId
+                   << R"(,"args":{"name":)";
+            writeJsonString(thread.mName, stream);
+            stream << "}}";
+
+            for (const TraceEvent& event : sortByBegin(thread.mEvents))
+            {
+                separate();
+                stream << R"({"name":)";
+                writeJsonString(event.mName, stream);
+                stream << R"(,"ph":"X","pid":)" << processId << R"(,"tid":)" << thread.mId << R"(,"ts":)";
+                writeMicroseconds(event.mBegin - origin, stream);
+                stream << R"(,"dur":)";
+                writeMicroseconds(event.mEnd - event.mBegin, stream);
+                stream << '}';
+            }
+        }
+
+        stream << "\n]}\n";
+    }
+
+    void writePerfettoTrace(std::span<const ThreadTrace> threads, std::ostream& stream)
+    {
+        const std::uint64_t origin = getOrigin(threads);
+        PerfettoWriter writer(stream);
+
+        for (const ThreadTrace& thread : threads)
+        {
+            const std::uint64_t trackUuid = getTrackUuid(thread);
+            writer.writeThreadDescriptor(thread);
+
+            // Zones of a thread are nested, close the finished ones before opening the next
+            std::vector<std::uint64_t> ends;
+            for (const TraceEvent& event : sortByBegin(thread.mEvents))
+            {
+                while (!ends.empty() && ends.back() <= event.mBegin)
+                {
+                    writer.writeSlice(Proto::typeSliceEnd, trackUuid, ends.back() - origin, nullptr);
+                    ends.pop_back();
+                }
+                writer.writeSlice(Proto::typeSliceBegin, trackUuid, event.mBegin - origin, event.mName);
+                // Clamp zones overlapping the enclosing one which is possible only when some events are lost
+                ends.push_back(ends.empty() ? event.mEnd : std::min(event.mEnd, ends.back()));
+            }
+            while (!ends.empty())
+            {
+                writer.writeSlice(Proto::typeSliceEnd, trackUuid, ends.back() - origin, nullptr);
+                ends.pop_back();
+            }
+        }
+    }
+}
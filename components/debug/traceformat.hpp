@@ -0,0 +1,18 @@
+#ifndef OPENMW_COMPONENTS_DEBUG_TRACEFORMAT_H
+#define OPENMW_COMPONENTS_DEBUG_TRACEFORMAT_H
+
+#include "tracing.hpp"
+
+#include <iosfwd>
+#include <span>
+
+namespace Debug::Tracing
+{
+    // Trace Event Format with complete events, supported by chrome://tracing and ui.perfetto.dev
+    void writeChromeTrace(std::span<const ThreadTrace> threads, std::ostream& stream);
+
+    // Perfetto TracePacket stream with a track per thread and slice begin/end events
+    void writePerfettoTrace(std::span<const ThreadTrace> threads, std::ostream& stream);
+}
+
+#endif
@@ -0,0 +1,217 @@
+#include "tracing.hpp"
+
+#include "debuglog.hpp"
+#include "traceformat.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <system_error>
+
+namespace Debug::Tracing
+{
+    namespace
+    {
+        constexpr std::uint64_t invalidIndex = std::numeric_limits<std::uint64_t>::max();
+
+        // Index of the event is written after the fields to detect the slot being overwritten while copying
+        struct Slot
+        {
+            std::atomic_uint64_t mIndex{ invalidIndex };
+            std::atomic<const char*> mName{ nullptr };
+            std::atomic_uint64_t mBegin{ 0 };
+            std::atomic_uint64_t mEnd{ 0 };
+        };
+
+        // Ring buffer written only by the owning thread
+        struct ThreadBuffer
+        {
+            const std::uint32_t mId;
+            std::vector<Slot> mSlots;
+            std::atomic_uint64_t mCount{ 0 };
+            // Guarded by Registry::mMutex
+            std::string mName;
+            std::uint64_t mCollectFrom = 0;
+
+            explicit ThreadBuffer(std::uint32_t id, std::size_t size, std::string name)
+                : mId(id)
+                , mSlots(size)
+                , mName(std::move(name))
+            {
+            }
+        };
+
+        struct Registry
+        {
+            std::mutex mMutex;
+            // Buffers stay after the thread is finished to be collected
+            std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+            std::size_t mBufferSize = 64 * 1024;
+            std::filesystem::path mOutputPath = "trace";
+        };
+
+        Registry& getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        thread_local ThreadBuffer* sThreadBuffer = nullptr;
+        thread_local std::string sThreadName;
+
+        ThreadBuffer& getThreadBuffer()
+        {
+            if (sThreadBuffer != nullptr)
+                return *sThreadBuffer;
+            Registry& registry = getRegistry();
+            const std::lock_guard lock(registry.mMutex);
+            const auto id = static_cast<std::uint32_t>(registry.mBuffers.size() + 1);
+            std::string name = sThreadName.empty() ? "Thread " + std::to_string(id) : sThreadName;
+            const std::size_t size = std::bit_ceil(std::max<std::size_t>(registry.mBufferSize, 1));
+            registry.mBuffers.push_back(std::make_unique<ThreadBuffer>(id, size, std::move(name)));
+            sThreadBuffer = registry.mBuffers.back().get();
+            return *sThreadBuffer;
+        }
+
+        std::vector<TraceEvent> copyEvents(const ThreadBuffer& buffer, std::uint64_t from)
+        {
+            const std::uint64_t size = buffer.mSlots.size();
+            const std::uint64_t end = buffer.mCount.load(std::memory_order_acquire);
+            const std::uint64_t begin = std::max(from, end > size ? end - size : 0);
+
+            std::vector<TraceEvent> result;
+            result.reserve(end - std::min(begin, end));
+            for (std::uint64_t i = begin; i < end; ++i)
+            {
+                const Slot& slot = buffer.mSlots[i & (size - 1)];
+                if (slot.mIndex.load(std::memory_order_acquire) != i)
+                    continue;
+                const TraceEvent event{
+                    .mName = slot.mName.load(std::memory_order_relaxed),
+                    .mBegin = slot.mBegin.load(std::memory_order_relaxed),
+                    .mEnd = slot.mEnd.load(std::memory_order_relaxed),
+                };
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.mIndex.load(std::memory_order_relaxed) == i)
+                    result.push_back(event);
+            }
+
+            return result;
+        }
+
+        void writeFile(const std::filesystem::path& path, auto&& write)
+        {
+            std::ofstream stream(path, std::ios::binary);
+            if (!stream.is_open())
+            {
+                Log(Debug::Error) << "Failed to open trace file " << path << ": "
+                                  << std::generic_category().message(errno);
+                return;
+            }
+            write(stream);
+            Log(Debug::Info) << "Trace is written to " << path;
+        }
+    }
+
+    namespace Detail
+    {
+        std::atomic_bool sEnabled{ false };
+
+        std::uint64_t now()
+        {
+            const auto time = std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+        }
+
+        void record(const char* name, std::uint64_t begin, std::uint64_t end)
+        {
+            ThreadBuffer& buffer = getThreadBuffer();
+            const std::uint64_t index = buffer.mCount.load(std::memory_order_relaxed);
+            Slot& slot = buffer.mSlots[index & (buffer.mSlots.size() - 1)];
+            slot.mIndex.store(invalidIndex, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.mName.store(name, std::memory_order_relaxed);
+            slot.mBegin.store(begin, std::memory_order_relaxed);
+            slot.mEnd.store(end, std::memory_order_relaxed);
+            slot.mIndex.store(index, std::memory_order_release);
+            buffer.mCount.store(index + 1, std::memory_order_release);
+        }
+    }
+
+    void setEnabled(bool value)
+    {
+        Detail::sEnabled.store(value, std::memory_order_relaxed);
+    }
+
+    void setBufferSize(std::size_t value)
+    {
+        Registry& registry = getRegistry();
+        const std::lock_guard lock(registry.mMutex);
+        registry.mBufferSize = value;
+    }
+
+    void setThreadName(std::string_view name)
+    {
+        sThreadName = name;
+        if (sThreadBuffer == nullptr)
+            return;
+        Registry& registry = getRegistry();
+        const std::lock_guard lock(registry.mMutex);
+        sThreadBuffer->mName = name;
+    }
+
+    std::vector<ThreadTrace> collect()
+    {
+        Registry& registry = getRegistry();
+        const std::lock_guard lock(registry.mMutex);
+        std::vector<ThreadTrace> result;
+        result.reserve(registry.mBuffers.size());
+        for (const std::unique_ptr<ThreadBuffer>& buffer : registry.mBuffers)
+            result.push_back(ThreadTrace{
+                .mId = buffer->mId,
+                .mName = buffer->mName,
+                .mEvents = copyEvents(*buffer, buffer->mCollectFrom),
+            });
+        return result;
+    }
+
+    void clear()
+    {
+        Registry& registry = getRegistry();
+        const std::lock_guard lock(registry.mMutex);
+        for (const std::unique_ptr<ThreadBuffer>& buffer : registry.mBuffers)
+            buffer->mCollectFrom = buffer->mCount.load(std::memory_order_acquire);
+    }
+
+    void setOutputPath(const std::filesystem::path& value)
+    {
+        Registry& registry = getRegistry();
+        const std::lock_guard lock(registry.mMutex);
+        registry.mOutputPath = value;
+    }
+
+    void dump()
+    {
+        std::filesystem::path path;
+        {
+            Registry& registry = getRegistry();
+            const std::lock_guard lock(registry.mMutex);
+            path = registry.mOutputPath;
+        }
+
+        const std::vector<ThreadTrace> threads = collect();
+
+        std::filesystem::path chromePath = path;
+        chromePath += ".json";
+        writeFile(chromePath, [&](std::ostream& stream) { writeChromeTrace(threads, stream); });
+
+        std::filesystem::path perfettoPath = path;
+        perfettoPath += ".perfetto-trace";
+        writeFile(perfettoPath, [&](std::ostream& stream) { writePerfettoTrace(threads, stream); });
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef OPENMW_COMPONENTS_DEBUG_TRACING_H
+#define OPENMW_COMPONENTS_DEBUG_TRACING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Debug::Tracing
+{
+    namespace Detail
+    {
+        extern std::atomic_bool sEnabled;
+
+        std::uint64_t now();
+
+        void record(const char* name, std::uint64_t begin, std::uint64_t end);
+    }
+
+    // Zone recorded by a thread, times are in nanoseconds of the steady clock
+    struct TraceEvent
+    {
+        const char* mName;
+        std::uint64_t mBegin;
+        std::uint64_t mEnd;
+    };
+
+    struct ThreadTrace
+    {
+        std::uint32_t mId;
+        std::string mName;
+        // Sorted by end time
+        std::vector<TraceEvent> mEvents;
+    };
+
+    inline bool isEnabled()
+    {
+        return Detail::sEnabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool value);
+
+    // Number of the latest events kept per thread, rounded up to a power of 2. Applies to threads recording their
+    // first event after the call.
+    void setBufferSize(std::size_t value);
+
+    // Name of the calling thread in the exported traces
+    void setThreadName(std::string_view name);
+
+    // Copies events recorded by all threads since the last clear. Can be called while other threads record events.
+    std::vector<ThreadTrace> collect();
+
+    // Drops events recorded so far from the following collect results
+    void clear();
+
+    // Path without extension for the files written by dump
+    void setOutputPath(const std::filesystem::path& value);
+
+    // Writes collected events into Chrome trace JSON (.json) and Perfetto protobuf (.perfetto-trace) files
+    void dump();
+
+    // Records the time between construction and destruction when tracing is enabled. The name has to outlive the
+    // recorded events, use string literals.
+    class Zone
+    {
+    public:
+        explicit Zone(const char* name)
+            : mName(isEnabled() ? name : nullptr)
+            , mBegin(mName != nullptr ? Detail::now() : 0)
+        {
+        }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+        ~Zone()
+        {
+            if (mName != nullptr)
+                Detail::record(mName, mBegin, Detail::now());
+        }
+
+    private:
+        const char* const mName;
+        const std::uint64_t mBegin;
+    };
+}
+
+#define OPENMW_TRACE_CONCAT_IMPL(a, b) a##b
+#define OPENMW_TRACE_CONCAT(a, b) OPENMW_TRACE_CONCAT_IMPL(a, b)
+
+#define OPENMW_TRACE_ZONE(name) const ::Debug::Tracing::Zone OPENMW_TRACE_CONCAT(openmwTraceZone, __LINE__)(name)
+
+#endif
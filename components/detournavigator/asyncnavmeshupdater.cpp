@@ -8,6 +8,7 @@
 #include "version.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/strings/conversion.hpp>
 #include <components/misc/thread.hpp>
@@ -452,6 +453,7 @@ namespace DetourNavigator
     {
         Log(Debug::Debug) << "Start process navigator jobs by thread=" << std::this_thread::get_id();
         Misc::setCurrentThreadIdlePriority();
+        Debug::Tracing::setThreadName("NavMeshUpdater");
         while (!mShouldStop)
         {
             if (JobIt job = getNextJob(); job != mJobs.end())
@@ -502,6 +504,8 @@ namespace DetourNavigator
 
     JobStatus AsyncNavMeshUpdater::processJob(Job& job)
     {
+        OPENMW_TRACE_ZONE("AsyncNavMeshUpdater::processJob");
+
         Log(Debug::Debug) << "Processing job " << job.mId << "  for worldspace=" << job.mWorldspace
                           << " agent=" << job.mAgentBounds << ""
                           << " changedTile=(" << job.mChangedTile << ")"
@@ -901,6 +905,7 @@ namespace DetourNavigator
 
     void DbWorker::run() noexcept
     {
+        Debug::Tracing::setThreadName("NavMeshDb");
         while (!mShouldStop)
         {
             try
@@ -917,6 +922,8 @@ namespace DetourNavigator
 
     void DbWorker::processJob(JobIt job)
     {
+        OPENMW_TRACE_ZONE("DbWorker::processJob");
+
         const auto process = [&](auto f) {
             try
             {
@@ -1,12 +1,16 @@
 #include "stringrefid.hpp"
 #include "serializerefid.hpp"
 
+#include <array>
+#include <atomic>
 #include <charconv>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <system_error>
-#include <unordered_set>
+#include <vector>
 
-#include "components/misc/guarded.hpp"
 #include "components/misc/strings/algorithm.hpp"
 #include "components/misc/utf8stream.hpp"
 
@@ -14,23 +18,117 @@ namespace ESM
 {
     namespace
     {
-        using StringsSet = std::unordered_set<std::string, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual>;
+        // Power of 2 to select a shard by the lower bits of the hash
+        constexpr std::size_t shardsCount = 64;
 
-        const std::string emptyString;
+        constexpr std::size_t initialTableSize = 64;
 
-        Misc::ScopeGuarded<StringsSet>& getRefIds()
+        // Function local to be initialized before use by default constructed ids of other static objects
+        const StringRefIdValue& getEmptyString()
         {
-            static Misc::ScopeGuarded<StringsSet> refIds;
-            return refIds;
+            static const StringRefIdValue value{ Misc::StringUtils::CiHash{}(std::string_view()), std::string() };
+            return value;
         }
 
-        Misc::NotNullPtr<const std::string> getOrInsertString(std::string_view id)
+        // Open addressing hash table of interned strings. Lookups are lock free, insertions are serialized by a mutex.
+        // Tables are never shrunk or freed to keep them valid for concurrent lookups after growing.
+        class Shard
         {
-            const auto locked = getRefIds().lock();
-            auto it = locked->find(id);
-            if (it == locked->end())
-                it = locked->emplace(id).first;
-            return &*it;
+        public:
+            Shard() { mTable.store(&mTables.emplace_back(initialTableSize), std::memory_order_release); }
+
+            const StringRefIdValue* find(std::string_view value, std::size_t hash) const
+            {
+                return find(*mTable.load(std::memory_order_acquire), value, hash);
+            }
+
+            const StringRefIdValue* getOrInsert(std::string_view value, std::size_t hash)
+            {
+                if (const StringRefIdValue* result = find(value, hash))
+                    return result;
+
+                const std::lock_guard lock(mMutex);
+
+                Table* table = mTable.load(std::memory_order_relaxed);
+                if (const StringRefIdValue* result = find(*table, value, hash))
+                    return result;
+
+                if ((mSize + 1) * 2 > table->size())
+                    table = grow(*table);
+
+                const StringRefIdValue& result = mValues.emplace_back(StringRefIdValue{ hash, std::string(value) });
+                insert(*table, result, std::memory_order_release);
+                ++mSize;
+
+                return &result;
+            }
+
+            std::size_t size() const
+            {
+                const std::lock_guard lock(mMutex);
+                return mSize;
+            }
+
+        private:
+            using Table = std::vector<std::atomic<const StringRefIdValue*>>;
+
+            mutable std::mutex mMutex;
+            std::atomic<Table*> mTable;
+            std::deque<Table> mTables;
+            std::deque<StringRefIdValue> mValues;
+            std::size_t mSize = 0;
+
+            static std::size_t getFirstSlot(const Table& table, std::size_t hash)
+            {
+                return (hash / shardsCount) & (table.size() - 1);
+            }
+
+            static const StringRefIdValue* find(const Table& table, std::string_view value, std::size_t hash)
+            {
+                for (std::size_t i = getFirstSlot(table, hash);; i = (i + 1) & (table.size() - 1))
+                {
+                    const StringRefIdValue* const slot = table[i].load(std::memory_order_acquire);
+                    if (slot == nullptr)
+                        return nullptr;
+                    if (slot->mHash == hash && Misc::StringUtils::ciEqual(slot->mValue, value))
+                        return slot;
+                }
+            }
+
+            static void insert(Table& table, const StringRefIdValue& value, std::memory_order order)
+            {
+                std::size_t i = getFirstSlot(table, value.mHash);
+                while (table[i].load(std::memory_order_relaxed) != nullptr)
+                    i = (i + 1) & (table.size() - 1);
+                table[i].store(&value, order);
+            }
+
+            Table* grow(const Table& table)
+            {
+                Table& result = mTables.emplace_back(table.size() * 2);
+                for (const std::atomic<const StringRefIdValue*>& slot : table)
+                    if (const StringRefIdValue* const value = slot.load(std::memory_order_relaxed))
+                        insert(result, *value, std::memory_order_relaxed);
+                mTable.store(&result, std::memory_order_release);
+                return &result;
+            }
+        };
+
+        std::array<Shard, shardsCount>& getShards()
+        {
+            static std::array<Shard, shardsCount> shards;
+            return shards;
+        }
+
+        Shard& getShard(std::size_t hash)
+        {
+            return getShards()[hash & (shardsCount - 1)];
+        }
+
+        Misc::NotNullPtr<const StringRefIdValue> getOrInsertString(std::string_view id)
+        {
+            const std::size_t hash = Misc::StringUtils::CiHash{}(id);
+            return getShard(hash).getOrInsert(id, hash);
         }
 
         void addHex(unsigned char value, std::string& result)
@@ -47,7 +145,7 @@ namespace ESM
     }
 
     StringRefId::StringRefId()
-        : mValue(&emptyString)
+        : mValue(&getEmptyString())
     {
     }
 
@@ -58,22 +156,22 @@ namespace ESM
 
     bool StringRefId::operator==(std::string_view rhs) const noexcept
     {
-        return Misc::StringUtils::ciEqual(*mValue, rhs);
+        return Misc::StringUtils::ciEqual(mValue->mValue, rhs);
     }
 
     bool StringRefId::operator<(StringRefId rhs) const noexcept
     {
-        return Misc::StringUtils::ciLess(*mValue, *rhs.mValue);
+        return Misc::StringUtils::ciLess(mValue->mValue, rhs.mValue->mValue);
     }
 
     bool operator<(StringRefId lhs, std::string_view rhs) noexcept
     {
-        return Misc::StringUtils::ciLess(*lhs.mValue, rhs);
+        return Misc::StringUtils::ciLess(lhs.mValue->mValue, rhs);
     }
 
     bool operator<(std::string_view lhs, StringRefId rhs) noexcept
     {
-        return Misc::StringUtils::ciLess(lhs, *rhs.mValue);
+        return Misc::StringUtils::ciLess(lhs, rhs.mValue->mValue);
     }
 
     std::ostream& operator<<(std::ostream& stream, StringRefId value)
@@ -84,10 +182,11 @@ namespace ESM
     std::string StringRefId::toDebugString() const
     {
         std::string result;
-        result.reserve(2 + mValue->size());
+        result.reserve(2 + mValue->mValue.size());
         result.push_back('"');
-        const unsigned char* ptr = reinterpret_cast<const unsigned char*>(mValue->data());
-        const unsigned char* const end = reinterpret_cast<const unsigned char*>(mValue->data() + mValue->size());
+        const unsigned char* ptr = reinterpret_cast<const unsigned char*>(mValue->mValue.data());
+        const unsigned char* const end
+            = reinterpret_cast<const unsigned char*>(mValue->mValue.data() + mValue->mValue.size());
         while (ptr != end)
         {
             if (Utf8Stream::isAscii(*ptr))
@@ -119,32 +218,35 @@ namespace ESM
 
     bool StringRefId::startsWith(std::string_view prefix) const
     {
-        return Misc::StringUtils::ciStartsWith(*mValue, prefix);
+        return Misc::StringUtils::ciStartsWith(mValue->mValue, prefix);
     }
 
     bool StringRefId::endsWith(std::string_view suffix) const
     {
-        return Misc::StringUtils::ciEndsWith(*mValue, suffix);
+        return Misc::StringUtils::ciEndsWith(mValue->mValue, suffix);
     }
 
     bool StringRefId::contains(std::string_view subString) const
     {
-        return Misc::StringUtils::ciFind(*mValue, subString) != std::string_view::npos;
+        return Misc::StringUtils::ciFind(mValue->mValue, subString) != std::string_view::npos;
     }
 
     std::optional<StringRefId> StringRefId::deserializeExisting(std::string_view value)
     {
-        const auto locked = getRefIds().lock();
-        auto it = locked->find(value);
-        if (it == locked->end())
+        const std::size_t hash = Misc::StringUtils::CiHash{}(value);
+        const StringRefIdValue* const existing = getShard(hash).find(value, hash);
+        if (existing == nullptr)
             return {};
         StringRefId id;
-        id.mValue = &*it;
+        id.mValue = existing;
         return id;
     }
 
     std::size_t StringRefId::totalCount()
     {
-        return getRefIds().lock()->size();
+        std::size_t result = 0;
+        for (const Shard& shard : getShards())
+            result += shard.size();
+        return result;
     }
 }
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_ESM_STRINGREFID_HPP
 #define OPENMW_COMPONENTS_ESM_STRINGREFID_HPP
 
+#include <cstddef>
 #include <functional>
 #include <iosfwd>
 #include <optional>
@@ -11,6 +12,13 @@
 
 namespace ESM
 {
+    // Interned string with precomputed case-insensitive hash. Never moved or destroyed once created.
+    struct StringRefIdValue
+    {
+        std::size_t mHash;
+        std::string mValue;
+    };
+
     class StringRefId
     {
     public:
@@ -19,9 +27,9 @@ namespace ESM
         // Constructs StringRefId from string using pointer to a static set of strings.
         explicit StringRefId(std::string_view value);
 
-        const std::string& getValue() const { return *mValue; }
+        const std::string& getValue() const { return mValue->mValue; }
 
-        std::string toString() const { return *mValue; }
+        std::string toString() const { return mValue->mValue; }
 
         std::string toDebugString() const;
 
@@ -52,7 +60,7 @@ namespace ESM
         static std::size_t totalCount();
 
     private:
-        Misc::NotNullPtr<const std::string> mValue;
+        Misc::NotNullPtr<const StringRefIdValue> mValue;
     };
 }
 
@@ -61,10 +69,7 @@ namespace std
     template <>
     struct hash<ESM::StringRefId>
     {
-        std::size_t operator()(ESM::StringRefId value) const noexcept
-        {
-            return std::hash<const std::string*>{}(value.mValue);
-        }
+        std::size_t operator()(ESM::StringRefId value) const noexcept { return value.mValue->mHash; }
     };
 }
 
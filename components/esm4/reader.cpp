@@ -534,13 +534,13 @@ namespace ESM4
             const std::streamoff position = mStream->tellg();
 
             const std::uint32_t recordSize = mCtx.recordHeader.record.dataSize - sizeof(std::uint32_t);
-            std::vector<char> compressed(recordSize);
-            mStream->read(compressed.data(), recordSize);
+            mCompressedData.resize(recordSize);
+            mStream->read(mCompressedData.data(), recordSize);
             mSavedStream = std::move(mStream);
 
             mCtx.recordHeader.record.dataSize = uncompressedSize - sizeof(uncompressedSize);
 
-            auto memoryStreamPtr = decompress(position, compressed, uncompressedSize);
+            auto memoryStreamPtr = decompress(position, mCompressedData, uncompressedSize);
 
             // For debugging only
             // #if 0
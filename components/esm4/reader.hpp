@@ -29,6 +29,7 @@
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "cellgrid.hpp"
 #include "common.hpp"
@@ -156,6 +157,7 @@ namespace ESM4
 
         Files::IStreamPtr mStream;
         Files::IStreamPtr mSavedStream; // mStream is saved here while using deflated memory stream
+        std::vector<char> mCompressedData; // reused for all compressed records
 
         Files::IStreamPtr mStrings;
         Files::IStreamPtr mILStrings;
@@ -4,6 +4,8 @@
 #include "grouptype.hpp"
 #include "reader.hpp"
 
+#include <type_traits>
+
 namespace ESM4
 {
     struct ReaderUtils
@@ -13,7 +15,8 @@ namespace ESM4
         if the record was read or ignored. Will be invoked for every record
 
         GroupInvocable's invocable must take a ESM4::Reader& as input, doesn't need to output anything. Will be invoked
-        for every group*/
+        for every group. If it outputs a boolean, the group is skipped as a whole without reading any record header
+        when false is returned*/
         template <typename RecordInvocable, typename GroupInvocable>
         static void readAll(ESM4::Reader& reader, RecordInvocable&& recordInvocable, GroupInvocable&& groupInvocable)
         {
@@ -37,7 +40,16 @@ namespace ESM4
         {
             const ESM4::RecordHeader& header = reader.hdr();
 
-            groupInvocable(reader);
+            if constexpr (std::is_same_v<std::invoke_result_t<GroupInvocable&, ESM4::Reader&>, bool>)
+            {
+                if (!groupInvocable(reader))
+                {
+                    reader.skipGroup();
+                    return true;
+                }
+            }
+            else
+                groupInvocable(reader);
 
             switch (static_cast<ESM4::GroupType>(header.group.type))
             {
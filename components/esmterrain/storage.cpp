@@ -1,6 +1,7 @@
 #include "storage.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <optional>
 #include <stdexcept>
 
@@ -42,7 +43,20 @@ namespace ESMTerrain
 
             return { tex, land->getPlugin() };
         }
-    }
+
+        std::size_t getVerticesPerSide(int lodLevel, float size, ESM::RefId worldspace)
+        {
+            if (lodLevel < 0 || 63 < lodLevel)
+                throw std::invalid_argument("Invalid terrain lod level: " + std::to_string(lodLevel));
+
+            if (size <= 0)
+                throw std::invalid_argument("Invalid terrain size: " + std::to_string(size));
+
+            // LOD level n means every 2^n-th vertex is kept
+            const std::size_t sampleSize = std::size_t{ 1 } << lodLevel;
+            const std::size_t cellSize = static_cast<std::size_t>(ESM::getLandSize(worldspace));
+            return static_cast<std::size_t>(size * (cellSize - 1) / sampleSize) + 1;
+        }
 
     class LandCache
     {
@@ -242,23 +256,12 @@ namespace ESMTerrain
         }
     }
 
-    void Storage::fillVertexBuffers(int lodLevel, float size, const osg::Vec2f& center, ESM::RefId worldspace,
-        osg::Vec3Array& positions, osg::Vec3Array& normals, osg::Vec4ubArray& colours)
+    template <class F>
+    bool Storage::sampleVertices(int lodLevel, float size, const osg::Vec2f& center, ESM::RefId worldspace, F&& f)
     {
-        if (lodLevel < 0 || 63 < lodLevel)
-            throw std::invalid_argument("Invalid terrain lod level: " + std::to_string(lodLevel));
-
-        if (size <= 0)
-            throw std::invalid_argument("Invalid terrain size: " + std::to_string(size));
-
-        // LOD level n means every 2^n-th vertex is kept
         const std::size_t sampleSize = std::size_t{ 1 } << lodLevel;
         const std::size_t cellSize = static_cast<std::size_t>(ESM::getLandSize(worldspace));
-        const std::size_t numVerts = static_cast<std::size_t>(size * (cellSize - 1) / sampleSize) + 1;
-
-        positions.resize(numVerts * numVerts);
-        normals.resize(numVerts * numVerts);
-        colours.resize(numVerts * numVerts);
+        const std::size_t numVerts = getVerticesPerSide(lodLevel, size, worldspace);
 
         const bool alteration = useAlteration();
         const int landSizeInUnits = ESM::getCellSize(worldspace);
@@ -315,9 +318,8 @@ namespace ESMTerrain
 
             const std::size_t vertIndex = vertX * numVerts + vertY;
 
-            positions[vertIndex]
-                = osg::Vec3f((vertX / static_cast<float>(numVerts - 1) - 0.5f) * size * landSizeInUnits,
-                    (vertY / static_cast<float>(numVerts - 1) - 0.5f) * size * landSizeInUnits, height);
+            const osg::Vec3f position((vertX / static_cast<float>(numVerts - 1) - 0.5f) * size * landSizeInUnits,
+                (vertY / static_cast<float>(numVerts - 1) - 0.5f) * size * landSizeInUnits, height);
 
             const std::size_t srcArrayIndex = col * cellSize * 3 + row * 3;
 
@@ -341,8 +343,6 @@ namespace ESMTerrain
 
             assert(normal.z() > 0);
 
-            normals[vertIndex] = normal;
-
             osg::Vec4ub color(255, 255, 255, 255);
 
             if (colourData != nullptr)
@@ -357,7 +357,7 @@ namespace ESMTerrain
             if (col == cellSize - 1 || row == cellSize - 1)
                 fixColour(color, cellLocation, static_cast<int>(col), static_cast<int>(row), cache);
 
-            colours[vertIndex] = color;
+            f(vertIndex, position, normal, color);
         };
 
         const std::size_t beginX = static_cast<std::size_t>((origin.x() - startCellX) * cellSize);
@@ -366,10 +366,89 @@ namespace ESMTerrain
 
         sampleCellGrid(cellSize, sampleSize, beginX, beginY, distance, handleSample);
 
+        return validHeightDataExists;
+    }
+
+    void Storage::fillVertexBuffers(int lodLevel, float size, const osg::Vec2f& center, ESM::RefId worldspace,
+        osg::Vec3Array& positions, osg::Vec3Array& normals, osg::Vec4ubArray& colours)
+    {
+        const std::size_t numVerts = getVerticesPerSide(lodLevel, size, worldspace);
+
+        positions.resize(numVerts * numVerts);
+        normals.resize(numVerts * numVerts);
+        colours.resize(numVerts * numVerts);
+
+        const bool validHeightDataExists = sampleVertices(lodLevel, size, center, worldspace,
+            [&](std::size_t index, const osg::Vec3f& position, const osg::Vec3f& normal, const osg::Vec4ub& colour) {
+                positions[index] = position;
+                normals[index] = normal;
+                colours[index] = colour;
+            });
+
         if (!validHeightDataExists && ESM::isEsm4Ext(worldspace))
             std::fill(positions.begin(), positions.end(), osg::Vec3f());
     }
 
+    Terrain::CompactVertexDecode Storage::fillCompactVertexBuffers(int lodLevel, float size, const osg::Vec2f& center,
+        ESM::RefId worldspace, osg::Vec2sArray& vertices, osg::Vec4ubArray& colours)
+    {
+        const std::size_t numVerts = getVerticesPerSide(lodLevel, size, worldspace);
+
+        vertices.resize(numVerts * numVerts);
+        colours.resize(numVerts * numVerts);
+
+        // Heights are quantized before sampling, so the range is taken from the land records covering the chunk
+        float minHeight = 0;
+        float maxHeight = 0;
+        getHeightRange(size, center, worldspace, minHeight, maxHeight);
+        const Terrain::CompactVertexDecode decode = Terrain::CompactVertexDecode::fromRange(
+            size * static_cast<float>(ESM::getCellSize(worldspace)), minHeight, maxHeight);
+
+        const bool validHeightDataExists = sampleVertices(lodLevel, size, center, worldspace,
+            [&](std::size_t index, const osg::Vec3f& position, const osg::Vec3f& normal, const osg::Vec4ub& colour) {
+                vertices[index] = Terrain::encodeCompactVertex(decode, position.z(), normal);
+                colours[index] = colour;
+            });
+
+        // Same as all positions set to zero by fillVertexBuffers
+        if (!validHeightDataExists && ESM::isEsm4Ext(worldspace))
+            return Terrain::CompactVertexDecode{};
+
+        return decode;
+    }
+
+    void Storage::getHeightRange(float size, const osg::Vec2f& center, ESM::RefId worldspace, float& min, float& max)
+    {
+        const osg::Vec2f origin = center - osg::Vec2f(size, size) * 0.5f;
+        const int startCellX = static_cast<int>(std::floor(origin.x()));
+        const int startCellY = static_cast<int>(std::floor(origin.y()));
+        const int endCellX = static_cast<int>(std::floor(origin.x() + size));
+        const int endCellY = static_cast<int>(std::floor(origin.y() + size));
+
+        min = std::numeric_limits<float>::max();
+        max = std::numeric_limits<float>::lowest();
+
+        for (int cellX = startCellX; cellX <= endCellX; ++cellX)
+        {
+            for (int cellY = startCellY; cellY <= endCellY; ++cellY)
+            {
+                const osg::ref_ptr<const LandObject> land
+                    = getLand(ESM::ExteriorCellLocation(cellX, cellY, worldspace));
+                const ESM::LandData* data = land ? land->getData(ESM::Land::DATA_VHGT) : nullptr;
+                if (data != nullptr)
+                {
+                    min = std::min(min, data->getMinHeight());
+                    max = std::max(max, data->getMaxHeight());
+                }
+                else
+                {
+                    min = std::min(min, defaultHeight);
+                    max = std::max(max, defaultHeight);
+                }
+            }
+        }
+    }
+
     VFS::Path::Normalized Storage::getTextureName(UniqueTextureId id)
     {
         std::string_view texture = "_land_default.dds";
@@ -113,6 +113,16 @@ namespace ESMTerrain
         void fillVertexBuffers(int lodLevel, float size, const osg::Vec2f& center, ESM::RefId worldspace,
             osg::Vec3Array& positions, osg::Vec3Array& normals, osg::Vec4ubArray& colours) override;
 
+        /// Fill vertex buffers for a terrain chunk in the compact format.
+        /// @note May be called from background threads.
+        /// @param lodLevel LOD level, 0 = most detailed
+        /// @param size size of the terrain chunk in cell units
+        /// @param center center of the chunk in cell units
+        /// @param vertices buffer to write packed heights and normals
+        /// @param colours buffer to write vertex colours
+        Terrain::CompactVertexDecode fillCompactVertexBuffers(int lodLevel, float size, const osg::Vec2f& center,
+            ESM::RefId worldspace, osg::Vec2sArray& vertices, osg::Vec4ubArray& colours) override;
+
         /// Create textures holding layer blend values for a terrain chunk.
         /// @note The terrain chunk shouldn't be larger than one cell since otherwise we might
         ///       have to do a ridiculous amount of different layers. For larger chunks, composite maps should be used.
@@ -154,6 +164,13 @@ namespace ESMTerrain
 
         inline const LandObject* getLand(ESM::ExteriorCellLocation cellLocation, LandCache& cache);
 
+        // Calls f(index, position, normal, colour) for each vertex of the chunk, returns false when there is no height
+        // data for the chunk
+        template <class F>
+        bool sampleVertices(int lodLevel, float size, const osg::Vec2f& center, ESM::RefId worldspace, F&& f);
+
+        void getHeightRange(float size, const osg::Vec2f& center, ESM::RefId worldspace, float& min, float& max);
+
         virtual bool useAlteration() const { return false; }
         virtual void adjustColor(int col, int row, const ESM::LandData* heightData, osg::Vec4ub& color) const;
         virtual float getAlteredHeight(int col, int row) const;
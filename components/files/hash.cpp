@@ -2,13 +2,20 @@
 
 #include <smhasher/MurmurHash3.h>
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <istream>
 #include <string>
 
 namespace Files
 {
+    namespace
+    {
+        constexpr std::size_t blockSize = 4096;
+    }
+
     std::array<std::uint64_t, 2> getHash(std::string_view fileName, std::istream& stream)
     {
         std::array<std::uint64_t, 2> hash{ 0, 0 };
@@ -19,7 +26,7 @@ namespace Files
             stream.exceptions(std::ios_base::badbit);
             while (stream)
             {
-                std::array<char, 4096> value;
+                std::array<char, blockSize> value;
                 stream.read(value.data(), value.size());
                 const std::streamsize read = stream.gcount();
                 if (read == 0)
@@ -42,4 +49,17 @@ namespace Files
         }
         return hash;
     }
+
+    std::array<std::uint64_t, 2> getHash(std::span<const char> data)
+    {
+        std::array<std::uint64_t, 2> hash{ 0, 0 };
+        for (std::size_t offset = 0; offset < data.size(); offset += blockSize)
+        {
+            const std::size_t size = std::min(blockSize, data.size() - offset);
+            std::array<std::uint64_t, 2> blockHash{ 0, 0 };
+            MurmurHash3_x64_128(data.data() + offset, static_cast<int>(size), hash.data(), blockHash.data());
+            hash = blockHash;
+        }
+        return hash;
+    }
 }
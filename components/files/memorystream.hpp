@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_FILES_MEMORYSTREAM_H
 
 #include <istream>
+#include <span>
 
 namespace Files
 {
@@ -31,6 +32,9 @@ namespace Files
             return seekoff(pos, std::ios_base::beg, which);
         }
 
+        /// Unread part of the buffer, allows to access the content without copying
+        std::span<const char> getRemaining() const { return std::span<const char>(gptr(), egptr()); }
+
     protected:
         char* bufferStart;
         char* bufferEnd;
@@ -0,0 +1,307 @@
+#ifndef OPENMW_COMPONENTS_MISC_CHUNKEDLIST_H
+#define OPENMW_COMPONENTS_MISC_CHUNKEDLIST_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief A sequence container storing elements in contiguous chunks. Elements are never moved, so pointers,
+    /// references and iterators stay valid until the element is erased like for std::list. Erased elements leave holes
+    /// skipped by iteration. Holes are reused only when there is no alive element after them to preserve the insertion
+    /// order. Chunk sizes grow geometrically up to chunkSize to keep small lists small.
+    template <class T, std::size_t chunkSize = 64>
+    class ChunkedList
+    {
+        static_assert(std::has_single_bit(chunkSize));
+
+        static constexpr std::size_t sEndIndex = std::numeric_limits<std::size_t>::max();
+
+        static constexpr std::size_t sFirstChunkSize = std::min<std::size_t>(chunkSize, 4);
+        // Chunks before the first one of chunkSize, each is twice bigger than the previous
+        static constexpr std::size_t sGrowingChunks = std::countr_zero(chunkSize / sFirstChunkSize);
+        static constexpr std::size_t sGrowingSize = sFirstChunkSize * ((std::size_t(1) << sGrowingChunks) - 1);
+
+        class Chunk
+        {
+        public:
+            explicit Chunk(std::size_t capacity)
+                : mAlive(std::make_unique<bool[]>(capacity))
+                , mStorage(static_cast<std::byte*>(::operator new(capacity * sizeof(T), std::align_val_t(alignof(T)))))
+            {
+            }
+
+            Chunk(const Chunk&) = delete;
+
+            Chunk& operator=(const Chunk&) = delete;
+
+            ~Chunk() { ::operator delete(mStorage, std::align_val_t(alignof(T))); }
+
+            // Flags are stored separately from the elements to not load the elements while skipping the holes.
+            std::unique_ptr<bool[]> mAlive;
+
+            T* get(std::size_t index) { return std::launder(reinterpret_cast<T*>(mStorage + index * sizeof(T))); }
+
+        private:
+            std::byte* mStorage;
+        };
+
+        struct Location
+        {
+            std::size_t mChunk;
+            std::size_t mOffset;
+        };
+
+        static Location locate(std::size_t index)
+        {
+            if (index < sGrowingSize)
+            {
+                const std::size_t chunk = std::bit_width(index / sFirstChunkSize + 1) - 1;
+                return Location{ chunk, index - sFirstChunkSize * ((std::size_t(1) << chunk) - 1) };
+            }
+            index -= sGrowingSize;
+            return Location{ sGrowingChunks + index / chunkSize, index % chunkSize };
+        }
+
+        static std::size_t getChunkCapacity(std::size_t chunk)
+        {
+            return chunk < sGrowingChunks ? sFirstChunkSize << chunk : chunkSize;
+        }
+
+        template <class Value>
+        class IteratorImpl
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value*;
+            using reference = Value&;
+
+            IteratorImpl() = default;
+
+            template <class OtherValue>
+                requires(!std::is_same_v<OtherValue, Value> && std::is_convertible_v<OtherValue*, Value*>)
+            IteratorImpl(const IteratorImpl<OtherValue>& other)
+                : mList(other.mList)
+                , mIndex(other.mIndex)
+            {
+            }
+
+            reference operator*() const { return *mList->getSlot(mIndex); }
+
+            pointer operator->() const { return mList->getSlot(mIndex); }
+
+            IteratorImpl& operator++()
+            {
+                mIndex = mList->findNext(mIndex + 1);
+                return *this;
+            }
+
+            IteratorImpl operator++(int)
+            {
+                IteratorImpl result = *this;
+                ++*this;
+                return result;
+            }
+
+            IteratorImpl& operator--()
+            {
+                mIndex = mList->findPrevious(mIndex == sEndIndex ? mList->mEnd : mIndex);
+                return *this;
+            }
+
+            IteratorImpl operator--(int)
+            {
+                IteratorImpl result = *this;
+                --*this;
+                return result;
+            }
+
+            template <class OtherValue>
+            bool operator==(const IteratorImpl<OtherValue>& other) const
+            {
+                return mIndex == other.mIndex;
+            }
+
+        private:
+            friend class ChunkedList;
+
+            template <class OtherValue>
+            friend class IteratorImpl;
+
+            ChunkedList* mList = nullptr;
+            std::size_t mIndex = sEndIndex;
+
+            explicit IteratorImpl(const ChunkedList* list, std::size_t index)
+                : mList(const_cast<ChunkedList*>(list))
+                , mIndex(index)
+            {
+            }
+        };
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = IteratorImpl<T>;
+        using const_iterator = IteratorImpl<const T>;
+
+        ChunkedList() = default;
+
+        ChunkedList(const ChunkedList& other)
+        {
+            for (const T& value : other)
+                emplace_back(value);
+        }
+
+        ChunkedList(ChunkedList&& other) noexcept
+            : mChunks(std::move(other.mChunks))
+            , mEnd(std::exchange(other.mEnd, 0))
+            , mSize(std::exchange(other.mSize, 0))
+        {
+            other.mChunks.clear();
+        }
+
+        ~ChunkedList() { clear(); }
+
+        ChunkedList& operator=(const ChunkedList& other)
+        {
+            if (this != &other)
+            {
+                ChunkedList copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        ChunkedList& operator=(ChunkedList&& other) noexcept
+        {
+            ChunkedList moved(std::move(other));
+            swap(moved);
+            return *this;
+        }
+
+        void swap(ChunkedList& other) noexcept
+        {
+            std::swap(mChunks, other.mChunks);
+            std::swap(mEnd, other.mEnd);
+            std::swap(mSize, other.mSize);
+        }
+
+        std::size_t size() const { return mSize; }
+
+        bool empty() const { return mSize == 0; }
+
+        iterator begin() { return iterator(this, findNext(0)); }
+
+        const_iterator begin() const { return const_iterator(this, findNext(0)); }
+
+        iterator end() { return iterator(this, sEndIndex); }
+
+        const_iterator end() const { return const_iterator(this, sEndIndex); }
+
+        T& front() { return *begin(); }
+
+        const T& front() const { return *begin(); }
+
+        T& back() { return *getSlot(findPrevious(mEnd)); }
+
+        const T& back() const { return *getSlot(findPrevious(mEnd)); }
+
+        template <class... Args>
+        T& emplace_back(Args&&... args)
+        {
+            const Location location = locate(mEnd);
+            if (location.mChunk == mChunks.size())
+                mChunks.push_back(std::make_unique<Chunk>(getChunkCapacity(location.mChunk)));
+            Chunk& chunk = *mChunks[location.mChunk];
+            T* const result = std::construct_at(chunk.get(location.mOffset), std::forward<Args>(args)...);
+            chunk.mAlive[location.mOffset] = true;
+            ++mEnd;
+            ++mSize;
+            return *result;
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        /// Destroy the element. Does not invalidate iterators to other elements.
+        iterator erase(const_iterator position)
+        {
+            const std::size_t index = position.mIndex;
+            const Location location = locate(index);
+            Chunk& chunk = *mChunks[location.mChunk];
+            std::destroy_at(chunk.get(location.mOffset));
+            chunk.mAlive[location.mOffset] = false;
+            --mSize;
+            const std::size_t next = findNext(index + 1);
+            if (next == sEndIndex)
+            {
+                const std::size_t last = findPrevious(index);
+                mEnd = last == sEndIndex ? 0 : last + 1;
+            }
+            return iterator(this, next);
+        }
+
+        void clear()
+        {
+            for (std::size_t i = 0; i < mEnd; ++i)
+            {
+                const Location location = locate(i);
+                Chunk& chunk = *mChunks[location.mChunk];
+                if (chunk.mAlive[location.mOffset])
+                    std::destroy_at(chunk.get(location.mOffset));
+            }
+            mChunks.clear();
+            mEnd = 0;
+            mSize = 0;
+        }
+
+    private:
+        std::vector<std::unique_ptr<Chunk>> mChunks;
+        // Number of used slots including the holes.
+        std::size_t mEnd = 0;
+        std::size_t mSize = 0;
+
+        T* getSlot(std::size_t index) const
+        {
+            const Location location = locate(index);
+            return mChunks[location.mChunk]->get(location.mOffset);
+        }
+
+        bool isAlive(std::size_t index) const
+        {
+            const Location location = locate(index);
+            return mChunks[location.mChunk]->mAlive[location.mOffset];
+        }
+
+        std::size_t findNext(std::size_t index) const
+        {
+            for (; index < mEnd; ++index)
+                if (isAlive(index))
+                    return index;
+            return sEndIndex;
+        }
+
+        std::size_t findPrevious(std::size_t index) const
+        {
+            while (index > 0)
+                if (isAlive(--index))
+                    return index;
+            return sEndIndex;
+        }
+    };
+}
+
+#endif
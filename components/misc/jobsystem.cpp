@@ -0,0 +1,326 @@
+#include "jobsystem.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <string>
+
+namespace Misc
+{
+    namespace
+    {
+        thread_local JobSystem* sCurrentJobSystem = nullptr;
+        thread_local std::size_t sCurrentWorkerIndex = 0;
+
+        // Used to wake up a worker waiting for a job which is being executed by another thread, in case more jobs
+        // are scheduled meanwhile
+        constexpr std::chrono::milliseconds waitForJobPollInterval(1);
+
+        struct ParallelForState
+        {
+            std::size_t mBegin;
+            std::size_t mEnd;
+            std::size_t mGrainSize;
+            std::size_t mChunks;
+            const std::function<void(std::size_t, std::size_t)>* mFunction;
+            std::atomic_size_t mNextChunk{ 0 };
+            std::atomic_size_t mCompletedChunks{ 0 };
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+            std::exception_ptr mException;
+
+            void process()
+            {
+                while (true)
+                {
+                    const std::size_t chunk = mNextChunk.fetch_add(1, std::memory_order_relaxed);
+                    if (chunk >= mChunks)
+                        return;
+                    const std::size_t begin = mBegin + chunk * mGrainSize;
+                    const std::size_t end = std::min(mEnd, begin + mGrainSize);
+                    try
+                    {
+                        (*mFunction)(begin, end);
+                    }
+                    catch (...)
+                    {
+                        const std::lock_guard lock(mMutex);
+                        if (mException == nullptr)
+                            mException = std::current_exception();
+                    }
+                    if (mCompletedChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == mChunks)
+                    {
+                        const std::lock_guard lock(mMutex);
+                        mCondition.notify_all();
+                    }
+                }
+            }
+
+            bool isCompleted() const { return mCompletedChunks.load(std::memory_order_acquire) == mChunks; }
+        };
+    }
+
+    void Job::wait()
+    {
+        while (!isDone())
+        {
+            if (sCurrentJobSystem == mJobSystem && mJobSystem->tryExecuteOne())
+                continue;
+            std::unique_lock lock(mMutex);
+            if (sCurrentJobSystem == mJobSystem)
+                mCondition.wait_for(lock, waitForJobPollInterval, [&] { return isDone(); });
+            else
+                mCondition.wait(lock, [&] { return isDone(); });
+        }
+    }
+
+    JobSystem::JobSystem(std::size_t threads)
+    {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        // Jobs are executed when scheduled
+        const std::size_t maxThreads = 0;
+#else
+        const std::size_t maxThreads = std::max<std::size_t>(threads, std::thread::hardware_concurrency());
+#endif
+        // Workers are never reallocated, so threads can be started later while others access them without locking
+        mWorkers.reserve(maxThreads);
+        for (std::size_t i = 0; i < maxThreads; ++i)
+            mWorkers.push_back(std::make_unique<Worker>());
+        startThreads(threads);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        stop();
+    }
+
+    JobHandle JobSystem::schedule(std::function<void()> function, JobPriority priority)
+    {
+        return schedule(std::move(function), {}, priority);
+    }
+
+    JobHandle JobSystem::schedule(
+        std::function<void()> function, std::span<const JobHandle> dependencies, JobPriority priority)
+    {
+        JobHandle job(new Job(*this, std::move(function), priority));
+
+        // The initial value of mPendingDependencies is 1 to prevent scheduling before all dependencies are added
+        for (const JobHandle& dependency : dependencies)
+        {
+            const std::lock_guard lock(dependency->mMutex);
+            if (dependency->isDone())
+                continue;
+            job->mPendingDependencies.fetch_add(1, std::memory_order_relaxed);
+            dependency->mContinuations.push_back(job);
+        }
+
+        if (job->mPendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            push(job);
+
+        return job;
+    }
+
+    void JobSystem::parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize,
+        const std::function<void(std::size_t, std::size_t)>& function, JobPriority priority)
+    {
+        if (begin >= end)
+            return;
+
+        grainSize = std::max<std::size_t>(grainSize, 1);
+
+        // Helper jobs may start after parallelFor returns, so the state is shared with them
+        const auto state = std::make_shared<ParallelForState>();
+        state->mBegin = begin;
+        state->mEnd = end;
+        state->mGrainSize = grainSize;
+        state->mChunks = (end - begin + grainSize - 1) / grainSize;
+        state->mFunction = &function;
+
+        const std::size_t helpers = std::min(state->mChunks - 1, getNumThreads());
+        for (std::size_t i = 0; i < helpers; ++i)
+            schedule([state] { state->process(); }, priority);
+
+        state->process();
+
+        while (!state->isCompleted())
+        {
+            if (sCurrentJobSystem == this && tryExecuteOne())
+                continue;
+            std::unique_lock lock(state->mMutex);
+            state->mCondition.wait(lock, [&] { return state->isCompleted(); });
+        }
+
+        if (state->mException != nullptr)
+            std::rethrow_exception(state->mException);
+    }
+
+    void JobSystem::startThreads(std::size_t threads)
+    {
+        const std::lock_guard lock(mThreadsMutex);
+        if (mStopping)
+            return;
+        const std::size_t numThreads = mNumThreads.load(std::memory_order_relaxed);
+        threads = std::min(threads, mWorkers.size());
+        if (threads <= numThreads)
+            return;
+        // Published before the threads start, so each worker index is below the number seen by any worker
+        mNumThreads.store(threads, std::memory_order_release);
+        for (std::size_t i = numThreads; i < threads; ++i)
+            mWorkers[i]->mThread = std::thread([this, i] { run(i); });
+    }
+
+    void JobSystem::stop()
+    {
+        const std::lock_guard threadsLock(mThreadsMutex);
+        {
+            const std::lock_guard lock(mSleepMutex);
+            mStopping = true;
+        }
+        mSleepCondition.notify_all();
+
+        for (const std::unique_ptr<Worker>& worker : mWorkers)
+            if (worker->mThread.joinable())
+                worker->mThread.join();
+
+        auto clear = [&](Queue& queue) {
+            const std::lock_guard lock(queue.mMutex);
+            mQueuedJobs.fetch_sub(queue.mJobs.size(), std::memory_order_relaxed);
+            queue.mJobs.clear();
+        };
+
+        for (const std::unique_ptr<Worker>& worker : mWorkers)
+            std::for_each(worker->mQueues.begin(), worker->mQueues.end(), clear);
+        std::for_each(mSharedQueues.begin(), mSharedQueues.end(), clear);
+    }
+
+    void JobSystem::push(JobHandle job)
+    {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        execute(job);
+#else
+        const std::size_t priority = static_cast<std::size_t>(job->mPriority);
+        Queue& queue = sCurrentJobSystem == this ? mWorkers[sCurrentWorkerIndex]->mQueues[priority]
+                                                 : mSharedQueues[priority];
+
+        // Count before adding to the queue to never let the counter go below zero
+        {
+            const std::lock_guard lock(mSleepMutex);
+            mQueuedJobs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        {
+            const std::lock_guard lock(queue.mMutex);
+            queue.mJobs.push_back(std::move(job));
+        }
+
+        mSleepCondition.notify_one();
+#endif
+    }
+
+    JobHandle JobSystem::pop(std::size_t workerIndex)
+    {
+        if (mQueuedJobs.load(std::memory_order_relaxed) == 0)
+            return nullptr;
+
+        auto take = [&](Queue& queue, bool back) -> JobHandle {
+            const std::lock_guard lock(queue.mMutex);
+            if (queue.mJobs.empty())
+                return nullptr;
+            JobHandle job;
+            if (back)
+            {
+                job = std::move(queue.mJobs.back());
+                queue.mJobs.pop_back();
+            }
+            else
+            {
+                job = std::move(queue.mJobs.front());
+                queue.mJobs.pop_front();
+            }
+            mQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        };
+
+        for (std::size_t priority = sPriorities; priority-- > 0;)
+        {
+            // Own jobs are taken from the back to process the most recent and likely still cached data first
+            if (JobHandle job = take(mWorkers[workerIndex]->mQueues[priority], true))
+                return job;
+
+            if (JobHandle job = take(mSharedQueues[priority], false))
+                return job;
+
+            // Steal the oldest jobs starting from the next worker to spread the contention
+            for (std::size_t i = 1, n = mNumThreads.load(std::memory_order_acquire); i < n; ++i)
+                if (JobHandle job = take(mWorkers[(workerIndex + i) % n]->mQueues[priority], false))
+                    return job;
+        }
+
+        return nullptr;
+    }
+
+    void JobSystem::execute(const JobHandle& job)
+    {
+        try
+        {
+            job->mFunction();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Job failed: " << e.what();
+        }
+        catch (...)
+        {
+            Log(Debug::Error) << "Job failed with unknown exception";
+        }
+        job->mFunction = nullptr;
+
+        std::vector<JobHandle> continuations;
+        {
+            const std::lock_guard lock(job->mMutex);
+            job->mDone.store(true, std::memory_order_release);
+            continuations.swap(job->mContinuations);
+        }
+        job->mCondition.notify_all();
+
+        for (JobHandle& continuation : continuations)
+            if (continuation->mPendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                push(std::move(continuation));
+    }
+
+    void JobSystem::run(std::size_t workerIndex)
+    {
+        sCurrentJobSystem = this;
+        sCurrentWorkerIndex = workerIndex;
+
+        Debug::Tracing::setThreadName("JobSystem " + std::to_string(workerIndex));
+
+        while (!mStopping)
+        {
+            if (const JobHandle job = pop(workerIndex))
+            {
+                mActiveThreads.fetch_add(1, std::memory_order_relaxed);
+                execute(job);
+                mActiveThreads.fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            std::unique_lock lock(mSleepMutex);
+            mSleepCondition.wait(lock, [&] { return mStopping || mQueuedJobs.load(std::memory_order_relaxed) > 0; });
+        }
+    }
+
+    bool JobSystem::tryExecuteOne()
+    {
+        if (mStopping)
+            return false;
+        const JobHandle job = pop(sCurrentWorkerIndex);
+        if (job == nullptr)
+            return false;
+        execute(job);
+        return true;
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef OPENMW_COMPONENTS_MISC_JOBSYSTEM_H
+#define OPENMW_COMPONENTS_MISC_JOBSYSTEM_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace Misc
+{
+    enum class JobPriority
+    {
+        Low = 0,
+        Normal = 1,
+        High = 2,
+    };
+
+    class JobSystem;
+
+    /// @brief A function executed once by a JobSystem after all jobs it depends on are done.
+    class Job
+    {
+    public:
+        bool isDone() const { return mDone.load(std::memory_order_acquire); }
+
+        /// Wait until the job is done. Executes other jobs meanwhile when called from a worker thread.
+        void wait();
+
+    private:
+        friend class JobSystem;
+
+        JobSystem* mJobSystem;
+        std::function<void()> mFunction;
+        JobPriority mPriority;
+        std::atomic_size_t mPendingDependencies{ 1 };
+        std::atomic_bool mDone{ false };
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::vector<std::shared_ptr<Job>> mContinuations;
+
+        explicit Job(JobSystem& jobSystem, std::function<void()>&& function, JobPriority priority)
+            : mJobSystem(&jobSystem)
+            , mFunction(std::move(function))
+            , mPriority(priority)
+        {
+        }
+    };
+
+    using JobHandle = std::shared_ptr<Job>;
+
+    /// @brief A thread pool executing jobs by priority. Each worker thread has own queues to push jobs scheduled from
+    /// this thread and takes jobs from the queues of other threads when own queues are empty.
+    /// @note Jobs of the same priority scheduled from a non-worker thread are started in the order they were scheduled.
+    /// Jobs scheduled from a worker thread are started in the reverse order by the same thread.
+    class JobSystem
+    {
+    public:
+        explicit JobSystem(std::size_t threads);
+
+        /// Stops worker threads after they finish the current jobs. Jobs which are not started are discarded.
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        JobHandle schedule(std::function<void()> function, JobPriority priority = JobPriority::Normal);
+
+        /// Schedule a job to be executed after all dependencies are done.
+        JobHandle schedule(std::function<void()> function, std::span<const JobHandle> dependencies,
+            JobPriority priority = JobPriority::Normal);
+
+        /// Call function(begin, end) for the subranges of [begin, end) of up to grainSize elements on the worker
+        /// threads and the calling thread. Returns when all subranges are processed. The first thrown exception is
+        /// rethrown.
+        void parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize,
+            const std::function<void(std::size_t, std::size_t)>& function,
+            JobPriority priority = JobPriority::Normal);
+
+        /// Start more worker threads until there are \p threads. The number is limited by the number of CPU cores or
+        /// the number given to the constructor if it is larger. Does nothing after stop().
+        void startThreads(std::size_t threads);
+
+        /// Stop worker threads after they finish the current jobs. Jobs which are not started are discarded.
+        void stop();
+
+        std::size_t getNumThreads() const { return mNumThreads.load(std::memory_order_relaxed); }
+
+        std::size_t getNumQueuedJobs() const { return mQueuedJobs.load(std::memory_order_relaxed); }
+
+        std::size_t getNumActiveThreads() const { return mActiveThreads.load(std::memory_order_relaxed); }
+
+    private:
+        friend class Job;
+
+        static constexpr std::size_t sPriorities = 3;
+
+        struct Queue
+        {
+            std::mutex mMutex;
+            std::deque<JobHandle> mJobs;
+        };
+
+        struct Worker
+        {
+            std::array<Queue, sPriorities> mQueues;
+            std::thread mThread;
+        };
+
+        std::vector<std::unique_ptr<Worker>> mWorkers;
+        std::atomic_size_t mNumThreads{ 0 };
+        std::mutex mThreadsMutex;
+        std::array<Queue, sPriorities> mSharedQueues;
+        std::atomic_size_t mQueuedJobs{ 0 };
+        std::atomic_size_t mActiveThreads{ 0 };
+        std::atomic_bool mStopping{ false };
+        std::mutex mSleepMutex;
+        std::condition_variable mSleepCondition;
+
+        void push(JobHandle job);
+
+        JobHandle pop(std::size_t workerIndex);
+
+        void execute(const JobHandle& job);
+
+        void run(std::size_t workerIndex);
+
+        /// Execute one queued job if there is any when called from a worker thread.
+        bool tryExecuteOne();
+    };
+}
+
+#endif
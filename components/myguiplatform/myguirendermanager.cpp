@@ -3,6 +3,7 @@
 #include <MyGUI_Timer.h>
 
 #include <osg/Drawable>
+#include <osg/Stats>
 #include <osg/TexMat>
 #include <osg/Texture2D>
 
@@ -20,6 +21,8 @@
 
 #include "myguitexture.hpp"
 
+#include <algorithm>
+
 #define MYGUI_PLATFORM_LOG_SECTION "Platform"
 #define MYGUI_PLATFORM_LOG(level, text) MYGUI_LOGGING(MYGUI_PLATFORM_LOG_SECTION, level, text)
 
@@ -46,6 +49,18 @@
 
 namespace MyGUIPlatform
 {
+    namespace
+    {
+        // Texture coordinates out of the image can't be mapped to an atlas region
+        bool hasNormalizedTexCoords(const MyGUI::Vertex* vertices, size_t count)
+        {
+            constexpr float epsilon = 1e-4f;
+            return std::all_of(vertices, vertices + count, [&](const MyGUI::Vertex& vertex) {
+                return vertex.u >= -epsilon && vertex.u <= 1 + epsilon && vertex.v >= -epsilon
+                    && vertex.v <= 1 + epsilon;
+            });
+        }
+    }
 
     class Drawable : public osg::Drawable
     {
@@ -110,28 +125,14 @@ namespace MyGUIPlatform
 #endif
 
             mReadFrom = (mReadFrom + 1) % sNumBuffers;
-            const std::vector<Batch>& vec = mBatchVector[mReadFrom];
-            for (std::vector<Batch>::const_iterator it = vec.begin(); it != vec.end(); ++it)
+            const Frame& frame = mFrames[mReadFrom];
+            if (!frame.mBatches.empty())
             {
-                const Batch& batch = *it;
-                osg::VertexBufferObject* vbo = batch.mVertexBuffer;
-
-                if (batch.mStateSet)
-                {
-                    state->pushStateSet(batch.mStateSet);
-                    state->apply();
-                }
-
-                osg::Texture2D* texture = batch.mTexture;
-                if (texture)
-                    state->applyTextureAttribute(0, texture);
-                else
-                    state->applyTextureAttribute(0, mDummyTexture);
-
                 osg::GLBufferObject* bufferobject = state->isVertexBufferObjectSupported()
-                    ? vbo->getOrCreateGLBufferObject(state->getContextID())
+                    ? frame.mBuffer->getOrCreateGLBufferObject(state->getContextID())
                     : nullptr;
 
+                // All batches of the frame share the same buffer, the vertex pointers are set once
 #ifdef __EMSCRIPTEN__
                 if (bufferobject)
                 {
@@ -146,7 +147,7 @@ namespace MyGUIPlatform
                 }
                 else
                 {
-                    const char* base = reinterpret_cast<const char*>(vbo->getArray(0)->getDataPointer());
+                    const char* base = reinterpret_cast<const char*>(frame.mArray->getDataPointer());
                     glVertexAttribPointer(sPositionAttrib, 3, GL_FLOAT, GL_FALSE, sizeof(MyGUI::Vertex), base);
                     glVertexAttribPointer(
                         sColorAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(MyGUI::Vertex), base + 12);
@@ -156,12 +157,6 @@ namespace MyGUIPlatform
                 glEnableVertexAttribArray(sPositionAttrib);
                 glEnableVertexAttribArray(sColorAttrib);
                 glEnableVertexAttribArray(sTexCoordAttrib);
-
-                glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(batch.mVertexCount));
-
-                glDisableVertexAttribArray(sPositionAttrib);
-                glDisableVertexAttribArray(sColorAttrib);
-                glDisableVertexAttribArray(sTexCoordAttrib);
 #else
                 if (bufferobject)
                 {
@@ -173,22 +168,42 @@ namespace MyGUIPlatform
                 }
                 else
                 {
-                    glVertexPointer(3, GL_FLOAT, sizeof(MyGUI::Vertex),
-                        reinterpret_cast<const char*>(vbo->getArray(0)->getDataPointer()));
-                    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(MyGUI::Vertex),
-                        reinterpret_cast<const char*>(vbo->getArray(0)->getDataPointer()) + 12);
-                    glTexCoordPointer(2, GL_FLOAT, sizeof(MyGUI::Vertex),
-                        reinterpret_cast<const char*>(vbo->getArray(0)->getDataPointer()) + 16);
+                    const char* base = reinterpret_cast<const char*>(frame.mArray->getDataPointer());
+                    glVertexPointer(3, GL_FLOAT, sizeof(MyGUI::Vertex), base);
+                    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(MyGUI::Vertex), base + 12);
+                    glTexCoordPointer(2, GL_FLOAT, sizeof(MyGUI::Vertex), base + 16);
                 }
-
-                glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(batch.mVertexCount));
 #endif
 
-                if (batch.mStateSet)
+                for (const Batch& batch : frame.mBatches)
                 {
-                    state->popStateSet();
-                    state->apply();
+                    if (batch.mStateSet)
+                    {
+                        state->pushStateSet(batch.mStateSet);
+                        state->apply();
+                    }
+
+                    osg::Texture2D* texture = batch.mTexture;
+                    if (texture)
+                        state->applyTextureAttribute(0, texture);
+                    else
+                        state->applyTextureAttribute(0, mDummyTexture);
+
+                    glDrawArrays(
+                        GL_TRIANGLES, static_cast<GLint>(batch.mFirst), static_cast<GLsizei>(batch.mVertexCount));
+
+                    if (batch.mStateSet)
+                    {
+                        state->popStateSet();
+                        state->apply();
+                    }
                 }
+
+#ifdef __EMSCRIPTEN__
+                glDisableVertexAttribArray(sPositionAttrib);
+                glDisableVertexAttribArray(sColorAttrib);
+                glDisableVertexAttribArray(sTexCoordAttrib);
+#endif
             }
 
 #ifndef __EMSCRIPTEN__
@@ -211,6 +226,7 @@ namespace MyGUIPlatform
             , mReadFrom(0)
         {
             setSupportsDisplayList(false);
+            createFrames();
 
             osg::ref_ptr<CollectDrawCalls> collectDrawCalls = new CollectDrawCalls;
             collectDrawCalls->setRenderManager(mParent);
@@ -242,6 +258,7 @@ namespace MyGUIPlatform
             , mReadFrom(0)
             , mDummyTexture(copy.mDummyTexture)
         {
+            createFrames();
         }
 
         // Defines the necessary information for a draw call
@@ -250,24 +267,51 @@ namespace MyGUIPlatform
             // May be empty
             osg::ref_ptr<osg::Texture2D> mTexture;
 
-            osg::ref_ptr<osg::VertexBufferObject> mVertexBuffer;
-            // need to hold on to this too as the mVertexBuffer does not hold a ref to its own array
-            osg::ref_ptr<osg::Array> mArray;
-
             // optional
             osg::ref_ptr<osg::StateSet> mStateSet;
 
+            // Range of the vertices of the frame buffer
+            size_t mFirst;
             size_t mVertexCount;
         };
 
-        void addBatch(const Batch& batch) { mBatchVector[mWriteTo].push_back(batch); }
+        // Appends the vertices to the frame buffer and returns them to be filled. Vertices are merged into the last
+        // batch when it uses the same texture and state.
+        MyGUI::Vertex* addVertices(osg::Texture2D* texture, osg::StateSet* stateSet, size_t count)
+        {
+            Frame& frame = mFrames[mWriteTo];
+            const size_t first = frame.mVertexCount;
+            frame.mVertexCount += count;
+            if (frame.mArray->size() < frame.mVertexCount * sizeof(MyGUI::Vertex))
+                frame.mArray->resize(frame.mVertexCount * sizeof(MyGUI::Vertex));
+
+            if (!frame.mBatches.empty() && frame.mBatches.back().mTexture == texture
+                && frame.mBatches.back().mStateSet == stateSet)
+                frame.mBatches.back().mVertexCount += count;
+            else
+                frame.mBatches.push_back(Batch{ texture, stateSet, first, count });
+
+            return reinterpret_cast<MyGUI::Vertex*>(&(*frame.mArray)[0]) + first;
+        }
 
         void clear()
         {
             mWriteTo = (mWriteTo + 1) % sNumBuffers;
-            mBatchVector[mWriteTo].clear();
+            Frame& frame = mFrames[mWriteTo];
+            frame.mBatches.clear();
+            frame.mVertexCount = 0;
         }
 
+        // Submit the vertices of the frame to the draw thread
+        void commit()
+        {
+            Frame& frame = mFrames[mWriteTo];
+            frame.mArray->dirty();
+            frame.mBuffer->dirty();
+        }
+
+        size_t getNumBatches() const { return mFrames[mWriteTo].mBatches.size(); }
+
         osg::StateSet* getDrawableStateSet() { return mStateSet; }
 
         META_Object(osgMyGUI, Drawable)
@@ -276,36 +320,49 @@ namespace MyGUIPlatform
         // 2 would be enough in most cases, use 4 to get stereo working
         static const int sNumBuffers = 4;
 
+        // Vertices of all the batches of a frame are stored in a single buffer reused by the following frames
+        struct Frame
+        {
+            osg::ref_ptr<osg::UByteArray> mArray;
+            // NB mBuffer does not own the array
+            osg::ref_ptr<osg::VertexBufferObject> mBuffer;
+            std::vector<Batch> mBatches;
+            size_t mVertexCount = 0;
+        };
+
         // double buffering approach, to avoid the need for synchronization with the draw thread
-        std::vector<Batch> mBatchVector[sNumBuffers];
+        Frame mFrames[sNumBuffers];
 
         int mWriteTo;
         mutable int mReadFrom;
 
+        void createFrames()
+        {
+            for (Frame& frame : mFrames)
+            {
+                frame.mArray = new osg::UByteArray;
+                frame.mBuffer = new osg::VertexBufferObject;
+                frame.mBuffer->setDataVariance(osg::Object::DYNAMIC);
+                frame.mBuffer->setUsage(GL_DYNAMIC_DRAW);
+                frame.mBuffer->setArray(0, frame.mArray.get());
+            }
+        }
+
         osg::ref_ptr<osg::Texture2D> mDummyTexture;
     };
 
+    // Vertices are copied into the frame buffer of the Drawable by doRender, so a CPU side storage is enough
     class OSGVertexBuffer : public MyGUI::IVertexBuffer
     {
-        osg::ref_ptr<osg::VertexBufferObject> mBuffer[2];
-        osg::ref_ptr<osg::UByteArray> mVertexArray[2];
+        std::vector<MyGUI::Vertex> mVertices;
 
         size_t mNeedVertexCount;
 
-        unsigned int mCurrentBuffer;
-        bool mUsed; // has the mCurrentBuffer been submitted to the rendering thread
-
-        void destroy();
-        osg::UByteArray* create();
-
     public:
         OSGVertexBuffer();
         virtual ~OSGVertexBuffer() {}
 
-        void markUsed();
-
-        osg::Array* getVertexArray();
-        osg::VertexBufferObject* getVertexBuffer();
+        const MyGUI::Vertex* getVertices() const { return mVertices.data(); }
 
         void setVertexCount(size_t count) override;
         size_t getVertexCount() const override;
@@ -316,16 +373,9 @@ namespace MyGUIPlatform
 
     OSGVertexBuffer::OSGVertexBuffer()
         : mNeedVertexCount(0)
-        , mCurrentBuffer(0)
-        , mUsed(false)
     {
     }
 
-    void OSGVertexBuffer::markUsed()
-    {
-        mUsed = true;
-    }
-
     void OSGVertexBuffer::setVertexCount(size_t count)
     {
         if (count == mNeedVertexCount)
@@ -341,53 +391,13 @@ namespace MyGUIPlatform
 
     MyGUI::Vertex* OSGVertexBuffer::lock()
     {
-        if (mUsed)
-        {
-            mCurrentBuffer = (mCurrentBuffer + 1) % 2;
-            mUsed = false;
-        }
-        osg::UByteArray* array = mVertexArray[mCurrentBuffer];
-        if (!array)
-        {
-            array = create();
-        }
-        else if (array->size() != mNeedVertexCount * sizeof(MyGUI::Vertex))
-        {
-            array->resize(mNeedVertexCount * sizeof(MyGUI::Vertex));
-        }
+        if (mVertices.size() != mNeedVertexCount)
+            mVertices.resize(mNeedVertexCount);
 
-        return (MyGUI::Vertex*)&(*array)[0];
-    }
-
-    void OSGVertexBuffer::unlock()
-    {
-        mVertexArray[mCurrentBuffer]->dirty();
-        mBuffer[mCurrentBuffer]->dirty();
+        return mVertices.data();
     }
 
-    osg::UByteArray* OSGVertexBuffer::create()
-    {
-        mVertexArray[mCurrentBuffer]
-            = new osg::UByteArray(static_cast<unsigned int>(mNeedVertexCount * sizeof(MyGUI::Vertex)));
-
-        mBuffer[mCurrentBuffer] = new osg::VertexBufferObject;
-        mBuffer[mCurrentBuffer]->setDataVariance(osg::Object::DYNAMIC);
-        mBuffer[mCurrentBuffer]->setUsage(GL_DYNAMIC_DRAW);
-        // NB mBuffer does not own the array
-        mBuffer[mCurrentBuffer]->setArray(0, mVertexArray[mCurrentBuffer].get());
-
-        return mVertexArray[mCurrentBuffer];
-    }
-
-    osg::Array* OSGVertexBuffer::getVertexArray()
-    {
-        return mVertexArray[mCurrentBuffer];
-    }
-
-    osg::VertexBufferObject* OSGVertexBuffer::getVertexBuffer()
-    {
-        return mBuffer[mCurrentBuffer];
-    }
+    void OSGVertexBuffer::unlock() {}
 
     // ---------------------------------------------------------------------------
 
@@ -400,6 +410,8 @@ namespace MyGUIPlatform
         , mIsInitialise(false)
         , mInvScalingFactor(1.f)
         , mInjectState(nullptr)
+        , mTextureAtlasEnabled(true)
+        , mNumSourceBatches(0)
     {
         if (scalingFactor != 0.f)
             mInvScalingFactor = 1.f / scalingFactor;
@@ -477,30 +489,55 @@ namespace MyGUIPlatform
     void RenderManager::begin()
     {
         mDrawable->clear();
+        mNumSourceBatches = 0;
         // variance will be recomputed based on textures being rendered in this frame
         mDrawable->setDataVariance(osg::Object::STATIC);
     }
 
     void RenderManager::doRender(MyGUI::IVertexBuffer* buffer, MyGUI::ITexture* texture, size_t count)
     {
-        Drawable::Batch batch;
-        batch.mVertexCount = count;
-        batch.mVertexBuffer = static_cast<OSGVertexBuffer*>(buffer)->getVertexBuffer();
-        batch.mArray = static_cast<OSGVertexBuffer*>(buffer)->getVertexArray();
-        static_cast<OSGVertexBuffer*>(buffer)->markUsed();
+        if (count == 0)
+            return;
+
+        const MyGUI::Vertex* const vertices = static_cast<OSGVertexBuffer*>(buffer)->getVertices();
 
+        osg::Texture2D* drawTexture = nullptr;
+        osg::StateSet* stateSet = nullptr;
         if (OSGTexture* osgtexture = static_cast<OSGTexture*>(texture))
         {
-            batch.mTexture = osgtexture->getTexture();
-            if (batch.mTexture->getDataVariance() == osg::Object::DYNAMIC)
+            drawTexture = osgtexture->getTexture();
+            if (drawTexture->getDataVariance() == osg::Object::DYNAMIC)
                 mDrawable->setDataVariance(osg::Object::DYNAMIC); // only for this frame, reset in begin()
             if (!mInjectState && osgtexture->getInjectState())
-                batch.mStateSet = osgtexture->getInjectState();
+                stateSet = osgtexture->getInjectState();
         }
         if (mInjectState)
-            batch.mStateSet = mInjectState;
+            stateSet = mInjectState;
+
+        // Injected states may use their own texture coordinates, keep their textures as is
+        const TextureAtlas::Region* region = nullptr;
+        if (mTextureAtlasEnabled && drawTexture != nullptr && stateSet == nullptr)
+        {
+            region = mAtlas.get(*drawTexture);
+            if (region != nullptr && !hasNormalizedTexCoords(vertices, count))
+                region = nullptr;
+        }
+
+        MyGUI::Vertex* const destination
+            = mDrawable->addVertices(region != nullptr ? region->mTexture.get() : drawTexture, stateSet, count);
+        std::copy(vertices, vertices + count, destination);
+
+        if (region != nullptr)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const osg::Vec2f uv = region->map(osg::Vec2f(destination[i].u, destination[i].v));
+                destination[i].u = uv.x();
+                destination[i].v = uv.y();
+            }
+        }
 
-        mDrawable->addBatch(batch);
+        ++mNumSourceBatches;
     }
 
     void RenderManager::setInjectState(osg::StateSet* stateSet)
@@ -508,7 +545,28 @@ namespace MyGUIPlatform
         mInjectState = stateSet;
     }
 
-    void RenderManager::end() {}
+    void RenderManager::setTextureAtlasEnabled(bool enabled)
+    {
+        mTextureAtlasEnabled = enabled;
+    }
+
+    void RenderManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "GUI DrawCalls", static_cast<double>(mNumDrawCalls.load()));
+        stats.setAttribute(frameNumber, "GUI Batches", static_cast<double>(mNumBatches.load()));
+        stats.setAttribute(frameNumber, "GUI Atlas Images", static_cast<double>(mNumAtlasImages.load()));
+    }
+
+    void RenderManager::end()
+    {
+        mDrawable->commit();
+        mAtlas.commit();
+
+        mNumDrawCalls = mDrawable->getNumBatches();
+        mNumBatches = mNumSourceBatches;
+        mNumAtlasImages = mAtlas.getNumImages();
+        mNumSourceBatches = 0;
+    }
 
     void RenderManager::update()
     {
@@ -5,6 +5,11 @@
 
 #include <osg/ref_ptr>
 
+#include <atomic>
+#include <cstddef>
+
+#include "textureatlas.hpp"
+
 namespace Resource
 {
     class ImageManager;
@@ -26,6 +31,7 @@ namespace osg
     class Camera;
     class RenderInfo;
     class StateSet;
+    class Stats;
 }
 
 namespace MyGUIPlatform
@@ -56,6 +62,14 @@ namespace MyGUIPlatform
 
         osg::StateSet* mInjectState;
 
+        TextureAtlas mAtlas;
+        bool mTextureAtlasEnabled;
+
+        std::size_t mNumSourceBatches;
+        std::atomic<std::size_t> mNumDrawCalls{ 0 };
+        std::atomic<std::size_t> mNumBatches{ 0 };
+        std::atomic<std::size_t> mNumAtlasImages{ 0 };
+
     public:
         RenderManager(osgViewer::Viewer* viewer, osg::Group* sceneroot, Resource::ImageManager* imageManager,
             float scalingFactor);
@@ -66,6 +80,11 @@ namespace MyGUIPlatform
 
         void enableShaders(Shader::ShaderManager& shaderManager);
 
+        /// Pack small static textures into shared atlases to merge the draw calls using them
+        void setTextureAtlasEnabled(bool enabled);
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         static RenderManager& getInstance() { return *getInstancePtr(); }
         static RenderManager* getInstancePtr()
         {
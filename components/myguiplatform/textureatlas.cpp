@@ -0,0 +1,178 @@
+#include "textureatlas.hpp"
+
+#include <osg/Image>
+#include <osg/Texture2D>
+
+#include <algorithm>
+
+namespace MyGUIPlatform
+{
+    namespace
+    {
+        constexpr int pageSize = 1024;
+        constexpr int maxImageSize = 256;
+        constexpr std::size_t maxPages = 4;
+        // Copy of the image edges around each image to avoid sampling the neighbours with linear filtering
+        constexpr int padding = 1;
+
+        bool isSuitable(const osg::Texture2D& texture)
+        {
+            const osg::Image* image = texture.getImage();
+            if (image == nullptr || image->data() == nullptr)
+                return false;
+            if (texture.getDataVariance() == osg::Object::DYNAMIC || texture.getUnRefImageDataAfterApply())
+                return false;
+            if (image->s() < 1 || image->t() < 1 || image->r() != 1 || image->s() > maxImageSize
+                || image->t() > maxImageSize)
+                return false;
+            // Atlas pages can't repeat a part of them and have no mipmaps
+            return texture.getWrap(osg::Texture::WRAP_S) == osg::Texture::CLAMP_TO_EDGE
+                && texture.getWrap(osg::Texture::WRAP_T) == osg::Texture::CLAMP_TO_EDGE
+                && texture.getFilter(osg::Texture::MIN_FILTER) == osg::Texture::LINEAR
+                && texture.getFilter(osg::Texture::MAG_FILTER) == osg::Texture::LINEAR;
+        }
+
+        osg::ref_ptr<osg::Image> createPageImage()
+        {
+            osg::ref_ptr<osg::Image> image = new osg::Image;
+            image->allocateImage(pageSize, pageSize, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+            std::fill(image->data(), image->data() + image->getTotalSizeInBytes(), 0);
+            return image;
+        }
+
+        osg::ref_ptr<osg::Texture2D> createPageTexture(osg::Image* image)
+        {
+            osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D(image);
+            texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+            texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+            texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+            texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+            return texture;
+        }
+
+        void copyImage(const osg::Image& source, osg::Image& destination, int x, int y)
+        {
+            const int width = source.s();
+            const int height = source.t();
+            for (int row = -padding; row < height + padding; ++row)
+            {
+                for (int column = -padding; column < width + padding; ++column)
+                {
+                    // Handles any pixel format including compressed ones
+                    const osg::Vec4 color = source.getColor(static_cast<unsigned>(std::clamp(column, 0, width - 1)),
+                        static_cast<unsigned>(std::clamp(row, 0, height - 1)));
+                    unsigned char* const pixel
+                        = destination.data(static_cast<unsigned>(x + padding + column),
+                            static_cast<unsigned>(y + padding + row));
+                    for (int i = 0; i < 4; ++i)
+                        pixel[i] = static_cast<unsigned char>(std::clamp(color[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+                }
+            }
+        }
+    }
+
+    const TextureAtlas::Region* TextureAtlas::get(const osg::Texture2D& texture)
+    {
+        const osg::Image* const image = texture.getImage();
+        if (image == nullptr)
+            return nullptr;
+
+        if (const auto it = mEntries.find(image); it != mEntries.end())
+        {
+            osg::ref_ptr<const osg::Image> alive;
+            if (it->second.mImage.lock(alive))
+            {
+                Entry& entry = it->second;
+                // Images changing after they were seen (e.g. the local map fog of war) are drawn with their own
+                // texture, which is updated when the image is dirtied
+                if (!entry.mRejected && alive->getModifiedCount() != entry.mModifiedCount)
+                {
+                    if (entry.mPage.has_value())
+                        --mNumImages;
+                    entry.mPage.reset();
+                    entry.mRejected = true;
+                }
+                if (!entry.mPage.has_value())
+                    return nullptr;
+                entry.mRegion.mTexture = mPages[*entry.mPage].mTexture;
+                return &entry.mRegion;
+            }
+            // A new image got the address of a deleted one
+            mEntries.erase(it);
+        }
+
+        Entry entry;
+        entry.mImage = image;
+        entry.mModifiedCount = image->getModifiedCount();
+        entry.mRejected = !isSuitable(texture);
+        if (!entry.mRejected)
+            mQueue.push_back(image);
+        mEntries.emplace(image, std::move(entry));
+        return nullptr;
+    }
+
+    void TextureAtlas::commit()
+    {
+        for (const osg::Image* key : mQueue)
+        {
+            const auto it = mEntries.find(key);
+            if (it == mEntries.end() || it->second.mRejected || it->second.mPage.has_value())
+                continue;
+            osg::ref_ptr<const osg::Image> image;
+            if (!it->second.mImage.lock(image))
+                continue;
+            if (!add(*image, it->second))
+                it->second.mRejected = true;
+        }
+        mQueue.clear();
+
+        for (Page& page : mPages)
+        {
+            if (!page.mChanged)
+                continue;
+            // The previous texture may still be in use by the draw thread
+            page.mTexture = createPageTexture(new osg::Image(*page.mImage, osg::CopyOp::DEEP_COPY_ALL));
+            page.mChanged = false;
+        }
+    }
+
+    bool TextureAtlas::add(const osg::Image& image, Entry& entry)
+    {
+        const int width = image.s() + 2 * padding;
+        const int height = image.t() + 2 * padding;
+
+        for (std::size_t i = 0; i < maxPages; ++i)
+        {
+            if (i == mPages.size())
+                mPages.push_back(Page{ .mImage = createPageImage() });
+
+            Page& page = mPages[i];
+            if (page.mShelfX + width > pageSize)
+            {
+                page.mShelfX = 0;
+                page.mShelfY += page.mShelfHeight;
+                page.mShelfHeight = 0;
+            }
+            if (page.mShelfY + height > pageSize)
+                continue;
+
+            const int x = page.mShelfX;
+            const int y = page.mShelfY;
+            copyImage(image, *page.mImage, x, y);
+            entry.mModifiedCount = image.getModifiedCount();
+            page.mShelfX += width;
+            page.mShelfHeight = std::max(page.mShelfHeight, height);
+            page.mChanged = true;
+
+            entry.mPage = i;
+            entry.mRegion.mOffset = osg::Vec2f(static_cast<float>(x + padding) / pageSize,
+                static_cast<float>(y + padding) / pageSize);
+            entry.mRegion.mScale = osg::Vec2f(
+                static_cast<float>(image.s()) / pageSize, static_cast<float>(image.t()) / pageSize);
+            ++mNumImages;
+            return true;
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef OPENMW_COMPONENTS_MYGUIPLATFORM_TEXTUREATLAS_H
+#define OPENMW_COMPONENTS_MYGUIPLATFORM_TEXTUREATLAS_H
+
+#include <osg/Vec2f>
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace osg
+{
+    class Image;
+    class Texture2D;
+}
+
+namespace MyGUIPlatform
+{
+    /// @brief Packs small static GUI images into shared textures, so consecutive widgets using different images can be
+    /// drawn with a single draw call.
+    /// @note Images are copied into the atlas when the frame is committed and are available from the next frame,
+    /// textures in use by the draw thread are never modified. Space is not reclaimed, images that don't fit anymore
+    /// are drawn with their own texture. So are images which are modified (dirtied) after they are first seen.
+    class TextureAtlas
+    {
+    public:
+        struct Region
+        {
+            osg::ref_ptr<osg::Texture2D> mTexture;
+            osg::Vec2f mOffset;
+            osg::Vec2f mScale;
+
+            osg::Vec2f map(const osg::Vec2f& uv) const
+            {
+                return osg::Vec2f(mOffset.x() + uv.x() * mScale.x(), mOffset.y() + uv.y() * mScale.y());
+            }
+        };
+
+        /// Returns the atlas region holding the image of the texture or nullptr if it is not packed (yet).
+        /// Suitable textures are queued to be packed by the next commit.
+        const Region* get(const osg::Texture2D& texture);
+
+        /// Copy the queued images into the atlas pages. Pages are replaced by new textures when modified.
+        void commit();
+
+        std::size_t getNumImages() const { return mNumImages; }
+
+        std::size_t getNumPages() const { return mPages.size(); }
+
+    private:
+        struct Page
+        {
+            osg::ref_ptr<osg::Image> mImage;
+            osg::ref_ptr<osg::Texture2D> mTexture;
+            int mShelfX = 0;
+            int mShelfY = 0;
+            int mShelfHeight = 0;
+            bool mChanged = false;
+        };
+
+        struct Entry
+        {
+            osg::observer_ptr<const osg::Image> mImage;
+            unsigned int mModifiedCount = 0;
+            std::optional<std::size_t> mPage;
+            bool mRejected = false;
+            Region mRegion;
+        };
+
+        std::vector<Page> mPages;
+        std::map<const osg::Image*, Entry> mEntries;
+        std::vector<const osg::Image*> mQueue;
+        std::size_t mNumImages = 0;
+
+        bool add(const osg::Image& image, Entry& entry);
+    };
+}
+
+#endif
@@ -2,13 +2,18 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/files/hash.hpp>
+#include <components/files/memorystream.hpp>
+#include <components/files/utils.hpp>
 
 #include <algorithm>
 #include <array>
+#include <cerrno>
+#include <istream>
 #include <limits>
 #include <map>
 #include <sstream>
 #include <stdexcept>
+#include <system_error>
 
 #include "controller.hpp"
 #include "data.hpp"
@@ -537,15 +542,36 @@ namespace Nif
     }
 
     void Reader::parse(Files::IStreamPtr&& stream)
+    {
+        // Decompressed archive files are already in memory
+        if (const auto* const buffer = dynamic_cast<const Files::MemBuf*>(stream->rdbuf()))
+            return parse(buffer->getRemaining());
+
+        std::vector<char> data;
+        try
+        {
+            data.resize(static_cast<std::size_t>(Files::getStreamSizeLeft(*stream)));
+            stream->read(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+        catch (const std::exception& e)
+        {
+            throw Nif::Exception(std::string("Failed to read file: ") + e.what(), mFilename);
+        }
+        if (stream->gcount() != static_cast<std::streamsize>(data.size()))
+            throw Nif::Exception("Failed to read file: " + std::generic_category().message(errno), mFilename);
+        parse(std::span<const char>(data));
+    }
+
+    void Reader::parse(std::span<const char> data)
     {
         const bool writeDebug = sWriteNifDebugLog;
         if (writeDebug)
             Log(Debug::Verbose) << "NIF Debug: Reading file: '" << mFilename << "'";
 
-        const std::array<std::uint64_t, 2> fileHash = Files::getHash(mFilename, *stream);
+        const std::array<std::uint64_t, 2> fileHash = Files::getHash(data);
         mHash.append(reinterpret_cast<const char*>(fileHash.data()), fileHash.size() * sizeof(std::uint64_t));
 
-        NIFStream nif(*this, std::move(stream), mEncoder);
+        NIFStream nif(*this, data, mEncoder);
 
         // Check the header string
         std::string head = nif.getVersionString();
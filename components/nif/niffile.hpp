@@ -5,6 +5,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include <components/files/istreamptr.hpp>
@@ -131,9 +132,12 @@ namespace Nif
         /// Open a NIF stream. The name is used for error messages.
         explicit Reader(NIFFile& file, const ToUTF8::StatelessUtf8Encoder* encoder);
 
-        /// Parse the file
+        /// Parse the file. Streams over a memory buffer are parsed in place, others are read into memory first.
         void parse(Files::IStreamPtr&& stream);
 
+        /// Parse the file content which must stay valid until the parsing is done
+        void parse(std::span<const char> data);
+
         /// Get a given record
         Record* getRecord(size_t index) const { return mRecords.at(index).get(); }
 
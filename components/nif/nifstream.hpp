@@ -3,20 +3,16 @@
 #ifndef OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 #define OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 
+#include <algorithm>
 #include <array>
 #include <cassert>
-#include <cerrno>
-#include <format>
-#include <istream>
-#include <stdexcept>
+#include <cstring>
+#include <span>
 #include <stdint.h>
 #include <string>
-#include <system_error>
 #include <type_traits>
 #include <vector>
 
-#include <components/files/istreamptr.hpp>
-#include <components/files/utils.hpp>
 #include <components/misc/endianness.hpp>
 #include <components/misc/float16.hpp>
 
@@ -37,42 +33,6 @@ namespace Nif
 
     class Reader;
 
-    template <std::size_t numInstances, typename T>
-    inline void readBufferOfType(Files::IStreamPtr& pIStream, T* dest)
-    {
-        static_assert(
-            std::is_arithmetic_v<T> || std::is_same_v<T, Misc::float16_t>, "Buffer element type is not arithmetic");
-        static_assert(!std::is_same_v<T, bool>, "Buffer element type is boolean");
-        pIStream->read((char*)dest, numInstances * sizeof(T));
-        if (pIStream->fail())
-            throw std::runtime_error(std::format("Failed to read typed ({}) dynamic buffer of {} instances: {}",
-                typeid(T).name(), numInstances, std::generic_category().message(errno)));
-        if constexpr (Misc::IS_BIG_ENDIAN)
-            for (std::size_t i = 0; i < numInstances; i++)
-                Misc::swapEndiannessInplace(dest[i]);
-    }
-
-    template <std::size_t numInstances, typename T>
-    inline void readBufferOfType(Files::IStreamPtr& pIStream, T (&dest)[numInstances])
-    {
-        readBufferOfType<numInstances>(pIStream, static_cast<T*>(dest));
-    }
-
-    template <typename T>
-    inline void readDynamicBufferOfType(Files::IStreamPtr& pIStream, T* dest, std::size_t numInstances)
-    {
-        static_assert(
-            std::is_arithmetic_v<T> || std::is_same_v<T, Misc::float16_t>, "Buffer element type is not arithmetic");
-        static_assert(!std::is_same_v<T, bool>, "Buffer element type is boolean");
-        pIStream->read((char*)dest, numInstances * sizeof(T));
-        if (pIStream->fail())
-            throw std::runtime_error(std::format("Failed to read typed ({}) dynamic buffer of {} instances: {}",
-                typeid(T).name(), numInstances, std::generic_category().message(errno)));
-        if constexpr (Misc::IS_BIG_ENDIAN)
-            for (std::size_t i = 0; i < numInstances; i++)
-                Misc::swapEndiannessInplace(dest[i]);
-    }
-
     class NIFStream;
 
     template <class T>
@@ -81,18 +41,19 @@ namespace Nif
     class NIFStream
     {
         const Reader& mReader;
-        Files::IStreamPtr mStream;
+        const char* mPosition;
+        const char* mEnd;
         const ToUTF8::StatelessUtf8Encoder* mEncoder;
         std::string mBuffer;
-        std::size_t mStreamSize;
 
     public:
+        /// Read from the contiguous file content. The data must outlive the stream.
         explicit NIFStream(
-            const Reader& reader, Files::IStreamPtr&& stream, const ToUTF8::StatelessUtf8Encoder* encoder)
+            const Reader& reader, std::span<const char> data, const ToUTF8::StatelessUtf8Encoder* encoder)
             : mReader(reader)
-            , mStream(std::move(stream))
+            , mPosition(data.data())
+            , mEnd(data.data() + data.size())
             , mEncoder(encoder)
-            , mStreamSize(static_cast<std::size_t>(Files::getStreamSizeLeft(*mStream)))
         {
         }
 
@@ -108,27 +69,31 @@ namespace Nif
             return (major << 24) + (minor << 16) + (patch << 8) + rev;
         }
 
-        void skip(size_t size) { mStream->ignore(size); }
+        /// Number of bytes left to read
+        std::size_t getRemainingSize() const { return static_cast<std::size_t>(mEnd - mPosition); }
+
+        /// Skip the given number of bytes, stops at the end of the data
+        void skip(size_t size) { mPosition += std::min(size, getRemainingSize()); }
 
         /// Read into a single instance of type
         template <class T>
         void read(T& data)
         {
-            readBufferOfType<1>(mStream, &data);
+            readBufferOfType<1>(&data);
         }
 
         /// Read multiple instances of type into an array
         template <class T, size_t size>
         void readArray(std::array<T, size>& arr)
         {
-            readBufferOfType<size>(mStream, arr.data());
+            readBufferOfType<size>(arr.data());
         }
 
         /// Read instances of type into a dynamic buffer
         template <class T>
         void read(T* dest, size_t size)
         {
-            readDynamicBufferOfType<T>(mStream, dest, size);
+            readDynamicBufferOfType(dest, size);
         }
 
         /// Read multiple instances of type into a vector
@@ -203,7 +168,48 @@ namespace Nif
         }
 
     private:
-        void checkStreamSize(std::size_t size);
+        void checkStreamSize(std::size_t size)
+        {
+            if (size > getRemainingSize()) [[unlikely]]
+                throwStreamSizeError(size);
+        }
+
+        [[noreturn]] void throwStreamSizeError(std::size_t size) const;
+
+        // Known size allows the copy to be compiled into plain loads
+        template <std::size_t numInstances, typename T>
+        void readBufferOfType(T* dest)
+        {
+            static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, Misc::float16_t>,
+                "Buffer element type is not arithmetic");
+            static_assert(!std::is_same_v<T, bool>, "Buffer element type is boolean");
+            checkStreamSize(numInstances * sizeof(T));
+            std::memcpy(dest, mPosition, numInstances * sizeof(T));
+            mPosition += numInstances * sizeof(T);
+            if constexpr (Misc::IS_BIG_ENDIAN)
+                for (std::size_t i = 0; i < numInstances; i++)
+                    Misc::swapEndiannessInplace(dest[i]);
+        }
+
+        template <std::size_t numInstances, typename T>
+        void readBufferOfType(T (&dest)[numInstances])
+        {
+            readBufferOfType<numInstances>(static_cast<T*>(dest));
+        }
+
+        template <typename T>
+        void readDynamicBufferOfType(T* dest, std::size_t numInstances)
+        {
+            static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, Misc::float16_t>,
+                "Buffer element type is not arithmetic");
+            static_assert(!std::is_same_v<T, bool>, "Buffer element type is boolean");
+            checkStreamSize(numInstances * sizeof(T));
+            std::memcpy(dest, mPosition, numInstances * sizeof(T));
+            mPosition += numInstances * sizeof(T);
+            if constexpr (Misc::IS_BIG_ENDIAN)
+                for (std::size_t i = 0; i < numInstances; i++)
+                    Misc::swapEndiannessInplace(dest[i]);
+        }
     };
 
     template <class T>
@@ -1190,7 +1190,7 @@ namespace NifOsg
             osg::Group* attachTo, osgParticle::ParticleSystem* partsys,
             osgParticle::ParticleProcessor::ReferenceFrame rf) const
         {
-            osgParticle::ModularProgram* program = new osgParticle::ModularProgram;
+            osgParticle::ModularProgram* program = new ParticleProgram;
             attachTo->addChild(program);
             program->setParticleSystem(partsys);
             program->setReferenceFrame(rf);
@@ -1209,7 +1209,7 @@ namespace NifOsg
                 else if (modifier->mRecordType == Nif::RC_NiParticleBomb)
                 {
                     auto bomb = static_cast<const Nif::NiParticleBomb*>(modifier.getPtr());
-                    osg::ref_ptr<osgParticle::ModularProgram> bombProgram(new osgParticle::ModularProgram);
+                    osg::ref_ptr<osgParticle::ModularProgram> bombProgram(new ParticleProgram);
                     attachTo->addChild(bombProgram);
                     bombProgram->setParticleSystem(partsys);
                     bombProgram->setReferenceFrame(rf);
@@ -1386,6 +1386,7 @@ namespace NifOsg
         {
             osg::ref_ptr<ParticleSystem> partsys(new ParticleSystem);
             partsys->setSortMode(osgParticle::ParticleSystem::SORT_BACK_TO_FRONT);
+            partsys->setLodEnabled(true);
 
             const Nif::NiParticleSystemController* partctrl = nullptr;
             for (Nif::NiTimeControllerPtr ctrl = nifNode->mController; !ctrl.empty(); ctrl = ctrl->mNext)
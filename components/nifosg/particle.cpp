@@ -1,12 +1,18 @@
 #include "particle.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include <osg/Geometry>
 #include <osg/MatrixTransform>
 #include <osg/ValueObject>
 
+#include <osgUtil/CullVisitor>
+
 #include <components/debug/debuglog.hpp>
 #include <components/misc/rng.hpp>
 #include <components/nif/data.hpp>
@@ -95,6 +101,60 @@ namespace
         std::optional<osg::Matrix> mLastMatrix;
         osg::Transform* mLastAppliedTransform = nullptr;
     };
+
+    // Lowest fraction of the emission rate and the quota kept by the LOD
+    constexpr float minLodDetail = 0.1f;
+
+    NifOsg::ParticleSystem::LodSettings sLodSettings;
+
+    // Spreads the simulation steps of off-screen particle systems across frames
+    std::atomic<unsigned int> sNextLodPhase{ 0 };
+
+    // Only written by the update traversal
+    unsigned int sLodFrameNumber = 0;
+    NifOsg::ParticleSystem::LodStats sLodStats;
+    // Distance to the view point and number of alive particles of the systems updated during the current frame
+    std::vector<std::pair<float, std::size_t>> sBudgetRequests;
+
+    // Particle systems at this distance or further don't create particles, computed from the previous frame.
+    // Off-screen systems use the maximum float value, so they are the first to be limited.
+    std::atomic<float> sBudgetDistance{ std::numeric_limits<float>::infinity() };
+
+    bool sBatchedParticleOperators = false;
+
+    void beginLodFrame(unsigned int frameNumber)
+    {
+        if (sLodFrameNumber == frameNumber)
+            return;
+        sLodFrameNumber = frameNumber;
+        sLodStats = NifOsg::ParticleSystem::LodStats{};
+
+        float budgetDistance = std::numeric_limits<float>::infinity();
+        if (sLodSettings.mBudget != 0)
+        {
+            std::sort(sBudgetRequests.begin(), sBudgetRequests.end());
+            std::size_t particles = 0;
+            for (const auto& [distance, count] : sBudgetRequests)
+            {
+                particles += count;
+                if (particles > sLodSettings.mBudget)
+                {
+                    budgetDistance = distance;
+                    break;
+                }
+            }
+        }
+        sBudgetRequests.clear();
+        sBudgetDistance = budgetDistance;
+    }
+
+    bool isLodSkippedFrame(const osgParticle::ParticleSystem* particleSystem, const osg::NodeVisitor& nv)
+    {
+        if (nv.getVisitorType() != osg::NodeVisitor::UPDATE_VISITOR)
+            return false;
+        const auto* const nifParticleSystem = dynamic_cast<const NifOsg::ParticleSystem*>(particleSystem);
+        return nifParticleSystem != nullptr && !nifParticleSystem->isLodStepFrame(nv.getTraversalNumber());
+    }
 }
 
 namespace NifOsg
@@ -103,6 +163,7 @@ namespace NifOsg
     ParticleSystem::ParticleSystem()
         : osgParticle::ParticleSystem()
         , mQuota(std::numeric_limits<int>::max())
+        , mLodPhase(sNextLodPhase++)
     {
         mNormalArray = new osg::Vec3Array(1);
         mNormalArray->setBinding(osg::Array::BIND_OVERALL);
@@ -112,6 +173,8 @@ namespace NifOsg
     ParticleSystem::ParticleSystem(const ParticleSystem& copy, const osg::CopyOp& copyop)
         : osgParticle::ParticleSystem(copy, copyop)
         , mQuota(copy.mQuota)
+        , mLodEnabled(copy.mLodEnabled)
+        , mLodPhase(sNextLodPhase++)
     {
         mNormalArray = new osg::Vec3Array(1);
         mNormalArray->setBinding(osg::Array::BIND_OVERALL);
@@ -129,9 +192,17 @@ namespace NifOsg
 
     osgParticle::Particle* ParticleSystem::createParticle(const osgParticle::Particle* ptemplate)
     {
-        if (numParticles() - numDeadParticles() < mQuota)
-            return osgParticle::ParticleSystem::createParticle(ptemplate);
-        return nullptr;
+        const int alive = numParticles() - numDeadParticles();
+        if (alive >= mQuota)
+            return nullptr;
+        if (mLodEnabled && sLodSettings.mEnabled)
+        {
+            if (mLodDetail < 1.f && alive >= std::max(1, static_cast<int>(mQuota * static_cast<double>(mLodDetail))))
+                return nullptr;
+            if (mLodBudgetDistance >= sBudgetDistance)
+                return nullptr;
+        }
+        return osgParticle::ParticleSystem::createParticle(ptemplate);
     }
 
     void ParticleSystem::drawImplementation(osg::RenderInfo& renderInfo) const
@@ -149,6 +220,113 @@ namespace NifOsg
         osgParticle::ParticleSystem::drawImplementation(renderInfo);
     }
 
+    void ParticleSystem::update(double dt, osg::NodeVisitor& nv)
+    {
+        if (!mLodEnabled || !sLodSettings.mEnabled)
+        {
+            osgParticle::ParticleSystem::update(dt, nv);
+            return;
+        }
+
+        updateLod(nv.getTraversalNumber());
+
+        if (!isLodStepFrame(nv.getTraversalNumber()))
+        {
+            mLodSkippedTime += dt;
+            return;
+        }
+
+        osgParticle::ParticleSystem::update(dt + mLodSkippedTime, nv);
+        mLodSkippedTime = 0.0;
+    }
+
+    void ParticleSystem::accept(osg::NodeVisitor& nv)
+    {
+        if (mLodEnabled && sLodSettings.mEnabled && nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR
+            && nv.validNodeMask(*this))
+            updateLodFromCull(nv);
+
+        osgParticle::ParticleSystem::accept(nv);
+    }
+
+    void ParticleSystem::setLodSettings(const LodSettings& settings)
+    {
+        sLodSettings = settings;
+    }
+
+    const ParticleSystem::LodSettings& ParticleSystem::getLodSettings()
+    {
+        return sLodSettings;
+    }
+
+    ParticleSystem::LodStats ParticleSystem::getLodStats(unsigned int frameNumber)
+    {
+        if (sLodFrameNumber != frameNumber)
+            return LodStats{};
+        return sLodStats;
+    }
+
+    bool ParticleSystem::isLodStepFrame(unsigned int traversalNumber) const
+    {
+        if (!mLodEnabled || !sLodSettings.mEnabled || !isOffscreen(traversalNumber))
+            return true;
+        return (traversalNumber + mLodPhase) % std::max(sLodSettings.mOffscreenInterval, 1u) == 0;
+    }
+
+    void ParticleSystem::updateLodFromCull(osg::NodeVisitor& nv)
+    {
+        // The cull visitor tests the bounds only after visiting the drawable, do it here to ignore culled systems
+        osgUtil::CullVisitor* cv = static_cast<osgUtil::CullVisitor*>(&nv);
+        const osg::BoundingBox& box = getBoundingBox();
+        if (!box.valid() || cv->isCulled(box))
+            return;
+
+        // A particle system can be culled several times per frame (shadow maps, water reflection, ...).
+        // Keep the largest projected size and the smallest distance so the main view gets the most detail.
+        if (mLodCullFrameNumber != nv.getTraversalNumber())
+        {
+            mLodCullFrameNumber = nv.getTraversalNumber();
+            mLodPixelSize = 0.f;
+            mLodDistance = std::numeric_limits<float>::max();
+        }
+
+        const osg::BoundingSphere bound(box);
+        mLodPixelSize = std::max(mLodPixelSize, cv->clampedPixelSize(bound));
+        mLodDistance = std::min(mLodDistance, cv->getDistanceToViewPoint(bound.center(), true));
+    }
+
+    void ParticleSystem::updateLod(unsigned int traversalNumber)
+    {
+        // The update traversal of this frame runs before its cull traversal, so the LOD is chosen from the last cull.
+        beginLodFrame(traversalNumber);
+
+        const std::size_t alive = static_cast<std::size_t>(numParticles() - numDeadParticles());
+        sLodStats.mParticles += alive;
+
+        if (isOffscreen(traversalNumber))
+        {
+            // Keep the detail chosen while visible, the system is not shown anyway
+            mLodBudgetDistance = std::numeric_limits<float>::max();
+            ++sLodStats.mOffscreen;
+        }
+        else
+        {
+            float detail = 1.f;
+            if (mLodPixelSize < sLodSettings.mFullDetailPixelSize)
+                detail = mLodPixelSize / sLodSettings.mFullDetailPixelSize;
+            if (mLodDistance > sLodSettings.mFullDetailDistance && sLodSettings.mFullDetailDistance > 0.f)
+                detail = std::min(detail, sLodSettings.mFullDetailDistance / mLodDistance);
+            mLodDetail = std::max(detail, minLodDetail);
+            mLodBudgetDistance = mLodDistance;
+            ++sLodStats.mVisible;
+        }
+
+        if (mLodBudgetDistance >= sBudgetDistance)
+            ++sLodStats.mOverBudget;
+
+        sBudgetRequests.emplace_back(mLodBudgetDistance, alive);
+    }
+
     void InverseWorldMatrix::operator()(osg::MatrixTransform* node, osg::NodeVisitor* nv)
     {
         osg::NodePath path = nv->getNodePath();
@@ -162,6 +340,137 @@ namespace NifOsg
         traverse(node, nv);
     }
 
+    void ParticleArrays::clear()
+    {
+        mParticles.clear();
+        mPositionX.clear();
+        mPositionY.clear();
+        mPositionZ.clear();
+        mVelocityX.clear();
+        mVelocityY.clear();
+        mVelocityZ.clear();
+        mAge.clear();
+        mLifeTime.clear();
+        mSize.clear();
+        mColor.clear();
+        mAlpha.clear();
+        mVelocityChanged = false;
+        mSizeChanged = false;
+        mColorChanged = false;
+    }
+
+    void ParticleArrays::add(osgParticle::Particle& particle)
+    {
+        const osg::Vec3& position = particle.getPosition();
+        const osg::Vec3& velocity = particle.getVelocity();
+        mParticles.push_back(&particle);
+        mPositionX.push_back(position.x());
+        mPositionY.push_back(position.y());
+        mPositionZ.push_back(position.z());
+        mVelocityX.push_back(velocity.x());
+        mVelocityY.push_back(velocity.y());
+        mVelocityZ.push_back(velocity.z());
+        mAge.push_back(particle.getAge());
+        mLifeTime.push_back(particle.getLifeTime());
+        // Written by the operators before being read, the values are scattered only when changed
+        mSize.push_back(0);
+        mColor.emplace_back();
+        mAlpha.push_back(0);
+    }
+
+    void ParticleArrays::gather(osgParticle::ParticleSystem& particleSystem)
+    {
+        clear();
+        const int count = particleSystem.numParticles();
+        for (int i = 0; i < count; ++i)
+        {
+            osgParticle::Particle* const particle = particleSystem.getParticle(i);
+            if (particle->isAlive())
+                add(*particle);
+        }
+    }
+
+    void ParticleArrays::scatter()
+    {
+        const std::size_t count = size();
+        if (mVelocityChanged)
+            for (std::size_t i = 0; i < count; ++i)
+                mParticles[i]->setVelocity(osg::Vec3(mVelocityX[i], mVelocityY[i], mVelocityZ[i]));
+        if (mSizeChanged)
+            for (std::size_t i = 0; i < count; ++i)
+                mParticles[i]->setSizeRange(osgParticle::rangef(mSize[i], mSize[i]));
+        if (mColorChanged)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                mParticles[i]->setColorRange(osgParticle::rangev4(mColor[i], mColor[i]));
+                mParticles[i]->setAlphaRange(osgParticle::rangef(mAlpha[i], mAlpha[i]));
+            }
+        }
+        mVelocityChanged = false;
+        mSizeChanged = false;
+        mColorChanged = false;
+    }
+
+    ParticleProgram::ParticleProgram(const ParticleProgram& copy, const osg::CopyOp& copyop)
+        : osgParticle::ModularProgram(copy, copyop)
+    {
+    }
+
+    void ParticleProgram::setBatchedOperators(bool enabled)
+    {
+        sBatchedParticleOperators = enabled;
+    }
+
+    bool ParticleProgram::getBatchedOperators()
+    {
+        return sBatchedParticleOperators;
+    }
+
+    void ParticleProgram::traverse(osg::NodeVisitor& nv)
+    {
+        // Skipping the traversal keeps the time of the last step, so the next one simulates the skipped frames as well
+        if (isLodSkippedFrame(getParticleSystem(), nv))
+            return;
+        osgParticle::ModularProgram::traverse(nv);
+    }
+
+    void ParticleProgram::execute(double dt)
+    {
+        if (!sBatchedParticleOperators)
+        {
+            osgParticle::ModularProgram::execute(dt);
+            return;
+        }
+
+        osgParticle::ParticleSystem* const particleSystem = getParticleSystem();
+        mParticles.gather(*particleSystem);
+
+        const int count = numOperators();
+        for (int i = 0; i < count; ++i)
+        {
+            osgParticle::Operator* const op = getOperator(i);
+            op->beginOperate(this);
+            if (op->isEnabled())
+            {
+                if (auto* const particleOperator = dynamic_cast<ParticleOperator*>(op))
+                {
+                    particleOperator->operateBatch(mParticles, dt);
+                }
+                else
+                {
+                    // Generic operators may change any particle attribute, so synchronize the copies around them
+                    mParticles.scatter();
+                    op->operateParticles(particleSystem, dt);
+                    mParticles.gather(*particleSystem);
+                }
+            }
+            op->endOperate();
+        }
+
+        mParticles.scatter();
+    }
+
     ParticleShooter::ParticleShooter(float minSpeed, float maxSpeed, float horizontalDir, float horizontalAngle,
         float verticalDir, float verticalAngle, float lifetime, float lifetimeRandom)
         : mMinSpeed(minSpeed)
@@ -231,7 +540,7 @@ namespace NifOsg
     }
 
     GrowFadeAffector::GrowFadeAffector(const GrowFadeAffector& copy, const osg::CopyOp& copyop)
-        : osgParticle::Operator(copy, copyop)
+        : ParticleOperator(copy, copyop)
     {
         mGrowTime = copy.mGrowTime;
         mFadeTime = copy.mFadeTime;
@@ -253,6 +562,23 @@ namespace NifOsg
         particle->setSizeRange(osgParticle::rangef(size, size));
     }
 
+    void GrowFadeAffector::operateBatch(ParticleArrays& particles, double /* dt */)
+    {
+        const std::size_t count = particles.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const double age = particles.mAge[i];
+            const double lifeTime = particles.mLifeTime[i];
+            float size = mCachedDefaultSize;
+            if (age < mGrowTime && mGrowTime != 0.f)
+                size *= static_cast<float>(age / mGrowTime);
+            if (lifeTime - age < mFadeTime && mFadeTime != 0.f)
+                size *= static_cast<float>(lifeTime - age) / mFadeTime;
+            particles.mSize[i] = size;
+        }
+        particles.mSizeChanged = true;
+    }
+
     ParticleColorAffector::ParticleColorAffector(const Nif::NiColorData* clrdata)
         : mData(clrdata->mKeyMap, osg::Vec4f(1, 1, 1, 1))
     {
@@ -261,7 +587,7 @@ namespace NifOsg
     ParticleColorAffector::ParticleColorAffector() {}
 
     ParticleColorAffector::ParticleColorAffector(const ParticleColorAffector& copy, const osg::CopyOp& copyop)
-        : osgParticle::Operator(copy, copyop)
+        : ParticleOperator(copy, copyop)
     {
         mData = copy.mData;
     }
@@ -278,6 +604,21 @@ namespace NifOsg
         particle->setAlphaRange(osgParticle::rangef(alpha, alpha));
     }
 
+    void ParticleColorAffector::operateBatch(ParticleArrays& particles, double /* dt */)
+    {
+        const std::size_t count = particles.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            assert(particles.mLifeTime[i] > 0);
+            const float time = static_cast<float>(particles.mAge[i] / particles.mLifeTime[i]);
+            osg::Vec4f color = mData.interpKey(time);
+            particles.mAlpha[i] = color.a();
+            color.a() = 1.0f;
+            particles.mColor[i] = color;
+        }
+        particles.mColorChanged = true;
+    }
+
     GravityAffector::GravityAffector(const Nif::NiGravity* gravity)
         : mForce(gravity->mForce)
         , mType(gravity->mType)
@@ -288,7 +629,7 @@ namespace NifOsg
     }
 
     GravityAffector::GravityAffector(const GravityAffector& copy, const osg::CopyOp& copyop)
-        : osgParticle::Operator(copy, copyop)
+        : ParticleOperator(copy, copyop)
     {
         mForce = copy.mForce;
         mType = copy.mType;
@@ -346,6 +687,65 @@ namespace NifOsg
         }
     }
 
+    void GravityAffector::operateBatch(ParticleArrays& particles, double dt)
+    {
+        const float magic = 1.6f;
+        const std::size_t count = particles.size();
+        switch (mType)
+        {
+            case Nif::ForceType::Wind:
+            {
+                const osg::Vec3f direction = mCachedWorldDirection;
+                if (mDecay == 0.f)
+                {
+                    const osg::Vec3f acceleration = direction * mForce * static_cast<float>(dt) * magic;
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        particles.mVelocityX[i] += acceleration.x();
+                        particles.mVelocityY[i] += acceleration.y();
+                        particles.mVelocityZ[i] += acceleration.z();
+                    }
+                    break;
+                }
+
+                const osg::Plane gravityPlane(mCachedWorldDirection, mCachedWorldPosition);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const osg::Vec3f position(
+                        particles.mPositionX[i], particles.mPositionY[i], particles.mPositionZ[i]);
+                    const float distance = std::abs(gravityPlane.distance(position));
+                    const float decayFactor = std::exp(-1.f * mDecay * distance);
+                    const osg::Vec3f acceleration = direction * mForce * static_cast<float>(dt) * decayFactor * magic;
+                    particles.mVelocityX[i] += acceleration.x();
+                    particles.mVelocityY[i] += acceleration.y();
+                    particles.mVelocityZ[i] += acceleration.z();
+                }
+                break;
+            }
+            case Nif::ForceType::Point:
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    osg::Vec3f diff = mCachedWorldPosition
+                        - osg::Vec3f(particles.mPositionX[i], particles.mPositionY[i], particles.mPositionZ[i]);
+
+                    float decayFactor = 1.f;
+                    if (mDecay != 0.f)
+                        decayFactor = std::exp(-1.f * mDecay * diff.length());
+
+                    diff.normalize();
+
+                    const osg::Vec3f acceleration = diff * mForce * static_cast<float>(dt) * decayFactor * magic;
+                    particles.mVelocityX[i] += acceleration.x();
+                    particles.mVelocityY[i] += acceleration.y();
+                    particles.mVelocityZ[i] += acceleration.z();
+                }
+                break;
+            }
+        }
+        particles.mVelocityChanged = true;
+    }
+
     ParticleBomb::ParticleBomb(const Nif::NiParticleBomb* bomb)
         : mRange(bomb->mRange)
         , mStrength(bomb->mStrength)
@@ -357,7 +757,7 @@ namespace NifOsg
     }
 
     ParticleBomb::ParticleBomb(const ParticleBomb& copy, const osg::CopyOp& copyop)
-        : osgParticle::Operator(copy, copyop)
+        : ParticleOperator(copy, copyop)
     {
         mRange = copy.mRange;
         mStrength = copy.mStrength;
@@ -424,6 +824,58 @@ namespace NifOsg
         particle->addVelocity(explosionDir * mStrength * decay * static_cast<float>(dt));
     }
 
+    void ParticleBomb::operateBatch(ParticleArrays& particles, double dt)
+    {
+        const std::size_t count = particles.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float decay = 1.f;
+            osg::Vec3f explosionDir;
+
+            const osg::Vec3f position(particles.mPositionX[i], particles.mPositionY[i], particles.mPositionZ[i]);
+            osg::Vec3f particleDir = position - mCachedWorldPosition;
+            float distance = particleDir.length();
+            particleDir.normalize();
+
+            switch (mDecayType)
+            {
+                case Nif::DecayType::None:
+                    break;
+                case Nif::DecayType::Linear:
+                    decay = 1.f - distance / mRange;
+                    break;
+                case Nif::DecayType::Exponential:
+                    decay = std::exp(-distance / mRange);
+                    break;
+            }
+
+            if (decay <= 0.f)
+                continue;
+
+            switch (mSymmetryType)
+            {
+                case Nif::SymmetryType::Spherical:
+                    explosionDir = particleDir;
+                    break;
+                case Nif::SymmetryType::Cylindrical:
+                    explosionDir = particleDir - mCachedWorldDirection * (mCachedWorldDirection * particleDir);
+                    explosionDir.normalize();
+                    break;
+                case Nif::SymmetryType::Planar:
+                    explosionDir = mCachedWorldDirection;
+                    if (explosionDir * particleDir < 0)
+                        explosionDir = -explosionDir;
+                    break;
+            }
+
+            const osg::Vec3f acceleration = explosionDir * mStrength * decay * static_cast<float>(dt);
+            particles.mVelocityX[i] += acceleration.x();
+            particles.mVelocityY[i] += acceleration.y();
+            particles.mVelocityZ[i] += acceleration.z();
+        }
+        particles.mVelocityChanged = true;
+    }
+
     Emitter::Emitter()
         : osgParticle::Emitter()
         , mFlags(0)
@@ -451,12 +903,33 @@ namespace NifOsg
     {
     }
 
+    void Emitter::traverse(osg::NodeVisitor& nv)
+    {
+        // Skipping the traversal keeps the time of the last step, so the next one emits for the skipped frames as well
+        if (isLodSkippedFrame(getParticleSystem(), nv))
+            return;
+        osgParticle::Emitter::traverse(nv);
+    }
+
     void Emitter::emitParticles(double dt)
     {
         int n = mCounter->numParticlesToCreate(dt);
         if (n == 0)
             return;
 
+        if (const auto* particleSystem = dynamic_cast<const ParticleSystem*>(getParticleSystem()))
+        {
+            const float detail = particleSystem->getLodDetail();
+            if (detail < 1.f)
+            {
+                mLodEmissionRemainder += n * detail;
+                n = static_cast<int>(mLodEmissionRemainder);
+                mLodEmissionRemainder -= n;
+                if (n == 0)
+                    return;
+            }
+        }
+
         osg::Matrix worldToPs;
 
         // maybe this could be optimized by halting at the lowest common ancestor of the particle and emitter nodes
@@ -614,7 +1087,7 @@ namespace NifOsg
     }
 
     PlanarCollider::PlanarCollider(const PlanarCollider& copy, const osg::CopyOp& copyop)
-        : osgParticle::Operator(copy, copyop)
+        : ParticleOperator(copy, copyop)
         , mBounceFactor(copy.mBounceFactor)
         , mExtents(copy.mExtents)
         , mPosition(copy.mPosition)
@@ -670,6 +1143,45 @@ namespace NifOsg
         particle->setVelocity(reflectedVelocity);
     }
 
+    void PlanarCollider::operateBatch(ParticleArrays& particles, double /* dt */)
+    {
+        const osg::Vec3f normal = mPlaneInParticleSpace.getNormal();
+        const float halfExtentX = mExtents.x() * 0.5f;
+        const float halfExtentY = mExtents.y() * 0.5f;
+        const std::size_t count = particles.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const osg::Vec3f velocity(particles.mVelocityX[i], particles.mVelocityY[i], particles.mVelocityZ[i]);
+
+            // Does the particle in question move towards the collider?
+            const float velDotProduct = velocity * normal;
+            if (velDotProduct <= 0)
+                continue;
+
+            // Does it intersect the collider's plane? Same as osg::Plane::intersect for a zero radius sphere
+            const osg::Vec3f position(particles.mPositionX[i], particles.mPositionY[i], particles.mPositionZ[i]);
+            if (static_cast<float>(mPlaneInParticleSpace.distance(position)) <= 0)
+                continue;
+
+            // Is it inside the collider's bounds?
+            const osg::Vec3f relativePos = position - mPositionInParticleSpace;
+            const float xDotProduct = relativePos * mXVectorInParticleSpace;
+            const float yDotProduct = relativePos * mYVectorInParticleSpace;
+            if (-halfExtentX > xDotProduct || halfExtentX < xDotProduct)
+                continue;
+            if (-halfExtentY > yDotProduct || halfExtentY < yDotProduct)
+                continue;
+
+            // Deflect the particle
+            osg::Vec3f reflectedVelocity = velocity - normal * (2 * velDotProduct);
+            reflectedVelocity *= mBounceFactor;
+            particles.mVelocityX[i] = reflectedVelocity.x();
+            particles.mVelocityY[i] = reflectedVelocity.y();
+            particles.mVelocityZ[i] = reflectedVelocity.z();
+        }
+        particles.mVelocityChanged = true;
+    }
+
     SphericalCollider::SphericalCollider(const Nif::NiSphericalCollider* collider)
         : mBounceFactor(collider->mBounceFactor)
         , mSphere(collider->mCenter, collider->mRadius)
@@ -682,7 +1194,7 @@ namespace NifOsg
     }
 
     SphericalCollider::SphericalCollider(const SphericalCollider& copy, const osg::CopyOp& copyop)
-        : osgParticle::Operator(copy, copyop)
+        : ParticleOperator(copy, copyop)
         , mBounceFactor(copy.mBounceFactor)
         , mSphere(copy.mSphere)
         , mSphereInParticleSpace(copy.mSphereInParticleSpace)
@@ -738,4 +1250,56 @@ namespace NifOsg
         }
     }
 
+    void SphericalCollider::operateBatch(ParticleArrays& particles, double dt)
+    {
+        const osg::Vec3f center = mSphereInParticleSpace.center();
+        const float radius2 = mSphereInParticleSpace.radius2();
+        const std::size_t count = particles.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const osg::Vec3f position(particles.mPositionX[i], particles.mPositionY[i], particles.mPositionZ[i]);
+            const osg::Vec3f velocity(particles.mVelocityX[i], particles.mVelocityY[i], particles.mVelocityZ[i]);
+
+            const osg::Vec3f cent = position - center; // vector from sphere center to particle
+
+            const bool insideSphere = cent.length2() <= radius2;
+
+            // if outside, make sure the particle is flying towards the sphere
+            if (insideSphere || (cent * velocity < 0.0f))
+            {
+                // Collision test (finding point of contact) is performed by solving a quadratic equation:
+                // ||vec(cent) + vec(vel)*k|| = R      /^2
+                // k^2 + 2*k*(vec(cent)*vec(vel))/||vec(vel)||^2 + (||vec(cent)||^2 - R^2)/||vec(vel)||^2 = 0
+
+                const float b = -(cent * velocity) / velocity.length2();
+
+                const osg::Vec3f u = cent + velocity * b;
+
+                if (insideSphere || (u.length2() < radius2))
+                {
+                    const float d = (radius2 - u.length2()) / velocity.length2();
+                    const float k = insideSphere ? (std::sqrt(d) + b) : (b - std::sqrt(d));
+
+                    if (k < dt)
+                    {
+                        // collision detected; reflect off the tangent plane
+                        const osg::Vec3f contact = position + velocity * k;
+
+                        osg::Vec3f normal = contact - center;
+                        normal.normalize();
+
+                        const float dotproduct = velocity * normal;
+
+                        osg::Vec3f reflectedVelocity = velocity - normal * (2 * dotproduct);
+                        reflectedVelocity *= mBounceFactor;
+                        particles.mVelocityX[i] = reflectedVelocity.x();
+                        particles.mVelocityY[i] = reflectedVelocity.y();
+                        particles.mVelocityZ[i] = reflectedVelocity.z();
+                    }
+                }
+            }
+        }
+        particles.mVelocityChanged = true;
+    }
+
 }
@@ -2,9 +2,11 @@
 #define OPENMW_COMPONENTS_NIFOSG_PARTICLE_H
 
 #include <optional>
+#include <vector>
 
 #include <osgParticle/Counter>
 #include <osgParticle/Emitter>
+#include <osgParticle/ModularProgram>
 #include <osgParticle/Operator>
 #include <osgParticle/Particle>
 #include <osgParticle/Placer>
@@ -39,9 +41,71 @@ namespace NifOsg
 
         void drawImplementation(osg::RenderInfo& renderInfo) const override;
 
+        void update(double dt, osg::NodeVisitor& nv) override;
+
+        void accept(osg::NodeVisitor& nv) override;
+
+        /// @brief Thresholds used to lower the simulation cost of particle systems that are far away, small on the
+        /// screen or off-screen. Shared by all particle systems with LOD enabled.
+        /// @note The emission rate and the quota are scaled down together, so the particle density is reduced but the
+        /// lifetime and the shape of the effect are kept.
+        struct LodSettings
+        {
+            bool mEnabled = false;
+            /// Projected size (in pixels) below which the emission rate and the quota are scaled down proportionally.
+            float mFullDetailPixelSize = 0.f;
+            /// Distance to the view point beyond which the emission rate and the quota are scaled down proportionally.
+            float mFullDetailDistance = 0.f;
+            /// Number of frames between two simulation steps of off-screen particle systems. Each step simulates the
+            /// time elapsed since the previous one.
+            unsigned int mOffscreenInterval = 1;
+            /// Maximum number of alive particles of all particle systems, 0 means no limit. When exceeded, the
+            /// systems furthest from the view point stop emitting.
+            std::size_t mBudget = 0;
+        };
+
+        static void setLodSettings(const LodSettings& settings);
+
+        static const LodSettings& getLodSettings();
+
+        struct LodStats
+        {
+            std::size_t mVisible = 0;
+            std::size_t mOffscreen = 0;
+            std::size_t mOverBudget = 0;
+            std::size_t mParticles = 0;
+        };
+
+        /// Number of LOD-enabled particle systems processed by the update traversal of the given frame.
+        static LodStats getLodStats(unsigned int frameNumber);
+
+        void setLodEnabled(bool enabled) { mLodEnabled = enabled; }
+
+        /// Fraction of the emission rate and the quota kept by the LOD.
+        float getLodDetail() const { return mLodDetail; }
+
+        /// Whether the particle system and its emitters and programs are simulated by the given update traversal.
+        bool isLodStepFrame(unsigned int traversalNumber) const;
+
     private:
         int mQuota;
         osg::ref_ptr<osg::Vec3Array> mNormalArray;
+
+        bool mLodEnabled = false;
+        unsigned int mLodPhase;
+        unsigned int mLodCullFrameNumber = 0;
+        float mLodPixelSize = 0.f;
+        float mLodDistance = 0.f;
+        float mLodDetail = 1.f;
+        // Distance used to prioritize the particle budget, new systems are served first until their first update
+        float mLodBudgetDistance = 0.f;
+        double mLodSkippedTime = 0.0;
+
+        bool isOffscreen(unsigned int traversalNumber) const { return mLodCullFrameNumber + 1 < traversalNumber; }
+
+        void updateLodFromCull(osg::NodeVisitor& nv);
+
+        void updateLod(unsigned int traversalNumber);
     };
 
     // HACK: Particle doesn't allow setting the initial age, but we need this for loading the particle system state
@@ -98,7 +162,77 @@ namespace NifOsg
         float mLifetimeRandom;
     };
 
-    class PlanarCollider : public osgParticle::Operator
+    // Alive particles of a particle system copied into separate arrays per attribute, so operators can process all of
+    // them with a tight loop. Only attributes changed by the operators are written back.
+    struct ParticleArrays
+    {
+        std::vector<osgParticle::Particle*> mParticles;
+        std::vector<float> mPositionX;
+        std::vector<float> mPositionY;
+        std::vector<float> mPositionZ;
+        std::vector<float> mVelocityX;
+        std::vector<float> mVelocityY;
+        std::vector<float> mVelocityZ;
+        std::vector<double> mAge;
+        std::vector<double> mLifeTime;
+        std::vector<float> mSize;
+        std::vector<osg::Vec4f> mColor;
+        std::vector<float> mAlpha;
+        bool mVelocityChanged = false;
+        bool mSizeChanged = false;
+        bool mColorChanged = false;
+
+        std::size_t size() const { return mParticles.size(); }
+
+        void clear();
+
+        void add(osgParticle::Particle& particle);
+
+        void gather(osgParticle::ParticleSystem& particleSystem);
+
+        void scatter();
+    };
+
+    // Operator that can also process all alive particles of a system at once, used by ParticleProgram when batched
+    // operators are enabled. operate() and operateBatch() must produce the same results.
+    class ParticleOperator : public osgParticle::Operator
+    {
+    public:
+        ParticleOperator() = default;
+        ParticleOperator(const ParticleOperator& copy, const osg::CopyOp& copyop)
+            : osgParticle::Operator(copy, copyop)
+        {
+        }
+
+        virtual void operateBatch(ParticleArrays& particles, double dt) = 0;
+    };
+
+    // Subclass ModularProgram to skip the simulation steps dropped by the particle LOD. When batched operators are
+    // enabled, ParticleOperators are applied to the whole particle system instead of each particle, and other operators
+    // are applied per particle as osgParticle::ModularProgram does.
+    class ParticleProgram : public osgParticle::ModularProgram
+    {
+    public:
+        ParticleProgram() = default;
+        ParticleProgram(const ParticleProgram& copy, const osg::CopyOp& copyop);
+
+        META_Node(NifOsg, ParticleProgram)
+
+        /// Disabled by default, osgParticle::ModularProgram applies the operators per particle then.
+        static void setBatchedOperators(bool enabled);
+
+        static bool getBatchedOperators();
+
+        void traverse(osg::NodeVisitor& nv) override;
+
+    protected:
+        void execute(double dt) override;
+
+    private:
+        ParticleArrays mParticles;
+    };
+
+    class PlanarCollider : public ParticleOperator
     {
     public:
         PlanarCollider(const Nif::NiPlanarCollider* collider);
@@ -109,6 +243,7 @@ namespace NifOsg
 
         void beginOperate(osgParticle::Program* program) override;
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateBatch(ParticleArrays& particles, double dt) override;
 
     private:
         float mBounceFactor{ 0.f };
@@ -119,7 +254,7 @@ namespace NifOsg
         osg::Plane mPlane, mPlaneInParticleSpace;
     };
 
-    class SphericalCollider : public osgParticle::Operator
+    class SphericalCollider : public ParticleOperator
     {
     public:
         SphericalCollider(const Nif::NiSphericalCollider* collider);
@@ -130,6 +265,7 @@ namespace NifOsg
 
         void beginOperate(osgParticle::Program* program) override;
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateBatch(ParticleArrays& particles, double dt) override;
 
     private:
         float mBounceFactor;
@@ -137,7 +273,7 @@ namespace NifOsg
         osg::BoundingSphere mSphereInParticleSpace;
     };
 
-    class GrowFadeAffector : public osgParticle::Operator
+    class GrowFadeAffector : public ParticleOperator
     {
     public:
         GrowFadeAffector(float growTime, float fadeTime);
@@ -150,6 +286,7 @@ namespace NifOsg
 
         void beginOperate(osgParticle::Program* program) override;
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateBatch(ParticleArrays& particles, double dt) override;
 
     private:
         float mGrowTime;
@@ -158,7 +295,7 @@ namespace NifOsg
         float mCachedDefaultSize;
     };
 
-    class ParticleColorAffector : public osgParticle::Operator
+    class ParticleColorAffector : public ParticleOperator
     {
     public:
         ParticleColorAffector(const Nif::NiColorData* clrdata);
@@ -170,12 +307,13 @@ namespace NifOsg
         META_Object(NifOsg, ParticleColorAffector)
 
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateBatch(ParticleArrays& particles, double dt) override;
 
     private:
         Vec4Interpolator mData;
     };
 
-    class GravityAffector : public osgParticle::Operator
+    class GravityAffector : public ParticleOperator
     {
     public:
         GravityAffector(const Nif::NiGravity* gravity);
@@ -187,6 +325,7 @@ namespace NifOsg
         META_Object(NifOsg, GravityAffector)
 
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateBatch(ParticleArrays& particles, double dt) override;
         void beginOperate(osgParticle::Program*) override;
 
     private:
@@ -199,7 +338,7 @@ namespace NifOsg
         osg::Vec3f mCachedWorldDirection;
     };
 
-    class ParticleBomb : public osgParticle::Operator
+    class ParticleBomb : public ParticleOperator
     {
     public:
         ParticleBomb(const Nif::NiParticleBomb* bomb);
@@ -211,6 +350,7 @@ namespace NifOsg
         META_Object(NifOsg, ParticleBomb)
 
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateBatch(ParticleArrays& particles, double dt) override;
         void beginOperate(osgParticle::Program*) override;
 
     private:
@@ -260,6 +400,8 @@ namespace NifOsg
 
         void emitParticles(double dt) override;
 
+        void traverse(osg::NodeVisitor& nv) override;
+
         void setShooter(osgParticle::Shooter* shooter) { mShooter = shooter; }
         void setPlacer(osgParticle::Placer* placer) { mPlacer = placer; }
         void setCounter(osgParticle::Counter* counter) { mCounter = counter; }
@@ -278,6 +420,9 @@ namespace NifOsg
 
         std::optional<int> mGeometryEmitterTarget;
         osg::observer_ptr<osg::Vec3Array> mCachedGeometryEmitter;
+
+        // Fraction of a particle left over when the emission is scaled down by the LOD
+        float mLodEmissionRemainder = 0.f;
     };
 
 }
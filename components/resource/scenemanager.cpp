@@ -1,5 +1,6 @@
 #include "scenemanager.hpp"
 
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
 
@@ -24,6 +25,7 @@
 #include <osgDB/SharedStateManager>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 
 #include <components/nifosg/controller.hpp>
 #include <components/nifosg/nifloader.hpp>
@@ -45,6 +47,7 @@
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/optimizer.hpp>
 #include <components/sceneutil/riggeometryosgaextension.hpp>
+#include <components/sceneutil/uploadscheduler.hpp>
 #include <components/sceneutil/util.hpp>
 #include <components/sceneutil/visitor.hpp>
 
@@ -994,54 +997,181 @@ namespace Resource
 
     osg::ref_ptr<const osg::Node> SceneManager::getTemplate(VFS::Path::NormalizedView path, bool compile)
     {
-        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(path);
-        if (obj)
-            return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(obj.get()));
-        else
+        std::shared_ptr<PendingTemplate> pending;
+        bool created = false;
+        if (osg::ref_ptr<const osg::Node> loaded = findTemplate(path, pending, created))
+            return loaded;
+
+        // Take over the conversion if it's only scheduled, waiting for a queued job may block all worker threads
+        if (!pending->mStarted.exchange(true))
+            return loadPendingTemplate(path, compile, *pending);
+
+        OPENMW_TRACE_ZONE("SceneManager::getTemplate wait");
+        return pending->mFuture.get();
+    }
+
+    std::shared_future<osg::ref_ptr<const osg::Node>> SceneManager::getTemplateAsync(
+        VFS::Path::NormalizedView path, Misc::JobPriority priority)
+    {
+        const auto makeReady = [](osg::ref_ptr<const osg::Node> value) {
+            std::promise<osg::ref_ptr<const osg::Node>> promise;
+            promise.set_value(std::move(value));
+            return promise.get_future().share();
+        };
+
+        if (mJobSystem == nullptr)
+            return makeReady(getTemplate(path));
+
+        std::shared_ptr<PendingTemplate> pending;
+        bool created = false;
+        if (osg::ref_ptr<const osg::Node> loaded = findTemplate(path, pending, created))
+            return makeReady(std::move(loaded));
+
+        bool schedule = created;
         {
-            osg::ref_ptr<osg::Node> loaded;
-            try
-            {
-                loaded = load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager);
-            }
-            catch (const std::exception& e)
+            const std::lock_guard lock(mPendingTemplatesMutex);
+            if (created || (priority > pending->mPriority && !pending->mStarted))
             {
-                Log(Debug::Error) << "Failed to load '" << path << "': " << e.what() << ", using marker_error instead";
-                loaded = cloneErrorMarker();
+                pending->mPriority = priority;
+                schedule = true;
             }
+        }
 
-            // set filtering settings
-            SetFilterSettingsVisitor setFilterSettingsVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
-            loaded->accept(setFilterSettingsVisitor);
-            SetFilterSettingsControllerVisitor setFilterSettingsControllerVisitor(
-                mMinFilter, mMagFilter, mMaxAnisotropy);
-            loaded->accept(setFilterSettingsControllerVisitor);
+        // A job with higher priority for a queued conversion makes the one with lower priority a no-op
+        if (schedule)
+            scheduleTemplate(path, pending);
 
-            osg::ref_ptr<Shader::ShaderVisitor> shaderVisitor(createShaderVisitor());
-            loaded->accept(*shaderVisitor);
+        return pending->mFuture;
+    }
 
-            if (canOptimize(path.value()))
-            {
-                SceneUtil::Optimizer optimizer;
-                optimizer.setSharedStateManager(mSharedStateManager, &mSharedStateMutex);
-                optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+    osg::ref_ptr<const osg::Node> SceneManager::findTemplate(
+        VFS::Path::NormalizedView path, std::shared_ptr<PendingTemplate>& pending, bool& created)
+    {
+        if (osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(path))
+            return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(obj.get()));
 
-                static const unsigned int options
-                    = getOptimizationOptions() | SceneUtil::Optimizer::SHARE_DUPLICATE_STATE;
+        const std::lock_guard lock(mPendingTemplatesMutex);
 
-                optimizer.optimize(loaded, options);
-            }
-            else
-                shareState(loaded);
+        const auto it = mPendingTemplates.find(path);
+        if (it != mPendingTemplates.end())
+        {
+            pending = it->second;
+            return nullptr;
+        }
 
-            if (compile && mIncrementalCompileOperation)
-                mIncrementalCompileOperation->add(loaded);
-            else
-                loaded->getBound();
+        // The template is added to the cache before the request is removed so it's not loaded twice
+        if (osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(path))
+            return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(obj.get()));
 
-            mCache->addEntryToObjectCache(path.value(), loaded);
-            return loaded;
+        pending = std::make_shared<PendingTemplate>();
+        created = true;
+        mPendingTemplates.emplace(path, pending);
+        return nullptr;
+    }
+
+    osg::ref_ptr<const osg::Node> SceneManager::loadPendingTemplate(
+        VFS::Path::NormalizedView path, bool compile, PendingTemplate& pending)
+    {
+        const auto removePending = [&] {
+            const std::lock_guard lock(mPendingTemplatesMutex);
+            const auto it = mPendingTemplates.find(path);
+            if (it != mPendingTemplates.end())
+                mPendingTemplates.erase(it);
+        };
+
+        const auto start = std::chrono::steady_clock::now();
+
+        osg::ref_ptr<const osg::Node> loaded;
+        try
+        {
+            loaded = loadTemplate(path, compile);
+        }
+        catch (...)
+        {
+            removePending();
+            pending.mPromise.set_exception(std::current_exception());
+            throw;
+        }
+
+        const std::uint64_t time = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        mLoadedTemplates.fetch_add(1, std::memory_order_relaxed);
+        mTemplateLoadTime.fetch_add(time, std::memory_order_relaxed);
+        std::uint64_t maxTime = mMaxTemplateLoadTime.load(std::memory_order_relaxed);
+        while (time > maxTime && !mMaxTemplateLoadTime.compare_exchange_weak(maxTime, time, std::memory_order_relaxed))
+        {
         }
+        Log(Debug::Debug) << "Loaded template '" << path << "' in " << static_cast<double>(time) / 1000 << " ms";
+
+        removePending();
+        pending.mPromise.set_value(loaded);
+        return loaded;
+    }
+
+    void SceneManager::scheduleTemplate(VFS::Path::NormalizedView path, std::shared_ptr<PendingTemplate> pending)
+    {
+        const Misc::JobPriority priority = pending->mPriority;
+        mJobSystem->schedule(
+            [this, path = VFS::Path::Normalized(path), pending = std::move(pending)] {
+                if (pending->mStarted.exchange(true))
+                    return;
+                OPENMW_TRACE_ZONE("SceneManager::getTemplateAsync");
+                try
+                {
+                    loadPendingTemplate(path, true, *pending);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Error) << "Failed to load template '" << path << "': " << e.what();
+                }
+            },
+            priority);
+    }
+
+    osg::ref_ptr<osg::Node> SceneManager::loadTemplate(VFS::Path::NormalizedView path, bool compile)
+    {
+        OPENMW_TRACE_ZONE("SceneManager::loadTemplate");
+
+        osg::ref_ptr<osg::Node> loaded;
+        try
+        {
+            loaded = load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Failed to load '" << path << "': " << e.what() << ", using marker_error instead";
+            loaded = cloneErrorMarker();
+        }
+
+        // set filtering settings
+        SetFilterSettingsVisitor setFilterSettingsVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
+        loaded->accept(setFilterSettingsVisitor);
+        SetFilterSettingsControllerVisitor setFilterSettingsControllerVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
+        loaded->accept(setFilterSettingsControllerVisitor);
+
+        osg::ref_ptr<Shader::ShaderVisitor> shaderVisitor(createShaderVisitor());
+        loaded->accept(*shaderVisitor);
+
+        if (canOptimize(path.value()))
+        {
+            SceneUtil::Optimizer optimizer;
+            optimizer.setSharedStateManager(mSharedStateManager, &mSharedStateMutex);
+            optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+
+            static const unsigned int options = getOptimizationOptions() | SceneUtil::Optimizer::SHARE_DUPLICATE_STATE;
+
+            optimizer.optimize(loaded, options);
+        }
+        else
+            shareState(loaded);
+
+        if (compile && mIncrementalCompileOperation)
+            mIncrementalCompileOperation->add(loaded);
+        else
+            loaded->getBound();
+
+        mCache->addEntryToObjectCache(path.value(), loaded);
+        return loaded;
     }
 
     osg::ref_ptr<osg::Node> SceneManager::getInstance(VFS::Path::NormalizedView path)
@@ -1227,6 +1357,9 @@ namespace Resource
                 frameNumber, "Compiling", static_cast<double>(mIncrementalCompileOperation->getToCompile().size()));
         }
 
+        if (const auto* scheduler = dynamic_cast<const SceneUtil::UploadScheduler*>(mIncrementalCompileOperation.get()))
+            scheduler->reportStats(frameNumber, *stats);
+
         {
             std::lock_guard<std::mutex> lock(mSharedStateMutex);
             stats->setAttribute(
@@ -1236,6 +1369,19 @@ namespace Resource
         }
 
         Resource::reportStats("Node", frameNumber, mCache->getStats(), *stats);
+
+        {
+            std::lock_guard<std::mutex> lock(mPendingTemplatesMutex);
+            stats->setAttribute(frameNumber, "Template Pending", static_cast<double>(mPendingTemplates.size()));
+        }
+
+        const std::uint64_t loadedTemplates = mLoadedTemplates.load(std::memory_order_relaxed);
+        stats->setAttribute(frameNumber, "Template Loaded", static_cast<double>(loadedTemplates));
+        if (loadedTemplates > 0)
+            stats->setAttribute(frameNumber, "Template AvgTime",
+                static_cast<double>(mTemplateLoadTime.load(std::memory_order_relaxed)) / loadedTemplates / 1000);
+        stats->setAttribute(frameNumber, "Template MaxTime",
+            static_cast<double>(mMaxTemplateLoadTime.load(std::memory_order_relaxed)) / 1000);
     }
 
     osg::ref_ptr<Shader::ShaderVisitor> SceneManager::createShaderVisitor(const std::string& shaderPrefix)
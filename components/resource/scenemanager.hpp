@@ -2,6 +2,10 @@
 #define OPENMW_COMPONENTS_RESOURCE_SCENEMANAGER_H
 
 #include <array>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -11,6 +15,7 @@
 
 #include "resourcemanager.hpp"
 
+#include <components/misc/jobsystem.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <filesystem>
 
@@ -161,8 +166,20 @@ namespace Resource
         /// @note If the given filename does not exist or fails to load, an error marker mesh will be used instead.
         ///  If even the error marker mesh can not be found, an exception is thrown.
         /// @note Thread safe.
+        /// Concurrent requests for the same template wait for the single conversion in progress.
         osg::ref_ptr<const osg::Node> getTemplate(VFS::Path::NormalizedView path, bool compile = true);
 
+        /// Convert the scene template on a job system thread. Returns a ready future when the template is loaded or
+        /// there is no job system. A request with higher priority speeds up the queued conversion of the same path.
+        /// If getTemplate is called for the path before the job is started the conversion is done by that caller.
+        /// @note Do not wait for the result on a job system thread, use getTemplate instead.
+        /// @note Thread safe.
+        std::shared_future<osg::ref_ptr<const osg::Node>> getTemplateAsync(
+            VFS::Path::NormalizedView path, Misc::JobPriority priority = Misc::JobPriority::Normal);
+
+        /// Set the job system used by getTemplateAsync. Must be reset before the job system is destroyed.
+        void setJobSystem(Misc::JobSystem* jobSystem) { mJobSystem = jobSystem; }
+
         /// Clone osg::Node safely.
         /// @note Thread safe.
         static osg::ref_ptr<osg::Node> cloneNode(const osg::Node* base);
@@ -233,12 +250,38 @@ namespace Resource
         void setWeatherParticleOcclusion(bool value) { mWeatherParticleOcclusion = value; }
 
     private:
+        struct PendingTemplate
+        {
+            std::atomic_bool mStarted{ false };
+            Misc::JobPriority mPriority = Misc::JobPriority::Normal;
+            std::promise<osg::ref_ptr<const osg::Node>> mPromise;
+            std::shared_future<osg::ref_ptr<const osg::Node>> mFuture = mPromise.get_future().share();
+        };
+
         osg::ref_ptr<Shader::ShaderVisitor> createShaderVisitor(const std::string& shaderPrefix = "objects");
         osg::ref_ptr<osg::Node> loadErrorMarker();
         osg::ref_ptr<osg::Node> cloneErrorMarker();
 
+        /// Returns the cached template or the request in progress, adds a new request when there is none.
+        osg::ref_ptr<const osg::Node> findTemplate(
+            VFS::Path::NormalizedView path, std::shared_ptr<PendingTemplate>& pending, bool& created);
+
+        osg::ref_ptr<const osg::Node> loadPendingTemplate(
+            VFS::Path::NormalizedView path, bool compile, PendingTemplate& pending);
+
+        osg::ref_ptr<osg::Node> loadTemplate(VFS::Path::NormalizedView path, bool compile);
+
+        void scheduleTemplate(VFS::Path::NormalizedView path, std::shared_ptr<PendingTemplate> pending);
+
         mutable std::mutex mSharedStateMutex;
 
+        Misc::JobSystem* mJobSystem = nullptr;
+        mutable std::mutex mPendingTemplatesMutex;
+        std::map<VFS::Path::Normalized, std::shared_ptr<PendingTemplate>, std::less<>> mPendingTemplates;
+        std::atomic_uint64_t mLoadedTemplates{ 0 };
+        std::atomic_uint64_t mTemplateLoadTime{ 0 };
+        std::atomic_uint64_t mMaxTemplateLoadTime{ 0 };
+
         std::unique_ptr<Shader::ShaderManager> mShaderManager;
         std::string mNormalMapPattern;
         std::string mNormalHeightMapPattern;
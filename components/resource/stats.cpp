@@ -104,6 +104,13 @@ namespace Resource
                 "CellPreloader Expired",
             };
 
+            constexpr std::string_view templates[] = {
+                "Template Pending",
+                "Template Loaded",
+                "Template AvgTime",
+                "Template MaxTime",
+            };
+
             constexpr std::string_view navMesh[] = {
                 "NavMesh Jobs",
                 "NavMesh Removing",
@@ -126,6 +133,37 @@ namespace Resource
                 "NavMesh Recast Water",
             };
 
+            constexpr std::string_view animation[] = {
+                "Animation FullRate",
+                "Animation HalfRate",
+                "Animation QuarterRate",
+                "Animation Offscreen",
+            };
+
+            constexpr std::string_view upload[] = {
+                "Upload Pending",
+                "Upload PendingBytes",
+                "Upload Sets",
+                "Upload Bytes",
+            };
+
+            constexpr std::string_view particle[] = {
+                "Particle Visible",
+                "Particle Offscreen",
+                "Particle OverBudget",
+                "Particle Count",
+            };
+
+            constexpr std::string_view water[] = {
+                "Water Reflection Drawables",
+            };
+
+            constexpr std::string_view gui[] = {
+                "GUI DrawCalls",
+                "GUI Batches",
+                "GUI Atlas Images",
+            };
+
             std::vector<std::string> statNames;
 
             for (std::string_view name : firstPage)
@@ -141,12 +179,32 @@ namespace Resource
             for (std::string_view name : cellPreloader)
                 statNames.emplace_back(name);
 
+            for (std::string_view name : templates)
+                statNames.emplace_back(name);
+
             while (statNames.size() % itemsPerPage != 0)
                 statNames.emplace_back();
 
             for (std::string_view name : navMesh)
                 statNames.emplace_back(name);
 
+            statNames.emplace_back();
+
+            for (std::string_view name : animation)
+                statNames.emplace_back(name);
+
+            for (std::string_view name : upload)
+                statNames.emplace_back(name);
+
+            for (std::string_view name : particle)
+                statNames.emplace_back(name);
+
+            for (std::string_view name : water)
+                statNames.emplace_back(name);
+
+            for (std::string_view name : gui)
+                statNames.emplace_back(name);
+
             return statNames;
         }
 
@@ -460,7 +460,7 @@ void MWShadowTechnique::ComputeLightSpaceBounds::reset()
 
 void MWShadowTechnique::ComputeLightSpaceBounds::apply(osg::Node& node)
 {
-    if (isCulled(node)) return;
+    if (coversLightSpace() || isCulled(node)) return;
 
     // push the culling mode.
     pushCurrentMask();
@@ -478,7 +478,7 @@ void MWShadowTechnique::ComputeLightSpaceBounds::apply(osg::Group& node)
 
 void MWShadowTechnique::ComputeLightSpaceBounds::apply(osg::Drawable& drawable)
 {
-    if (isCulled(drawable)) return;
+    if (coversLightSpace() || isCulled(drawable)) return;
 
     // push the culling mode.
     pushCurrentMask();
@@ -508,7 +508,7 @@ void MWShadowTechnique::ComputeLightSpaceBounds::apply(osg::Projection&)
 
 void MWShadowTechnique::ComputeLightSpaceBounds::apply(osg::Transform& transform)
 {
-    if (isCulled(transform)) return;
+    if (coversLightSpace() || isCulled(transform)) return;
 
     // push the culling mode.
     pushCurrentMask();
@@ -116,6 +116,14 @@ namespace SceneUtil {
 
             void reset() override;
 
+            /// The bounds cover the whole light space horizontally, so the projection won't be clamped and the rest of
+            /// the scene doesn't need to be traversed.
+            bool coversLightSpace() const
+            {
+                return _bb.valid() && _bb.xMin() <= -1.0f && _bb.xMax() >= 1.0f && _bb.yMin() <= -1.0f
+                    && _bb.yMax() >= 1.0f;
+            }
+
             osg::BoundingBox _bb;
         };
 
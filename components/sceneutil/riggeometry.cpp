@@ -161,7 +161,10 @@ namespace SceneUtil
         }
 
         unsigned int traversalNumber = nv->getTraversalNumber();
-        if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
+        // Bones didn't move since the last skinning if the skeleton update was skipped by the animation LOD
+        const bool skippedByLod = mSkeleton->getLodSettings().mEnabled
+            && mSkeleton->getLastUpdateTraversalNumber() <= mLastFrameNumber;
+        if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && (!mSkeleton->getActive() || skippedByLod)))
         {
             osg::Geometry& geom = *getGeometry(mLastFrameNumber);
             nv->pushOntoNodePath(&geom);
@@ -216,6 +216,7 @@ namespace SceneUtil
                 "NifOsg::ParticleSystem",
                 "NifOsg::GravityAffector",
                 "NifOsg::ParticleBomb",
+                "NifOsg::ParticleProgram",
                 "NifOsg::GrowFadeAffector",
                 "NifOsg::InverseWorldMatrix",
                 "NifOsg::StaticBoundingBoxCallback",
@@ -2,13 +2,44 @@
 
 #include <osg/MatrixTransform>
 
+#include <osgUtil/CullVisitor>
+
 #include <components/debug/debuglog.hpp>
 #include <components/misc/strings/lower.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
 
 namespace SceneUtil
 {
+    namespace
+    {
+        // Spreads the updates of skeletons sharing the same update interval across frames
+        std::atomic<unsigned int> sNextLodPhase{ 0 };
+
+        // Only written by the update traversal
+        unsigned int sLodStatsFrameNumber = 0;
+        Skeleton::LodStats sLodStats;
+
+        void countLod(unsigned int frameNumber, unsigned int interval, bool offscreen)
+        {
+            if (sLodStatsFrameNumber != frameNumber)
+            {
+                sLodStatsFrameNumber = frameNumber;
+                sLodStats = Skeleton::LodStats{};
+            }
+
+            if (offscreen)
+                ++sLodStats.mOffscreen;
+            else if (interval >= 4)
+                ++sLodStats.mQuarterRate;
+            else if (interval >= 2)
+                ++sLodStats.mHalfRate;
+            else
+                ++sLodStats.mFullRate;
+        }
+    }
 
     class InitBoneCacheVisitor : public osg::NodeVisitor
     {
@@ -39,6 +70,7 @@ namespace SceneUtil
         , mActive(Active)
         , mLastFrameNumber(0)
         , mLastCullFrameNumber(0)
+        , mLodPhase(sNextLodPhase++)
     {
     }
 
@@ -49,6 +81,8 @@ namespace SceneUtil
         , mActive(copy.mActive)
         , mLastFrameNumber(0)
         , mLastCullFrameNumber(0)
+        , mLodSettings(copy.mLodSettings)
+        , mLodPhase(sNextLodPhase++)
     {
     }
 
@@ -121,6 +155,63 @@ namespace SceneUtil
         return mActive != Inactive;
     }
 
+    void Skeleton::setLodSettings(const LodSettings& settings)
+    {
+        mLodSettings = settings;
+        mUpdateInterval = 1;
+    }
+
+    Skeleton::LodStats Skeleton::getLodStats(unsigned int frameNumber)
+    {
+        if (sLodStatsFrameNumber != frameNumber)
+            return LodStats{};
+        return sLodStats;
+    }
+
+    void Skeleton::updateLodFromCull(osg::NodeVisitor& nv)
+    {
+        // A skeleton can be culled several times per frame (shadow maps, water reflection, ...).
+        // Keep the largest projected size and the smallest distance so we never pick a lower rate than the main view.
+        if (mLodCullFrameNumber != nv.getTraversalNumber())
+        {
+            mLodCullFrameNumber = nv.getTraversalNumber();
+            mLodPixelSize = 0.f;
+            mLodDistance = std::numeric_limits<float>::max();
+        }
+
+        osgUtil::CullVisitor* cv = static_cast<osgUtil::CullVisitor*>(&nv);
+        const osg::BoundingSphere& bound = getBound();
+        if (!bound.valid())
+            return;
+        mLodPixelSize = std::max(mLodPixelSize, cv->clampedPixelSize(bound));
+        mLodDistance = std::min(mLodDistance, cv->getDistanceToViewPoint(bound.center(), true));
+    }
+
+    bool Skeleton::isLodUpdateFrame(unsigned int traversalNumber)
+    {
+        // The update traversal of this frame runs before its cull traversal, so the LOD is chosen from the last cull.
+        const bool offscreen = mLastCullFrameNumber + 1 < traversalNumber;
+
+        unsigned int interval = 1;
+        if (offscreen)
+        {
+            // Nothing gets skinned while off-screen, only keep the bounding box reasonably up to date.
+            interval = 4;
+        }
+        else
+        {
+            if (mLodDistance > mLodSettings.mQuarterRateDistance || mLodPixelSize < mLodSettings.mQuarterRatePixelSize)
+                interval = 4;
+            else if (mLodDistance > mLodSettings.mHalfRateDistance || mLodPixelSize < mLodSettings.mHalfRatePixelSize)
+                interval = 2;
+        }
+
+        mUpdateInterval = interval;
+        countLod(traversalNumber, interval, offscreen);
+
+        return (traversalNumber + mLodPhase) % interval == 0;
+    }
+
     void Skeleton::markDirty()
     {
         mLastFrameNumber = 0;
@@ -136,9 +227,16 @@ namespace SceneUtil
                 return;
             if (mActive == SemiActive && mLastFrameNumber != 0 && mLastCullFrameNumber + 3 <= nv.getTraversalNumber())
                 return;
+            if (mLodSettings.mEnabled && mLastFrameNumber != 0 && !isLodUpdateFrame(nv.getTraversalNumber()))
+                return;
+            mLastUpdateTraversalNumber = nv.getTraversalNumber();
         }
         else if (nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR)
+        {
             mLastCullFrameNumber = nv.getTraversalNumber();
+            if (mLodSettings.mEnabled)
+                updateLodFromCull(nv);
+        }
 
         osg::Group::traverse(nv);
     }
@@ -3,6 +3,7 @@
 
 #include <osg/Group>
 
+#include <cstddef>
 #include <memory>
 #include <unordered_map>
 
@@ -56,6 +57,43 @@ namespace SceneUtil
 
         bool getActive() const;
 
+        /// @brief Thresholds used to lower the animation update rate of skeletons that are far away or small on screen.
+        /// @note When the update traversal is skipped, keyframe controllers are not sampled, child rigs keep their
+        /// previous pose and bounding box and are not skinned again until the next update.
+        struct LodSettings
+        {
+            bool mEnabled = false;
+            /// Projected size (in pixels) below which the skeleton is updated every 2nd frame.
+            float mHalfRatePixelSize = 0.f;
+            /// Projected size (in pixels) below which the skeleton is updated every 4th frame.
+            float mQuarterRatePixelSize = 0.f;
+            /// Distance to the view point beyond which the skeleton is updated every 2nd frame.
+            float mHalfRateDistance = 0.f;
+            /// Distance to the view point beyond which the skeleton is updated every 4th frame.
+            float mQuarterRateDistance = 0.f;
+        };
+
+        void setLodSettings(const LodSettings& settings);
+
+        const LodSettings& getLodSettings() const { return mLodSettings; }
+
+        /// Number of frames between two updates, as chosen by the LOD for the last update traversal.
+        unsigned int getUpdateInterval() const { return mUpdateInterval; }
+
+        /// Traversal number of the last update traversal that was not skipped.
+        unsigned int getLastUpdateTraversalNumber() const { return mLastUpdateTraversalNumber; }
+
+        struct LodStats
+        {
+            std::size_t mFullRate = 0;
+            std::size_t mHalfRate = 0;
+            std::size_t mQuarterRate = 0;
+            std::size_t mOffscreen = 0;
+        };
+
+        /// Number of LOD-enabled skeletons processed by the update traversal of the given frame per update rate.
+        static LodStats getLodStats(unsigned int frameNumber);
+
         void traverse(osg::NodeVisitor& nv) override;
 
         void markDirty();
@@ -78,6 +116,18 @@ namespace SceneUtil
 
         unsigned int mLastFrameNumber;
         unsigned int mLastCullFrameNumber;
+
+        LodSettings mLodSettings;
+        unsigned int mLodPhase;
+        unsigned int mUpdateInterval = 1;
+        unsigned int mLastUpdateTraversalNumber = 0;
+        unsigned int mLodCullFrameNumber = 0;
+        float mLodPixelSize = 0.f;
+        float mLodDistance = 0.f;
+
+        void updateLodFromCull(osg::NodeVisitor& nv);
+
+        bool isLodUpdateFrame(unsigned int traversalNumber);
     };
 
 }
@@ -0,0 +1,253 @@
+#include "uploadscheduler.hpp"
+
+#include <osg/Geometry>
+#include <osg/GraphicsContext>
+#include <osg/Image>
+#include <osg/NodeVisitor>
+#include <osg/Stats>
+#include <osg/Texture>
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        // Estimates the size of the data to be uploaded to the GPU, shared data is counted once
+        class EstimateUploadSizeVisitor : public osg::NodeVisitor
+        {
+        public:
+            EstimateUploadSizeVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                addStateSet(node.getStateSet());
+                traverse(node);
+            }
+
+            void apply(osg::Drawable& drawable) override
+            {
+                addStateSet(drawable.getStateSet());
+
+                osg::Geometry* const geometry = drawable.asGeometry();
+                if (geometry == nullptr)
+                    return;
+
+                osg::Geometry::ArrayList arrays;
+                geometry->getArrayList(arrays);
+                for (const osg::ref_ptr<osg::Array>& array : arrays)
+                    addBufferData(array.get());
+
+                osg::Geometry::DrawElementsList elements;
+                geometry->getDrawElementsList(elements);
+                for (const osg::DrawElements* value : elements)
+                    addBufferData(value);
+            }
+
+            std::size_t getBytes() const { return mBytes; }
+
+        private:
+            std::set<const osg::BufferData*> mVisited;
+            std::size_t mBytes = 0;
+
+            void addBufferData(const osg::BufferData* data)
+            {
+                if (data != nullptr && mVisited.insert(data).second)
+                    mBytes += data->getTotalDataSize();
+            }
+
+            void addStateSet(const osg::StateSet* stateSet)
+            {
+                if (stateSet == nullptr)
+                    return;
+                for (const osg::StateSet::AttributeList& attributes : stateSet->getTextureAttributeList())
+                    for (const auto& [type, attribute] : attributes)
+                        if (const osg::Texture* const texture = attribute.first->asTexture())
+                            for (unsigned i = 0; i < texture->getNumImages(); ++i)
+                                if (const osg::Image* const image = texture->getImage(i))
+                                    if (mVisited.insert(image).second)
+                                        mBytes += image->getTotalSizeInBytesIncludingMipmaps();
+            }
+        };
+
+        std::size_t estimateUploadSize(osg::Node* node)
+        {
+            if (node == nullptr)
+                return 0;
+            EstimateUploadSizeVisitor visitor;
+            node->accept(visitor);
+            return visitor.getBytes();
+        }
+    }
+
+    void UploadScheduler::add(osg::Node* subgraphToCompile, const osg::Vec3f& worldCenter)
+    {
+        add(new CompileSet(subgraphToCompile), worldCenter);
+    }
+
+    void UploadScheduler::add(CompileSet* compileSet, const osg::Vec3f& worldCenter)
+    {
+        const bool callBuildCompileMap = compileSet->_compileMap.empty();
+        {
+            const std::lock_guard lock(mMutex);
+            mPositions[compileSet] = worldCenter;
+        }
+        add(compileSet, callBuildCompileMap);
+    }
+
+    void UploadScheduler::setViewPoint(const osg::Vec3f& value)
+    {
+        const std::lock_guard lock(mMutex);
+        mViewPoint = value;
+    }
+
+    void UploadScheduler::operator()(osg::GraphicsContext* context)
+    {
+        const osg::FrameStamp* const frameStamp = context->getState()->getFrameStamp();
+        const double currentTime = frameStamp != nullptr ? frameStamp->getReferenceTime() : 0.0;
+
+        // Same time split as done by osgUtil::IncrementalCompileOperation
+        const double targetFrameTime = 1.0 / getTargetFrameRate();
+        const double availableTime
+            = std::max((targetFrameTime - context->getTimeSinceLastClear()) * getConservativeTimeRatio(),
+                getMinimumTimeAvailableForGLCompileAndDeletePerFrame());
+        const double flushTime = availableTime * getFlushTimeRatio();
+        double compileTime = availableTime - flushTime;
+
+        osg::Vec3f viewPoint;
+        std::size_t maxBytes = 0;
+        {
+            const std::lock_guard lock(mMutex);
+            viewPoint = mViewPoint;
+            maxBytes = mMaxBytesPerFrame;
+            if (mMaxTimePerFrame > 0)
+                compileTime = std::min(compileTime, mMaxTimePerFrame);
+        }
+
+        CompileInfo compileInfo(context, this);
+        compileInfo.maxNumObjectsToCompile = getMaximumNumOfObjectsToCompilePerFrame();
+        compileInfo.allocatedTime = compileTime;
+        compileInfo.compileAll = _compileAllTillFrameNumber > _currentFrameNumber;
+
+        std::vector<osg::ref_ptr<CompileSet>> pending;
+        {
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_toCompileMutex);
+            pending.assign(_toCompile.begin(), _toCompile.end());
+        }
+
+        // Keep the entries for the pending sets only, the others are compiled or removed
+        std::map<const CompileSet*, Entry> entries;
+        for (const osg::ref_ptr<CompileSet>& compileSet : pending)
+        {
+            if (const auto it = mEntries.find(compileSet.get()); it != mEntries.end())
+            {
+                entries.insert(mEntries.extract(it));
+                continue;
+            }
+            Entry entry;
+            entry.mBytes = estimateUploadSize(compileSet->_subgraphToCompile.get());
+            entry.mOrder = mNextOrder++;
+            {
+                const std::lock_guard lock(mMutex);
+                if (const auto it = mPositions.find(compileSet.get()); it != mPositions.end())
+                {
+                    entry.mHasPosition = true;
+                    entry.mWorldCenter = it->second;
+                    mPositions.erase(it);
+                }
+            }
+            if (entry.mHasPosition && compileSet->_subgraphToCompile != nullptr)
+            {
+                const osg::BoundingSphere& bound = compileSet->_subgraphToCompile->getBound();
+                entry.mWorldCenter += bound.center();
+                entry.mRadius = bound.radius();
+            }
+            entries.emplace(compileSet.get(), entry);
+        }
+        mEntries.swap(entries);
+
+        // Sets without position go first, then by descending screen coverage
+        std::vector<std::tuple<float, std::size_t, osg::ref_ptr<CompileSet>>> ordered;
+        ordered.reserve(pending.size());
+        std::size_t pendingBytes = 0;
+        for (osg::ref_ptr<CompileSet>& compileSet : pending)
+        {
+            const Entry& entry = mEntries.at(compileSet.get());
+            pendingBytes += entry.mBytes;
+            float priority = -std::numeric_limits<float>::max();
+            if (entry.mHasPosition)
+                priority = -entry.mRadius / std::max((entry.mWorldCenter - viewPoint).length(), 1.f);
+            ordered.emplace_back(priority, entry.mOrder, std::move(compileSet));
+        }
+        std::sort(ordered.begin(), ordered.end(), [](const auto& lhs, const auto& rhs) {
+            return std::tie(std::get<0>(lhs), std::get<1>(lhs)) < std::tie(std::get<0>(rhs), std::get<1>(rhs));
+        });
+
+        CompileSets toCompile;
+        std::size_t selectedBytes = 0;
+        for (auto& [priority, order, compileSet] : ordered)
+        {
+            const std::size_t bytes = mEntries.at(compileSet.get()).mBytes;
+            if (!compileInfo.compileAll && maxBytes != 0 && !toCompile.empty() && selectedBytes + bytes > maxBytes)
+                break;
+            selectedBytes += bytes;
+            toCompile.push_back(compileSet);
+        }
+
+        const CompileSets selected = toCompile;
+        if (!toCompile.empty())
+            compileSets(toCompile, compileInfo);
+
+        // Compiled sets are removed from the list
+        std::size_t uploadedBytes = 0;
+        std::size_t uploadedSets = 0;
+        for (const osg::ref_ptr<CompileSet>& compileSet : selected)
+        {
+            if (std::find(toCompile.begin(), toCompile.end(), compileSet) != toCompile.end())
+                continue;
+            uploadedBytes += mEntries.at(compileSet.get()).mBytes;
+            ++uploadedSets;
+        }
+
+        mPending = ordered.size() - uploadedSets;
+        mPendingBytes = pendingBytes - uploadedBytes;
+        mUploadedBytes = uploadedBytes;
+        mUploadedSets = uploadedSets;
+
+        double availableFlushTime = flushTime;
+        osg::flushDeletedGLObjects(context->getState()->getContextID(), currentTime, availableFlushTime);
+    }
+
+    void UploadScheduler::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Upload Pending", static_cast<double>(mPending.load()));
+        stats.setAttribute(frameNumber, "Upload PendingBytes", static_cast<double>(mPendingBytes.load()));
+        stats.setAttribute(frameNumber, "Upload Sets", static_cast<double>(mUploadedSets.load()));
+        stats.setAttribute(frameNumber, "Upload Bytes", static_cast<double>(mUploadedBytes.load()));
+    }
+
+    void addToCompile(
+        osgUtil::IncrementalCompileOperation& operation, osg::Node* subgraphToCompile, const osg::Vec3f& worldCenter)
+    {
+        if (auto* const scheduler = dynamic_cast<UploadScheduler*>(&operation))
+            scheduler->add(subgraphToCompile, worldCenter);
+        else
+            operation.add(subgraphToCompile);
+    }
+
+    void addToCompile(osgUtil::IncrementalCompileOperation& operation,
+        osgUtil::IncrementalCompileOperation::CompileSet* compileSet, const osg::Vec3f& worldCenter)
+    {
+        if (auto* const scheduler = dynamic_cast<UploadScheduler*>(&operation))
+            scheduler->add(compileSet, worldCenter);
+        else
+            operation.add(compileSet, false);
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_UPLOADSCHEDULER_H
+#define OPENMW_COMPONENTS_SCENEUTIL_UPLOADSCHEDULER_H
+
+#include <osg/Vec3f>
+#include <osgUtil/IncrementalCompileOperation>
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace SceneUtil
+{
+    /// @brief Incremental compile operation limiting the GL objects uploaded per frame by the estimated size in bytes
+    /// in addition to the time.
+    /// @note Subgraphs added with a world position are compiled in the order of the screen coverage estimated from the
+    /// bounding sphere and the distance to the view point. The others are compiled first in the order they were added,
+    /// these are usually templates for the objects being inserted into the scene.
+    class UploadScheduler : public osgUtil::IncrementalCompileOperation
+    {
+    public:
+        using osgUtil::IncrementalCompileOperation::add;
+
+        /// Add a subgraph located at the given world position.
+        void add(osg::Node* subgraphToCompile, const osg::Vec3f& worldCenter);
+
+        /// Add a compile set with already built compile map for a subgraph located at the given world position.
+        void add(CompileSet* compileSet, const osg::Vec3f& worldCenter);
+
+        /// Number of bytes to upload per frame, 0 means no limit. At least one compile set is processed each frame.
+        void setMaxBytesPerFrame(std::size_t value) { mMaxBytesPerFrame = value; }
+
+        /// Limit in seconds for the time derived from the target frame rate, 0 means no limit.
+        void setMaxTimePerFrame(double value) { mMaxTimePerFrame = value; }
+
+        void setViewPoint(const osg::Vec3f& value);
+
+        void operator()(osg::GraphicsContext* context) override;
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+    private:
+        struct Entry
+        {
+            std::size_t mBytes = 0;
+            bool mHasPosition = false;
+            osg::Vec3f mWorldCenter;
+            float mRadius = 0;
+            std::size_t mOrder = 0;
+        };
+
+        mutable std::mutex mMutex;
+        osg::Vec3f mViewPoint;
+        // Positions of the sets not seen by the draw thread yet
+        std::map<const CompileSet*, osg::Vec3f> mPositions;
+        std::size_t mMaxBytesPerFrame = 0;
+        double mMaxTimePerFrame = 0;
+
+        // Accessed only by the draw thread
+        std::map<const CompileSet*, Entry> mEntries;
+        std::size_t mNextOrder = 0;
+
+        std::atomic_size_t mPending{ 0 };
+        std::atomic_size_t mPendingBytes{ 0 };
+        std::atomic_size_t mUploadedBytes{ 0 };
+        std::atomic_size_t mUploadedSets{ 0 };
+    };
+
+    /// Add a subgraph located at the given world position to compile, the position is used if the operation is an
+    /// UploadScheduler.
+    void addToCompile(
+        osgUtil::IncrementalCompileOperation& operation, osg::Node* subgraphToCompile, const osg::Vec3f& worldCenter);
+
+    /// Add a compile set with already built compile map, the position is used if the operation is an UploadScheduler.
+    void addToCompile(osgUtil::IncrementalCompileOperation& operation,
+        osgUtil::IncrementalCompileOperation::CompileSet* compileSet, const osg::Vec3f& worldCenter);
+}
+
+#endif
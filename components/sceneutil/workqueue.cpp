@@ -1,8 +1,10 @@
 #include "workqueue.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
+#include <components/misc/jobsystem.hpp>
 
-#include <numeric>
+#include <exception>
 
 namespace SceneUtil
 {
@@ -34,7 +36,6 @@ namespace SceneUtil
     }
 
     WorkQueue::WorkQueue(std::size_t workerThreads)
-        : mIsReleased(false)
     {
         start(workerThreads);
     }
@@ -46,25 +47,15 @@ namespace SceneUtil
 
     void WorkQueue::start(std::size_t workerThreads)
     {
-        {
-            const std::lock_guard lock(mMutex);
-            mIsReleased = false;
-        }
-        while (mThreads.size() < workerThreads)
-            mThreads.emplace_back(std::make_unique<WorkThread>(*this));
+        if (mJobSystem == nullptr)
+            mJobSystem = std::make_unique<Misc::JobSystem>(workerThreads);
+        else
+            mJobSystem->startThreads(workerThreads);
     }
 
     void WorkQueue::stop()
     {
-        {
-            std::unique_lock<std::mutex> lock(mMutex);
-            while (!mQueue.empty())
-                mQueue.pop_back();
-            mIsReleased = true;
-            mCondition.notify_all();
-        }
-
-        mThreads.clear();
+        mJobSystem = nullptr;
     }
 
     void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
@@ -75,80 +66,44 @@ namespace SceneUtil
             return;
         }
 
-#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
-        item->doWork();
-        item->signalDone();
-#else
-        std::unique_lock<std::mutex> lock(mMutex);
-        if (front)
-            mQueue.push_front(std::move(item));
-        else
-            mQueue.push_back(std::move(item));
-        mCondition.notify_one();
-#endif
-    }
-
-    osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem()
-    {
-        std::unique_lock<std::mutex> lock(mMutex);
-        while (mQueue.empty() && !mIsReleased)
+        if (mJobSystem == nullptr)
         {
-            mCondition.wait(lock);
-        }
-        if (!mQueue.empty())
-        {
-            osg::ref_ptr<WorkItem> item = std::move(mQueue.front());
-            mQueue.pop_front();
-            return item;
+            // Release the threads waiting for the item
+            Log(Debug::Warning) << "Warning: work item added to a stopped work queue is aborted";
+            item->abort();
+            item->signalDone();
+            return;
         }
-        return nullptr;
+
+        mJobSystem->schedule(
+            [item = std::move(item)] {
+                OPENMW_TRACE_ZONE("WorkItem::doWork");
+                // Waiting threads must be released even if the item failed
+                try
+                {
+                    item->doWork();
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Error) << "Error: work item failed: " << e.what();
+                }
+                catch (...)
+                {
+                    Log(Debug::Error) << "Error: work item failed with unknown exception";
+                }
+                item->signalDone();
+            },
+            front ? Misc::JobPriority::High : Misc::JobPriority::Normal);
     }
 
     size_t WorkQueue::getNumItems() const
     {
-        std::unique_lock<std::mutex> lock(mMutex);
-        return mQueue.size();
+        return mJobSystem == nullptr ? 0 : mJobSystem->getNumQueuedJobs();
     }
 
     size_t WorkQueue::getNumActiveThreads() const
     {
-        return std::accumulate(
-            mThreads.begin(), mThreads.end(), 0u, [](auto r, const auto& t) { return r + t->isActive(); });
-    }
-
-    WorkThread::WorkThread(WorkQueue& workQueue)
-        : mWorkQueue(&workQueue)
-        , mActive(false)
-#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
-        , mThread([this] { run(); })
-#endif
-    {
-    }
-
-    WorkThread::~WorkThread()
-    {
-#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
-        mThread.join();
-#endif
-    }
-
-    void WorkThread::run()
-    {
-        while (true)
-        {
-            osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
-            if (!item)
-                return;
-            mActive = true;
-            item->doWork();
-            item->signalDone();
-            mActive = false;
-        }
-    }
-
-    bool WorkThread::isActive() const
-    {
-        return mActive;
+        return mJobSystem == nullptr ? 0 : mJobSystem->getNumActiveThreads();
     }
 
 }
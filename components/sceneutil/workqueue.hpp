@@ -6,10 +6,13 @@
 
 #include <atomic>
 #include <condition_variable>
-#include <deque>
+#include <memory>
 #include <mutex>
-#include <thread>
-#include <vector>
+
+namespace Misc
+{
+    class JobSystem;
+}
 
 namespace SceneUtil
 {
@@ -37,17 +40,17 @@ namespace SceneUtil
         std::condition_variable mCondition;
     };
 
-    class WorkThread;
-
     /// @brief A work queue that users can push work items onto, to be completed by one or more background threads.
-    /// @note Work items will be processed in the order that they were given in, however
-    /// if multiple work threads are involved then it is possible for a later item to complete before earlier items.
+    /// @note Work items are executed by a Misc::JobSystem. Items added to the front have higher priority than the
+    /// others. Items of the same priority are started in the order that they were given in, however if multiple work
+    /// threads are involved then it is possible for a later item to complete before earlier items.
     class WorkQueue : public osg::Referenced
     {
     public:
         WorkQueue(std::size_t workerThreads);
         ~WorkQueue();
 
+        /// Starts more worker threads if already started with fewer.
         void start(std::size_t workerThreads);
 
         void stop();
@@ -55,43 +58,18 @@ namespace SceneUtil
         /// Add a new work item to the back of the queue.
         /// @par The work item's waitTillDone() method may be used by the caller to wait until the work is complete.
         /// @param front If true, add item to the front of the queue. If false (default), add to the back.
+        /// @note After stop(), the item is aborted and marked as done without calling doWork().
         void addWorkItem(osg::ref_ptr<WorkItem> item, bool front = false);
 
-        /// Get the next work item from the front of the queue. If the queue is empty, waits until a new item is added.
-        /// If the workqueue is in the process of being destroyed, may return nullptr.
-        /// @par Used internally by the WorkThread.
-        osg::ref_ptr<WorkItem> removeWorkItem();
-
         size_t getNumItems() const;
 
         size_t getNumActiveThreads() const;
 
-    private:
-        bool mIsReleased;
-        std::deque<osg::ref_ptr<WorkItem>> mQueue;
-
-        mutable std::mutex mMutex;
-        std::condition_variable mCondition;
-
-        std::vector<std::unique_ptr<WorkThread>> mThreads;
-    };
-
-    /// Internally used by WorkQueue.
-    class WorkThread
-    {
-    public:
-        WorkThread(WorkQueue& workQueue);
-
-        ~WorkThread();
-
-        bool isActive() const;
+        /// The job system executing the work items, to schedule jobs on the same threads.
+        Misc::JobSystem* getJobSystem() const { return mJobSystem.get(); }
 
     private:
-        WorkQueue* mWorkQueue;
-        std::atomic<bool> mActive;
-        std::thread mThread;
-
-        void run();
+        std::unique_ptr<Misc::JobSystem> mJobSystem;
     };
 
 }
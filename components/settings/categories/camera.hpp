@@ -8,6 +8,7 @@
 #include <osg/Vec2f>
 #include <osg/Vec3f>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -22,11 +23,29 @@ namespace Settings
         SettingValue<bool> mSmallFeatureCulling{ mIndex, "Camera", "small feature culling" };
         SettingValue<float> mSmallFeatureCullingPixelSize{ mIndex, "Camera", "small feature culling pixel size",
             makeMaxStrictSanitizerFloat(0) };
+        SettingValue<bool> mSoftwareOcclusionCulling{ mIndex, "Camera", "software occlusion culling" };
         SettingValue<float> mViewingDistance{ mIndex, "Camera", "viewing distance", makeMaxStrictSanitizerFloat(0) };
         SettingValue<float> mFieldOfView{ mIndex, "Camera", "field of view", makeClampSanitizerFloat(1, 179) };
         SettingValue<float> mFirstPersonFieldOfView{ mIndex, "Camera", "first person field of view",
             makeClampSanitizerFloat(1, 179) };
         SettingValue<bool> mReverseZ{ mIndex, "Camera", "reverse z" };
+        SettingValue<bool> mAnimationLod{ mIndex, "Camera", "animation lod" };
+        SettingValue<float> mAnimationLodHalfRatePixelSize{ mIndex, "Camera", "animation lod half rate pixel size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mAnimationLodQuarterRatePixelSize{ mIndex, "Camera",
+            "animation lod quarter rate pixel size", makeMaxSanitizerFloat(0) };
+        SettingValue<float> mAnimationLodHalfRateDistance{ mIndex, "Camera", "animation lod half rate distance",
+            makeMaxStrictSanitizerFloat(0) };
+        SettingValue<float> mAnimationLodQuarterRateDistance{ mIndex, "Camera",
+            "animation lod quarter rate distance", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<bool> mParticleLod{ mIndex, "Camera", "particle lod" };
+        SettingValue<float> mParticleLodFullDetailPixelSize{ mIndex, "Camera", "particle lod full detail pixel size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mParticleLodFullDetailDistance{ mIndex, "Camera", "particle lod full detail distance",
+            makeMaxStrictSanitizerFloat(0) };
+        SettingValue<int> mParticleLodOffscreenInterval{ mIndex, "Camera", "particle lod offscreen interval",
+            makeClampSanitizerInt(1, 16) };
+        SettingValue<std::size_t> mParticleBudget{ mIndex, "Camera", "particle budget" };
     };
 }
 
@@ -32,6 +32,8 @@ namespace Settings
         SettingValue<float> mPredictionTime{ mIndex, "Cells", "prediction time", makeMaxSanitizerFloat(0) };
         SettingValue<float> mCacheExpiryDelay{ mIndex, "Cells", "cache expiry delay", makeMaxSanitizerFloat(0) };
         SettingValue<float> mTargetFramerate{ mIndex, "Cells", "target framerate", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<int> mUploadBytesPerFrame{ mIndex, "Cells", "upload bytes per frame", makeMaxSanitizerInt(0) };
+        SettingValue<float> mUploadTimePerFrame{ mIndex, "Cells", "upload time per frame", makeMaxSanitizerFloat(0) };
         SettingValue<int> mPointersCacheSize{ mIndex, "Cells", "pointers cache size", makeClampSanitizerInt(40, 1000) };
     };
 }
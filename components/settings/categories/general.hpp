@@ -32,6 +32,12 @@ namespace Settings
         SettingValue<bool> mGmstOverridesL10n{ mIndex, "General", "gmst overrides l10n" };
         SettingValue<std::size_t> mLogBufferSize{ mIndex, "General", "log buffer size" };
         SettingValue<std::size_t> mConsoleHistoryBufferSize{ mIndex, "General", "console history buffer size" };
+        SettingValue<int> mContentLoadingNumThreads{ mIndex, "General", "content loading num threads",
+            makeMaxSanitizerInt(0) };
+        SettingValue<bool> mContentSnapshot{ mIndex, "General", "content snapshot" };
+        SettingValue<bool> mTracing{ mIndex, "General", "tracing" };
+        SettingValue<std::size_t> mTracingBufferSize{ mIndex, "General", "tracing buffer size",
+            makeMaxSanitizerSize(1) };
     };
 }
 
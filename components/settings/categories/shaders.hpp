@@ -48,6 +48,7 @@ namespace Settings
         SettingValue<bool> mWeatherParticleOcclusion{ mIndex, "Shaders", "weather particle occlusion" };
         SettingValue<float> mWeatherParticleOcclusionSmallFeatureCullingPixelSize{ mIndex, "Shaders",
             "weather particle occlusion small feature culling pixel size" };
+        SettingValue<bool> mBatchedParticleAffectors{ mIndex, "Shaders", "batched particle affectors" };
     };
 }
 
@@ -38,6 +38,8 @@ namespace Settings
         SettingValue<float> mObjectPagingMinSizeCostMultiplier{ mIndex, "Terrain",
             "object paging min size cost multiplier", makeMaxStrictSanitizerFloat(0) };
         SettingValue<bool> mWaterCulling{ mIndex, "Terrain", "water culling" };
+        SettingValue<bool> mCompactVertices{ mIndex, "Terrain", "compact vertices" };
+        SettingValue<bool> mCompositeMapCache{ mIndex, "Terrain", "composite map cache" };
     };
 }
 
@@ -293,6 +293,32 @@ namespace Terrain
         mVec4ubPool[array->size()].push_back(array);
     }
 
+    osg::ref_ptr<osg::Vec2sArray> BufferCache::takeVec2sArray(size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mPoolMutex);
+        auto& pool = mVec2sPool[size];
+        if (!pool.empty())
+        {
+            osg::ref_ptr<osg::Vec2sArray> array = pool.back();
+            pool.pop_back();
+            return array;
+        }
+
+        // Packed values are decoded by the shader
+        osg::ref_ptr<osg::Vec2sArray> array = new osg::Vec2sArray;
+        array->setNormalize(false);
+        array->resize(size);
+        array->setVertexBufferObject(new osg::VertexBufferObject);
+        return array;
+    }
+
+    void BufferCache::returnVec2sArray(osg::ref_ptr<osg::Vec2sArray> array)
+    {
+        if (!array) return;
+        std::lock_guard<std::mutex> lock(mPoolMutex);
+        mVec2sPool[array->size()].push_back(array);
+    }
+
     void BufferCache::releaseGLObjects(osg::State* state)
     {
         {
@@ -301,6 +327,8 @@ namespace Terrain
                 for (auto& arr : pool) arr->releaseGLObjects(state);
             for (auto& [_, pool] : mVec4ubPool)
                 for (auto& arr : pool) arr->releaseGLObjects(state);
+            for (auto& [_, pool] : mVec2sPool)
+                for (auto& arr : pool) arr->releaseGLObjects(state);
         }
         {
             std::lock_guard<std::mutex> lock(mIndexBufferMutex);
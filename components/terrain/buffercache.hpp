@@ -30,6 +30,10 @@ namespace Terrain
         osg::ref_ptr<osg::Vec4ubArray> takeVec4ubArray(size_t size);
         void returnVec4ubArray(osg::ref_ptr<osg::Vec4ubArray> array);
 
+        /// Arrays for the packed heights and normals of the compact vertex format.
+        osg::ref_ptr<osg::Vec2sArray> takeVec2sArray(size_t size);
+        void returnVec2sArray(osg::ref_ptr<osg::Vec2sArray> array);
+
         void clearCache();
 
         void releaseGLObjects(osg::State* state);
@@ -46,6 +50,7 @@ namespace Terrain
         // Milestone 2 Pools
         std::map<size_t, std::vector<osg::ref_ptr<osg::Vec3Array>>> mVec3Pool;
         std::map<size_t, std::vector<osg::ref_ptr<osg::Vec4ubArray>>> mVec4ubPool;
+        std::map<size_t, std::vector<osg::ref_ptr<osg::Vec2sArray>>> mVec2sPool;
         std::mutex mPoolMutex;
     };
 
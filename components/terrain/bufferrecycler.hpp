@@ -12,6 +12,7 @@ namespace Terrain
         virtual ~BufferRecycler() = default;
         virtual void returnVec3Array(osg::ref_ptr<osg::Vec3Array> array) = 0;
         virtual void returnVec4ubArray(osg::ref_ptr<osg::Vec4ubArray> array) = 0;
+        virtual void returnVec2sArray(osg::ref_ptr<osg::Vec2sArray> array) = 0;
     };
 }
 
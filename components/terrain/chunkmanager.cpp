@@ -1,18 +1,24 @@
 #include "chunkmanager.hpp"
 
+#include <osg/Image>
 #include <osg/Material>
 #include <osg/Texture2D>
 
 #include <osgUtil/IncrementalCompileOperation>
 
+#include <cstdint>
+#include <string>
+
 #include <components/esm/util.hpp>
 #include <components/resource/objectcache.hpp>
 #include <components/resource/scenemanager.hpp>
 
 #include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/uploadscheduler.hpp>
 
 #include "../../performance_toolkit/toolkit.hpp"
 
+#include "compositemapcache.hpp"
 #include "compositemaprenderer.hpp"
 #include "material.hpp"
 #include "storage.hpp"
@@ -21,6 +27,17 @@
 
 namespace Terrain
 {
+    namespace
+    {
+        // Increment when the way composite maps are rendered changes
+        constexpr std::uint32_t compositeMapCacheVersion = 1;
+
+        template <class T>
+        void appendValue(std::string& data, const T& value)
+        {
+            data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
 
     struct UpdateTextureFilteringFunctor
     {
@@ -122,34 +139,48 @@ namespace Terrain
         return texture;
     }
 
-    void ChunkManager::createCompositeMapGeometry(
-        float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords, CompositeMap& compositeMap)
+    void ChunkManager::getCompositeMapParts(float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords,
+        std::vector<CompositeMapPart>& parts)
     {
         if (chunkSize > mMaxCompGeometrySize)
         {
-            createCompositeMapGeometry(chunkSize / 2.f, chunkCenter + osg::Vec2f(chunkSize / 4.f, chunkSize / 4.f),
+            getCompositeMapParts(chunkSize / 2.f, chunkCenter + osg::Vec2f(chunkSize / 4.f, chunkSize / 4.f),
                 osg::Vec4f(
                     texCoords.x() + texCoords.z() / 2.f, texCoords.y(), texCoords.z() / 2.f, texCoords.w() / 2.f),
-                compositeMap);
-            createCompositeMapGeometry(chunkSize / 2.f, chunkCenter + osg::Vec2f(-chunkSize / 4.f, chunkSize / 4.f),
-                osg::Vec4f(texCoords.x(), texCoords.y(), texCoords.z() / 2.f, texCoords.w() / 2.f), compositeMap);
-            createCompositeMapGeometry(chunkSize / 2.f, chunkCenter + osg::Vec2f(chunkSize / 4.f, -chunkSize / 4.f),
+                parts);
+            getCompositeMapParts(chunkSize / 2.f, chunkCenter + osg::Vec2f(-chunkSize / 4.f, chunkSize / 4.f),
+                osg::Vec4f(texCoords.x(), texCoords.y(), texCoords.z() / 2.f, texCoords.w() / 2.f), parts);
+            getCompositeMapParts(chunkSize / 2.f, chunkCenter + osg::Vec2f(chunkSize / 4.f, -chunkSize / 4.f),
                 osg::Vec4f(texCoords.x() + texCoords.z() / 2.f, texCoords.y() + texCoords.w() / 2.f,
                     texCoords.z() / 2.f, texCoords.w() / 2.f),
-                compositeMap);
-            createCompositeMapGeometry(chunkSize / 2.f, chunkCenter + osg::Vec2f(-chunkSize / 4.f, -chunkSize / 4.f),
+                parts);
+            getCompositeMapParts(chunkSize / 2.f, chunkCenter + osg::Vec2f(-chunkSize / 4.f, -chunkSize / 4.f),
                 osg::Vec4f(
                     texCoords.x(), texCoords.y() + texCoords.w() / 2.f, texCoords.z() / 2.f, texCoords.w() / 2.f),
-                compositeMap);
+                parts);
         }
         else
         {
-            float left = texCoords.x() * 2.f - 1;
-            float top = texCoords.y() * 2.f - 1;
-            float width = texCoords.z() * 2.f;
-            float height = texCoords.w() * 2.f;
+            CompositeMapPart& part = parts.emplace_back();
+            part.mChunkSize = chunkSize;
+            part.mChunkCenter = chunkCenter;
+            part.mTexCoords = texCoords;
+            mStorage->getBlendmaps(chunkSize, chunkCenter, part.mBlendmaps, part.mLayers, mWorldspace);
+        }
+    }
+
+    void ChunkManager::createCompositeMapGeometry(
+        const std::vector<CompositeMapPart>& parts, CompositeMap& compositeMap)
+    {
+        for (const CompositeMapPart& part : parts)
+        {
+            float left = part.mTexCoords.x() * 2.f - 1;
+            float top = part.mTexCoords.y() * 2.f - 1;
+            float width = part.mTexCoords.z() * 2.f;
+            float height = part.mTexCoords.w() * 2.f;
 
-            std::vector<osg::ref_ptr<osg::StateSet>> passes = createPasses(chunkSize, chunkCenter, true);
+            std::vector<osg::ref_ptr<osg::StateSet>> passes
+                = createPasses(part.mChunkSize, part.mLayers, part.mBlendmaps, true);
             for (std::vector<osg::ref_ptr<osg::StateSet>>::iterator it = passes.begin(); it != passes.end(); ++it)
             {
                 osg::ref_ptr<osg::Geometry> geom = osg::createTexturedQuadGeometry(
@@ -173,6 +204,13 @@ namespace Terrain
         std::vector<osg::ref_ptr<osg::Image>> blendmaps;
         mStorage->getBlendmaps(chunkSize, chunkCenter, blendmaps, layerList, mWorldspace);
 
+        return createPasses(chunkSize, layerList, blendmaps, forCompositeMap);
+    }
+
+    std::vector<osg::ref_ptr<osg::StateSet>> ChunkManager::createPasses(float chunkSize,
+        const std::vector<LayerInfo>& layerList, const std::vector<osg::ref_ptr<osg::Image>>& blendmaps,
+        bool forCompositeMap)
+    {
         bool useShaders = mSceneManager->getForceShaders();
         if (!mSceneManager->getClampLighting())
             useShaders = true; // always use shaders when lighting is unclamped, this is to avoid lighting seams between
@@ -198,6 +236,10 @@ namespace Terrain
             }
         }
 
+        // The compact vertex format is decoded by the terrain shader
+        if (mCompactVertices)
+            useShaders = true;
+
         if (forCompositeMap)
             useShaders = false;
 
@@ -215,7 +257,31 @@ namespace Terrain
         int tileCount = mStorage->getTextureTileCount(chunkSize, mWorldspace);
 
         return ::Terrain::createPasses(useShaders, mSceneManager, layers, blendmapTextures, tileCount,
-            static_cast<float>(tileCount), ESM::isEsm4Ext(mWorldspace));
+            static_cast<float>(tileCount), ESM::isEsm4Ext(mWorldspace), mCompactVertices && !forCompositeMap);
+    }
+
+    void ChunkManager::writeCompositeMapKeyData(const std::vector<CompositeMapPart>& parts, std::string& data)
+    {
+        // The rendered map depends only on the blendmaps and the layer textures, not on the chunk position, so
+        // chunks with the same content share an entry.
+        for (const CompositeMapPart& part : parts)
+        {
+            appendValue(data, mStorage->getTextureTileCount(part.mChunkSize, mWorldspace));
+            appendValue(data, part.mLayers.size());
+            for (const LayerInfo& layer : part.mLayers)
+            {
+                data += layer.mDiffuseMap.value();
+                data += '\0';
+            }
+            appendValue(data, part.mBlendmaps.size());
+            for (const osg::ref_ptr<osg::Image>& blendmap : part.mBlendmaps)
+            {
+                appendValue(data, blendmap->s());
+                appendValue(data, blendmap->t());
+                appendValue(data, blendmap->getPixelFormat());
+                data.append(reinterpret_cast<const char*>(blendmap->data()), blendmap->getTotalSizeInBytes());
+            }
+        }
     }
 
     osg::ref_ptr<osg::Node> ChunkManager::createChunk(float chunkSize, const osg::Vec2f& chunkCenter, unsigned char lod,
@@ -229,16 +295,47 @@ namespace Terrain
                 = static_cast<unsigned>((mStorage->getCellVertices(mWorldspace) - 1) * chunkSize / (1 << lod) + 1);
             size_t totalVerts = numVerts * numVerts;
 
-            osg::ref_ptr<osg::Vec3Array> positions = mBufferCache.takeVec3Array(totalVerts);
-            osg::ref_ptr<osg::Vec3Array> normals = mBufferCache.takeVec3Array(totalVerts);
             osg::ref_ptr<osg::Vec4ubArray> colors = mBufferCache.takeVec4ubArray(totalVerts);
 
-            mStorage->fillVertexBuffers(lod, chunkSize, chunkCenter, mWorldspace, *positions, *normals, *colors);
+            if (mCompactVertices)
+            {
+                osg::ref_ptr<osg::Vec2sArray> packed = mBufferCache.takeVec2sArray(totalVerts);
+
+                const CompactVertexDecode decode = mStorage->fillCompactVertexBuffers(
+                    lod, chunkSize, chunkCenter, mWorldspace, *packed, *colors);
+
+                geometry->setTexCoordArray(compactVertexUnit, packed, osg::Array::BIND_PER_VERTEX);
+                geometry->setCompactVertexDecode(decode);
+            }
+            else
+            {
+                osg::ref_ptr<osg::Vec3Array> positions = mBufferCache.takeVec3Array(totalVerts);
+                osg::ref_ptr<osg::Vec3Array> normals = mBufferCache.takeVec3Array(totalVerts);
+
+                mStorage->fillVertexBuffers(lod, chunkSize, chunkCenter, mWorldspace, *positions, *normals, *colors);
+
+                geometry->setVertexArray(positions);
+                geometry->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
+            }
 
-            geometry->setVertexArray(positions);
-            geometry->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
             geometry->setColorArray(colors, osg::Array::BIND_PER_VERTEX);
         }
+        else if (const std::optional<CompactVertexDecode>& decode = templateGeometry->getCompactVertexDecode())
+        {
+            const osg::Vec2sArray* srcPacked
+                = static_cast<const osg::Vec2sArray*>(templateGeometry->getTexCoordArray(compactVertexUnit));
+            const osg::Vec4ubArray* srcColor = static_cast<const osg::Vec4ubArray*>(templateGeometry->getColorArray());
+
+            osg::ref_ptr<osg::Vec2sArray> packed = mBufferCache.takeVec2sArray(srcPacked->size());
+            osg::ref_ptr<osg::Vec4ubArray> colors = mBufferCache.takeVec4ubArray(srcColor->size());
+
+            std::copy(srcPacked->begin(), srcPacked->end(), packed->begin());
+            std::copy(srcColor->begin(), srcColor->end(), colors->begin());
+
+            geometry->setTexCoordArray(compactVertexUnit, packed, osg::Array::BIND_PER_VERTEX);
+            geometry->setColorArray(colors, osg::Array::BIND_PER_VERTEX);
+            geometry->setCompactVertexDecode(*decode);
+        }
         else
         {
             // Milestone 2 Polish: Use recycled arrays for template clones
@@ -276,7 +373,8 @@ namespace Terrain
         bool useCompositeMap = chunkSize >= mCompositeMapLevel;
         unsigned int numUvSets = useCompositeMap ? 1 : 2;
 
-        geometry->setTexCoordArrayList(osg::Geometry::ArrayList(numUvSets, mBufferCache.getUVBuffer(numVerts)));
+        for (unsigned int i = 0; i < numUvSets; ++i)
+            geometry->setTexCoordArray(i, mBufferCache.getUVBuffer(numVerts));
 
         geometry->createClusterCullingCallback();
 
@@ -298,20 +396,50 @@ namespace Terrain
                 osg::ref_ptr<CompositeMap> compositeMap = new CompositeMap;
                 compositeMap->mTexture = createCompositeMapRTT();
 
-                createCompositeMapGeometry(chunkSize, chunkCenter, osg::Vec4f(0, 0, 1, 1), *compositeMap);
-
-                mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
+                std::vector<CompositeMapPart> parts;
+                getCompositeMapParts(chunkSize, chunkCenter, osg::Vec4f(0, 0, 1, 1), parts);
+
+                osg::ref_ptr<osg::Image> cachedImage;
+                CompositeMapKey cacheKey{};
+                if (mCompositeMapCache != nullptr)
+                {
+                    std::string keyData;
+                    appendValue(keyData, compositeMapCacheVersion);
+                    appendValue(keyData, mCompositeMapSize);
+                    appendValue(keyData, mMaxCompGeometrySize);
+                    appendValue(keyData, ESM::isEsm4Ext(mWorldspace));
+                    writeCompositeMapKeyData(parts, keyData);
+                    cacheKey = makeCompositeMapKey(keyData);
+                    cachedImage = mCompositeMapCache->read(cacheKey);
+                }
 
                 geometry->setCompositeMap(compositeMap);
-                geometry->setCompositeMapRenderer(mCompositeMapRenderer);
+
+                if (cachedImage != nullptr && cachedImage->s() == static_cast<int>(mCompositeMapSize)
+                    && cachedImage->t() == static_cast<int>(mCompositeMapSize))
+                {
+                    compositeMap->mTexture->setImage(cachedImage);
+                    compositeMap->mTexture->setUnRefImageDataAfterApply(true);
+                }
+                else
+                {
+                    createCompositeMapGeometry(parts, *compositeMap);
+
+                    compositeMap->mCache = mCompositeMapCache;
+                    compositeMap->mCacheKey = cacheKey;
+                    mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
+
+                    geometry->setCompositeMapRenderer(mCompositeMapRenderer);
+                }
 
                 TextureLayer layer;
                 layer.mDiffuseMap = compositeMap->mTexture;
                 layer.mParallax = false;
                 layer.mSpecular = false;
                 geometry->setPasses(::Terrain::createPasses(
-                    mSceneManager->getForceShaders() || !mSceneManager->getClampLighting(), mSceneManager,
-                    std::vector<TextureLayer>(1, layer), std::vector<osg::ref_ptr<osg::Texture2D>>(), 1, 1.f));
+                    mSceneManager->getForceShaders() || !mSceneManager->getClampLighting() || mCompactVertices,
+                    mSceneManager, std::vector<TextureLayer>(1, layer), std::vector<osg::ref_ptr<osg::Texture2D>>(), 1,
+                    1.f, false, mCompactVertices));
             }
             else
             {
@@ -323,7 +451,9 @@ namespace Terrain
 
         if (!templateGeometry && compile && mSceneManager->getIncrementalCompileOperation())
         {
-            mSceneManager->getIncrementalCompileOperation()->add(geometry);
+            const float cellWorldSize = static_cast<float>(mStorage->getCellWorldSize(mWorldspace));
+            SceneUtil::addToCompile(*mSceneManager->getIncrementalCompileOperation(), geometry,
+                osg::Vec3f(chunkCenter.x() * cellWorldSize, chunkCenter.y() * cellWorldSize, 0));
         }
         geometry->setNodeMask(mNodeMask);
 
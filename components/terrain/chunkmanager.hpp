@@ -1,17 +1,21 @@
 #ifndef OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 #define OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 
+#include <string>
 #include <tuple>
+#include <vector>
 
 #include <components/resource/resourcemanager.hpp>
 
 #include "bufferrecycler.hpp"
 #include "buffercache.hpp"
+#include "defs.hpp"
 #include "quadtreeworld.hpp"
 
 namespace osg
 {
     class Group;
+    class Image;
     class Texture2D;
 }
 
@@ -25,6 +29,7 @@ namespace Terrain
 
     class TextureManager;
     class CompositeMapRenderer;
+    class CompositeMapCache;
     class Storage;
     class CompositeMap;
     class TerrainDrawable;
@@ -86,6 +91,12 @@ namespace Terrain
         void setCompositeMapLevel(float level) { mCompositeMapLevel = level; }
         void setMaxCompositeGeometrySize(float maxCompGeometrySize) { mMaxCompGeometrySize = maxCompGeometrySize; }
 
+        /// Create new chunks with the compact vertex format, requires shaders.
+        void setCompactVertices(bool value) { mCompactVertices = value; }
+
+        /// Load composite maps of new chunks from the cache if possible and store the rendered ones.
+        void setCompositeMapCache(const CompositeMapCache* cache) { mCompositeMapCache = cache; }
+
         void updateTextureFiltering();
 
         void setNodeMask(unsigned int mask) { mNodeMask = mask; }
@@ -106,6 +117,10 @@ namespace Terrain
         {
             mBufferCache.returnVec4ubArray(array);
         }
+        void returnVec2sArray(osg::ref_ptr<osg::Vec2sArray> array) override
+        {
+            mBufferCache.returnVec2sArray(array);
+        }
 
     private:
         osg::ref_ptr<osg::Node> createChunk(float size, const osg::Vec2f& center, unsigned char lod,
@@ -113,12 +128,29 @@ namespace Terrain
 
         osg::ref_ptr<osg::Texture2D> createCompositeMapRTT();
 
-        void createCompositeMapGeometry(
-            float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords, CompositeMap& map);
+        // Area of a composite map rendered by one geometry, with the inputs of its passes
+        struct CompositeMapPart
+        {
+            float mChunkSize;
+            osg::Vec2f mChunkCenter;
+            osg::Vec4f mTexCoords;
+            std::vector<LayerInfo> mLayers;
+            std::vector<osg::ref_ptr<osg::Image>> mBlendmaps;
+        };
+
+        void getCompositeMapParts(float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords,
+            std::vector<CompositeMapPart>& parts);
+
+        void createCompositeMapGeometry(const std::vector<CompositeMapPart>& parts, CompositeMap& map);
 
         std::vector<osg::ref_ptr<osg::StateSet>> createPasses(
             float chunkSize, const osg::Vec2f& chunkCenter, bool forCompositeMap);
 
+        std::vector<osg::ref_ptr<osg::StateSet>> createPasses(float chunkSize, const std::vector<LayerInfo>& layerList,
+            const std::vector<osg::ref_ptr<osg::Image>>& blendmaps, bool forCompositeMap);
+
+        void writeCompositeMapKeyData(const std::vector<CompositeMapPart>& parts, std::string& data);
+
         Terrain::Storage* mStorage;
         Resource::SceneManager* mSceneManager;
         TextureManager* mTextureManager;
@@ -132,6 +164,8 @@ namespace Terrain
         unsigned int mCompositeMapSize;
         float mCompositeMapLevel;
         float mMaxCompGeometrySize;
+        bool mCompactVertices = false;
+        const CompositeMapCache* mCompositeMapCache = nullptr;
     };
 
 }
@@ -0,0 +1,80 @@
+#ifndef OPENMW_COMPONENTS_TERRAIN_COMPACTVERTEX_H
+#define OPENMW_COMPONENTS_TERRAIN_COMPACTVERTEX_H
+
+#include <osg/Vec2f>
+#include <osg/Vec2s>
+#include <osg/Vec3f>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace Terrain
+{
+    /// Texture unit holding the packed height and normal of the compact terrain vertices. Positions in the XY plane
+    /// are implied by the grid coordinates stored in the texture unit 0.
+    constexpr unsigned compactVertexUnit = 2;
+
+    /// Parameters to restore the positions of compact vertices of a terrain chunk:
+    /// x = (u - 0.5) * mExtent, y = (v - 0.5) * mExtent, z = mHeightOffset + height * mHeightScale
+    struct CompactVertexDecode
+    {
+        float mExtent = 0;
+        float mHeightOffset = 0;
+        float mHeightScale = 0;
+
+        static CompactVertexDecode fromRange(float extent, float minHeight, float maxHeight)
+        {
+            constexpr float maxQuantized = 32767;
+            return CompactVertexDecode{
+                .mExtent = extent,
+                .mHeightOffset = (minHeight + maxHeight) / 2,
+                .mHeightScale = std::max((maxHeight - minHeight) / 2, 1.0f) / maxQuantized,
+            };
+        }
+
+        osg::Vec3f decode(const osg::Vec2f& gridPosition, std::int16_t height) const
+        {
+            return osg::Vec3f((gridPosition.x() - 0.5f) * mExtent, (gridPosition.y() - 0.5f) * mExtent,
+                mHeightOffset + height * mHeightScale);
+        }
+
+        std::int16_t encodeHeight(float height) const
+        {
+            const float value = std::round((height - mHeightOffset) / mHeightScale);
+            return static_cast<std::int16_t>(std::clamp(value, -32767.0f, 32767.0f));
+        }
+    };
+
+    /// Encodes a normal pointing upwards with the hemispherical octahedral mapping into two bytes.
+    /// Values are combined into a signed short to be passed as a vertex attribute without normalization and unpacked
+    /// by the shader.
+    inline std::int16_t encodeCompactNormal(const osg::Vec3f& normal)
+    {
+        const float z = std::max(normal.z(), 0.0f);
+        const float sum = std::abs(normal.x()) + std::abs(normal.y()) + z;
+        const osg::Vec2f octahedral = sum > 0 ? osg::Vec2f(normal.x(), normal.y()) / sum : osg::Vec2f();
+        const auto toByte
+            = [](float v) { return static_cast<int>(std::round((std::clamp(v, -1.0f, 1.0f) + 1) * 127.5f)); };
+        return static_cast<std::int16_t>((toByte(octahedral.x()) - 128) * 256 + toByte(octahedral.y()));
+    }
+
+    inline osg::Vec3f decodeCompactNormal(std::int16_t value)
+    {
+        const int high = static_cast<int>(std::floor(value / 256.0f));
+        const int low = value - high * 256;
+        const osg::Vec2f octahedral(
+            static_cast<float>(high + 128) / 127.5f - 1, static_cast<float>(low) / 127.5f - 1);
+        osg::Vec3f result(
+            octahedral.x(), octahedral.y(), 1 - std::abs(octahedral.x()) - std::abs(octahedral.y()));
+        result.normalize();
+        return result;
+    }
+
+    inline osg::Vec2s encodeCompactVertex(const CompactVertexDecode& decode, float height, const osg::Vec3f& normal)
+    {
+        return osg::Vec2s(decode.encodeHeight(height), encodeCompactNormal(normal));
+    }
+}
+
+#endif
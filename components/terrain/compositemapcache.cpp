@@ -0,0 +1,146 @@
+#include "compositemapcache.hpp"
+
+#include <osg/Image>
+
+#include <osgDB/ReaderWriter>
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+namespace Terrain
+{
+    namespace
+    {
+        // Composite maps are opaque, so they are stored without the alpha channel of the read back image
+        osg::ref_ptr<osg::Image> dropAlpha(osg::ref_ptr<osg::Image> image)
+        {
+            if (image->getPixelFormat() != GL_RGBA || image->getDataType() != GL_UNSIGNED_BYTE)
+                return image;
+
+            osg::ref_ptr<osg::Image> result = new osg::Image;
+            result->allocateImage(image->s(), image->t(), 1, GL_RGB, GL_UNSIGNED_BYTE);
+            for (int row = 0; row < image->t(); ++row)
+            {
+                const unsigned char* source = image->data(0, row);
+                unsigned char* destination = result->data(0, row);
+                for (int column = 0; column < image->s(); ++column)
+                {
+                    destination[column * 3] = source[column * 4];
+                    destination[column * 3 + 1] = source[column * 4 + 1];
+                    destination[column * 3 + 2] = source[column * 4 + 2];
+                }
+            }
+            return result;
+        }
+
+        class WriteCompositeMapWorkItem : public SceneUtil::WorkItem
+        {
+        public:
+            WriteCompositeMapWorkItem(std::filesystem::path path, osg::ref_ptr<osg::Image> image)
+                : mPath(std::move(path))
+                , mImage(std::move(image))
+            {
+            }
+
+            void doWork() override
+            {
+                osgDB::ReaderWriter* readerwriter = osgDB::Registry::instance()->getReaderWriterForExtension("png");
+                if (!readerwriter)
+                {
+                    Log(Debug::Error) << "Error: Unable to write composite map, can't find a png ReaderWriter";
+                    return;
+                }
+
+                std::filesystem::path tmpPath = mPath;
+                tmpPath += ".tmp";
+
+                try
+                {
+                    {
+                        std::ofstream stream(tmpPath, std::ios::binary);
+                        stream.exceptions(std::ios::failbit | std::ios::badbit);
+
+                        osgDB::ReaderWriter::WriteResult result
+                            = readerwriter->writeImage(*dropAlpha(mImage), stream);
+                        if (!result.success())
+                        {
+                            Log(Debug::Warning) << "Failed to write composite map " << mPath << ": "
+                                                << result.message() << " code " << result.status();
+                            return;
+                        }
+                    }
+
+                    // Readers never see a partially written file
+                    std::filesystem::rename(tmpPath, mPath);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to write composite map " << mPath << ": " << e.what();
+                }
+            }
+
+        private:
+            std::filesystem::path mPath;
+            osg::ref_ptr<osg::Image> mImage;
+        };
+    }
+
+    CompositeMapKey makeCompositeMapKey(std::span<const char> data)
+    {
+        return Files::getHash(data);
+    }
+
+    CompositeMapCache::CompositeMapCache(std::filesystem::path path, SceneUtil::WorkQueue* workQueue)
+        : mPath(std::move(path))
+        , mWorkQueue(workQueue)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(mPath, ec);
+        if (ec)
+            Log(Debug::Warning) << "Failed to create composite map cache directory " << mPath << ": " << ec.message();
+    }
+
+    osg::ref_ptr<osg::Image> CompositeMapCache::read(const CompositeMapKey& key) const
+    {
+        const std::filesystem::path path = getFilePath(key);
+
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+
+        osgDB::ReaderWriter* readerwriter = osgDB::Registry::instance()->getReaderWriterForExtension("png");
+        if (!readerwriter)
+            return nullptr;
+
+        osgDB::ReaderWriter::ReadResult result = readerwriter->readImage(stream);
+        if (!result.success())
+        {
+            Log(Debug::Warning) << "Failed to read composite map " << path << ": " << result.message() << " code "
+                                << result.status();
+            return nullptr;
+        }
+
+        return result.getImage();
+    }
+
+    void CompositeMapCache::write(const CompositeMapKey& key, osg::ref_ptr<osg::Image> image) const
+    {
+        mWorkQueue->addWorkItem(new WriteCompositeMapWorkItem(getFilePath(key), std::move(image)));
+    }
+
+    std::filesystem::path CompositeMapCache::getFilePath(const CompositeMapKey& key) const
+    {
+        std::ostringstream name;
+        name << std::hex << std::setfill('0') << std::setw(16) << key[0] << std::setw(16) << key[1] << ".png";
+        return mPath / name.str();
+    }
+
+}
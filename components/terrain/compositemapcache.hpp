@@ -0,0 +1,54 @@
+#ifndef OPENMW_COMPONENTS_TERRAIN_COMPOSITEMAPCACHE_H
+#define OPENMW_COMPONENTS_TERRAIN_COMPOSITEMAPCACHE_H
+
+#include <osg/ref_ptr>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace osg
+{
+    class Image;
+}
+
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
+namespace Terrain
+{
+
+    /// Hash of everything a composite map is rendered from
+    using CompositeMapKey = std::array<std::uint64_t, 2>;
+
+    CompositeMapKey makeCompositeMapKey(std::span<const char> data);
+
+    /// @brief Stores rendered composite maps on disk, so they don't have to be rendered again by later sessions.
+    /// @note Entries are never invalidated in place, a change of the terrain data or layer textures results in a
+    /// different key.
+    class CompositeMapCache
+    {
+    public:
+        explicit CompositeMapCache(std::filesystem::path path, SceneUtil::WorkQueue* workQueue);
+
+        /// Returns the stored image for the key or nullptr.
+        /// @note Thread safe.
+        osg::ref_ptr<osg::Image> read(const CompositeMapKey& key) const;
+
+        /// Store the image in a background thread.
+        /// @note Thread safe.
+        void write(const CompositeMapKey& key, osg::ref_ptr<osg::Image> image) const;
+
+    private:
+        std::filesystem::path mPath;
+        SceneUtil::WorkQueue* mWorkQueue;
+
+        std::filesystem::path getFilePath(const CompositeMapKey& key) const;
+    };
+
+}
+
+#endif
@@ -1,10 +1,12 @@
 #include "compositemaprenderer.hpp"
 
 #include <osg/FrameBufferObject>
+#include <osg/Image>
 #include <osg/RenderInfo>
 #include <osg/Texture2D>
 
 #include <algorithm>
+#include <utility>
 
 namespace Terrain
 {
@@ -127,8 +129,22 @@ namespace Terrain
             compositeMap.mDrawables[i] = nullptr;
         }
         if (compositeMap.mCompiled == compositeMap.mDrawables.size())
+        {
             compositeMap.mDrawables = std::vector<osg::ref_ptr<osg::Drawable>>();
 
+            if (compositeMap.mCache != nullptr)
+            {
+                // Stalls until the map is rendered, only done once per map and content version. GL_RGBA is the only
+                // format glReadPixels always supports on GLES, the alpha channel is dropped by the cache.
+                mFBO->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+                osg::ref_ptr<osg::Image> image = new osg::Image;
+                image->readPixels(0, 0, compositeMap.mTexture->getTextureWidth(),
+                    compositeMap.mTexture->getTextureHeight(), GL_RGBA, GL_UNSIGNED_BYTE);
+                compositeMap.mCache->write(compositeMap.mCacheKey, std::move(image));
+                compositeMap.mCache = nullptr;
+            }
+        }
+
         state.haveAppliedAttribute(osg::StateAttribute::VIEWPORT);
 
         GLuint fboId = state.getGraphicsContext() ? state.getGraphicsContext()->getDefaultFboId() : 0;
@@ -3,6 +3,8 @@
 
 #include <osg/Drawable>
 
+#include "compositemapcache.hpp"
+
 #include <mutex>
 #include <set>
 
@@ -24,6 +26,10 @@ namespace Terrain
         std::vector<osg::ref_ptr<osg::Drawable>> mDrawables;
         osg::ref_ptr<osg::Texture2D> mTexture;
         size_t mCompiled;
+
+        /// Once fully rendered, the texture is read back and stored in this cache
+        const CompositeMapCache* mCache = nullptr;
+        CompositeMapKey mCacheKey{};
     };
 
     /**
@@ -26,7 +26,7 @@ namespace Terrain
 
     std::vector<osg::ref_ptr<osg::StateSet>> createPasses(bool useShaders, Resource::SceneManager* sceneManager,
         const std::vector<TextureLayer>& layers, const std::vector<osg::ref_ptr<osg::Texture2D>>& blendmaps,
-        int blendmapScale, float layerTileSize, bool esm4terrain = false);
+        int blendmapScale, float layerTileSize, bool esm4terrain = false, bool compactVertices = false);
 }
 
 #endif
@@ -11,6 +11,7 @@
 #include <components/esm/exteriorcelllocation.hpp>
 #include <components/esm/refid.hpp>
 
+#include "compactvertex.hpp"
 #include "defs.hpp"
 
 namespace osg
@@ -67,6 +68,21 @@ namespace Terrain
             osg::Vec3Array& positions, osg::Vec3Array& normals, osg::Vec4ubArray& colours)
             = 0;
 
+        /// Fill vertex buffers for a terrain chunk in the compact format. Heights are quantized to 16 bits relative to
+        /// the chunk and normals are octahedral encoded into 16 bits, positions in the XY plane are implied by the
+        /// grid.
+        /// @note May be called from background threads. Make sure to only call thread-safe functions from here!
+        /// @note Vertices are written in the same order as by fillVertexBuffers.
+        /// @param lodLevel LOD level, 0 = most detailed
+        /// @param size size of the terrain chunk in cell units
+        /// @param center center of the chunk in cell units
+        /// @param vertices buffer to write packed heights and normals
+        /// @param colours buffer to write vertex colours
+        /// @return parameters to restore the vertex positions
+        virtual CompactVertexDecode fillCompactVertexBuffers(int lodLevel, float size, const osg::Vec2f& center,
+            ESM::RefId worldspace, osg::Vec2sArray& vertices, osg::Vec4ubArray& colours)
+            = 0;
+
         typedef std::vector<osg::ref_ptr<osg::Image>> ImageVector;
         /// Create textures holding layer blend values for a terrain chunk.
         /// @note The terrain chunk shouldn't be larger than one cell since otherwise we might
@@ -1,8 +1,11 @@
 #include "terraindrawable.hpp"
 
 #include <osg/ClusterCullingCallback>
+#include <osg/Uniform>
 #include <osgUtil/CullVisitor>
 
+#include <algorithm>
+
 #include <components/sceneutil/lightmanager.hpp>
 
 #include "compositemaprenderer.hpp"
@@ -22,6 +25,9 @@ namespace Terrain
                 mBufferRecycler->returnVec3Array(norm);
             if (osg::Vec4ubArray* color = static_cast<osg::Vec4ubArray*>(getColorArray()))
                 mBufferRecycler->returnVec4ubArray(color);
+            if (mCompactVertexDecode.has_value())
+                if (osg::Vec2sArray* packed = static_cast<osg::Vec2sArray*>(getTexCoordArray(compactVertexUnit)))
+                    mBufferRecycler->returnVec2sArray(packed);
         }
     }
 
@@ -29,6 +35,8 @@ namespace Terrain
         : osg::Geometry(copy, copyop)
         , mPasses(copy.mPasses)
         , mLightListCallback(copy.mLightListCallback)
+        , mCompactVertexDecode(copy.mCompactVertexDecode)
+        , mCompactVertexStateSet(copy.mCompactVertexStateSet)
     {
     }
 
@@ -118,6 +126,9 @@ namespace Terrain
         if (stateset)
             cv->pushStateSet(stateset);
 
+        if (mCompactVertexStateSet)
+            cv->pushStateSet(mCompactVertexStateSet);
+
         for (PassVector::const_iterator it = mPasses.begin(); it != mPasses.end(); ++it)
         {
             cv->pushStateSet(*it);
@@ -125,6 +136,8 @@ namespace Terrain
             cv->popStateSet();
         }
 
+        if (mCompactVertexStateSet)
+            cv->popStateSet();
         if (stateset)
             cv->popStateSet();
         if (pushedLight)
@@ -148,12 +161,20 @@ namespace Terrain
 
     void TerrainDrawable::setupWaterBoundingBox(float waterheight, float margin)
     {
-        osg::Vec3Array* vertices = static_cast<osg::Vec3Array*>(getVertexArray());
-        for (unsigned int i = 0; i < vertices->size(); ++i)
-        {
-            const osg::Vec3f& vertex = (*vertices)[i];
+        const auto expandBy = [&](const osg::Vec3f& vertex) {
             if (vertex.z() <= waterheight)
                 mWaterBoundingBox.expandBy(vertex);
+        };
+        if (mCompactVertexDecode.has_value())
+        {
+            for (const osg::Vec3f& vertex : getCompactVertices())
+                expandBy(vertex);
+        }
+        else
+        {
+            osg::Vec3Array* vertices = static_cast<osg::Vec3Array*>(getVertexArray());
+            for (unsigned int i = 0; i < vertices->size(); ++i)
+                expandBy((*vertices)[i]);
         }
         if (mWaterBoundingBox.valid())
         {
@@ -165,6 +186,59 @@ namespace Terrain
         }
     }
 
+    void TerrainDrawable::setCompactVertexDecode(const CompactVertexDecode& value)
+    {
+        mCompactVertexDecode = value;
+        mCompactVertexStateSet = new osg::StateSet;
+        mCompactVertexStateSet->addUniform(new osg::Uniform("terrainVertexDecode",
+            osg::Vec4f(value.mExtent, value.mHeightOffset, value.mHeightScale, 0)));
+        dirtyBound();
+    }
+
+    std::vector<osg::Vec3f> TerrainDrawable::getCompactVertices() const
+    {
+        std::vector<osg::Vec3f> result;
+        const osg::Vec2Array* gridPositions = static_cast<const osg::Vec2Array*>(getTexCoordArray(0));
+        const osg::Vec2sArray* packed = static_cast<const osg::Vec2sArray*>(getTexCoordArray(compactVertexUnit));
+        if (gridPositions == nullptr || packed == nullptr)
+            return result;
+        const std::size_t size = std::min(gridPositions->size(), packed->size());
+        result.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+            result.push_back(mCompactVertexDecode->decode((*gridPositions)[i], (*packed)[i].x()));
+        return result;
+    }
+
+    void TerrainDrawable::accept(osg::PrimitiveFunctor& functor) const
+    {
+        if (!mCompactVertexDecode.has_value())
+            return osg::Geometry::accept(functor);
+
+        const std::vector<osg::Vec3f> vertices = getCompactVertices();
+        if (vertices.empty())
+            return;
+
+        functor.setVertexArray(static_cast<unsigned>(vertices.size()), vertices.data());
+
+        for (const osg::ref_ptr<osg::PrimitiveSet>& primitiveSet : getPrimitiveSetList())
+            primitiveSet->accept(functor);
+    }
+
+    void TerrainDrawable::accept(osg::PrimitiveIndexFunctor& functor) const
+    {
+        if (!mCompactVertexDecode.has_value())
+            return osg::Geometry::accept(functor);
+
+        const std::vector<osg::Vec3f> vertices = getCompactVertices();
+        if (vertices.empty())
+            return;
+
+        functor.setVertexArray(static_cast<unsigned>(vertices.size()), vertices.data());
+
+        for (const osg::ref_ptr<osg::PrimitiveSet>& primitiveSet : getPrimitiveSetList())
+            primitiveSet->accept(functor);
+    }
+
     void TerrainDrawable::compileGLObjects(osg::RenderInfo& renderInfo) const
     {
         for (PassVector::const_iterator it = mPasses.begin(); it != mPasses.end(); ++it)
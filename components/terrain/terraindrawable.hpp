@@ -3,7 +3,11 @@
 
 #include <osg/Geometry>
 
+#include <optional>
+#include <vector>
+
 #include "bufferrecycler.hpp"
+#include "compactvertex.hpp"
 
 namespace osg
 {
@@ -48,6 +52,10 @@ namespace Terrain
         void accept(osg::NodeVisitor& nv) override;
         void cull(osgUtil::CullVisitor* cv);
 
+        /// Compact vertices are restored to provide the positions for bounds and intersections.
+        void accept(osg::PrimitiveFunctor& functor) const override;
+        void accept(osg::PrimitiveIndexFunctor& functor) const override;
+
         typedef std::vector<osg::ref_ptr<osg::StateSet>> PassVector;
         void setPasses(const PassVector& passes);
         const PassVector& getPasses() const { return mPasses; }
@@ -67,7 +75,13 @@ namespace Terrain
 
         void setBufferRecycler(BufferRecycler* recycler) { mBufferRecycler = recycler; }
 
+        /// Use the compact vertex format, the packed heights and normals are in the texture unit compactVertexUnit.
+        void setCompactVertexDecode(const CompactVertexDecode& value);
+        const std::optional<CompactVertexDecode>& getCompactVertexDecode() const { return mCompactVertexDecode; }
+
     private:
+        std::vector<osg::Vec3f> getCompactVertices() const;
+
         osg::BoundingBox mWaterBoundingBox;
         PassVector mPasses;
 
@@ -77,6 +91,9 @@ namespace Terrain
         osg::ref_ptr<CompositeMap> mCompositeMap;
         osg::ref_ptr<CompositeMapRenderer> mCompositeMapRenderer;
         BufferRecycler* mBufferRecycler = nullptr;
+
+        std::optional<CompactVertexDecode> mCompactVertexDecode;
+        osg::ref_ptr<osg::StateSet> mCompactVertexStateSet;
     };
 
 }
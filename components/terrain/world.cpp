@@ -124,6 +124,18 @@ namespace Terrain
         mCompositeMapRenderer->setTargetFrameRate(rate);
     }
 
+    void World::setCompactVertices(bool value)
+    {
+        if (mChunkManager)
+            mChunkManager->setCompactVertices(value);
+    }
+
+    void World::setCompositeMapCache(const CompositeMapCache* cache)
+    {
+        if (mChunkManager)
+            mChunkManager->setCompositeMapCache(cache);
+    }
+
     float World::getHeightAt(const osg::Vec3f& worldPos)
     {
         return mStorage->getHeightAt(worldPos, mWorldspace);
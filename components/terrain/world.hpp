@@ -35,6 +35,7 @@ namespace Terrain
     class TextureManager;
     class ChunkManager;
     class CompositeMapRenderer;
+    class CompositeMapCache;
     class View;
     class HeightCullCallback;
 
@@ -58,6 +59,12 @@ namespace Terrain
         /// See CompositeMapRenderer::setTargetFrameRate
         void setTargetFrameRate(float rate);
 
+        /// See ChunkManager::setCompactVertices
+        void setCompactVertices(bool value);
+
+        /// See ChunkManager::setCompositeMapCache
+        void setCompositeMapCache(const CompositeMapCache* cache);
+
         /// Apply the scene manager's texture filtering settings to all cached textures.
         /// @note Thread safe.
         void updateTextureFiltering();
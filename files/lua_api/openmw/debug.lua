@@ -66,6 +66,20 @@
 -- Reloads all Lua scripts
 -- @function [parent=#Debug] reloadLua
 
+---
+-- Is tracing of engine zones enabled (see the `tracing` setting)
+-- @function [parent=#Debug] isTracingEnabled
+-- @return #boolean
+
+---
+-- Starts or stops recording engine zones
+-- @function [parent=#Debug] setTracingEnabled
+-- @param #boolean value
+
+---
+-- Writes the recorded engine zones to trace.json and trace.perfetto-trace in the user data folder
+-- @function [parent=#Debug] dumpTrace
+
 ---
 -- Navigation mesh rendering modes
 -- @type NAV_MESH_RENDER_MODE
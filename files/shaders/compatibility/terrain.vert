@@ -24,6 +24,11 @@ centroid varying vec3 shadowSpecularLighting;
 varying vec3 passViewPos;
 varying vec3 passNormal;
 
+#if @compactVertices
+// x: chunk extent, y: height offset, z: height scale
+uniform vec4 terrainVertexDecode;
+#endif
+
 #include "vertexcolors.glsl"
 #include "shadows_vertex.glsl"
 #include "compatibility/normals.glsl"
@@ -33,15 +38,27 @@ varying vec3 passNormal;
 
 void main(void)
 {
-    gl_Position = modelToClip(gl_Vertex);
+#if @compactVertices
+    // Position in the XY plane is implied by the grid coordinates, height and hemispherical octahedral normal are packed
+    vec4 vertex = vec4((gl_MultiTexCoord0.xy - 0.5) * terrainVertexDecode.x,
+        terrainVertexDecode.y + gl_MultiTexCoord2.x * terrainVertexDecode.z, 1.0);
+    float packedNormalHigh = floor(gl_MultiTexCoord2.y / 256.0);
+    vec2 octahedralNormal = vec2(packedNormalHigh + 128.0, gl_MultiTexCoord2.y - packedNormalHigh * 256.0) / 127.5 - 1.0;
+    vec3 normal = normalize(vec3(octahedralNormal, 1.0 - abs(octahedralNormal.x) - abs(octahedralNormal.y)));
+#else
+    vec4 vertex = gl_Vertex;
+    vec3 normal = gl_Normal.xyz;
+#endif
+
+    gl_Position = modelToClip(vertex);
 
-    vec4 viewPos = modelToView(gl_Vertex);
+    vec4 viewPos = modelToView(vertex);
     gl_ClipVertex = viewPos;
     euclideanDepth = length(viewPos.xyz);
     linearDepth = getLinearDepth(gl_Position.z, viewPos.z);
 
     passColor = gl_Color;
-    passNormal = gl_Normal.xyz;
+    passNormal = normal;
     passViewPos = viewPos.xyz;
     normalToViewMatrix = gl_NormalMatrix;
 
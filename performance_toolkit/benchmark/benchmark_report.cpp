@@ -0,0 +1,149 @@
+#include "benchmark_report.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+
+namespace PerformanceToolkit
+{
+    namespace
+    {
+        // Requires sorted non empty values
+        double getPercentile(const std::vector<double>& values, double fraction)
+        {
+            const auto index = static_cast<std::size_t>(static_cast<double>(values.size()) * fraction);
+            return values[std::min(index, values.size() - 1)];
+        }
+
+        TimingStats makeTimingStats(std::string name, std::vector<double> values)
+        {
+            TimingStats result;
+            result.name = std::move(name);
+            if (values.empty())
+                return result;
+            std::sort(values.begin(), values.end());
+            result.avgTime = std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+            result.maxTime = values.back();
+            result.p99Time = getPercentile(values, 0.99);
+            return result;
+        }
+
+        template <class Function>
+        std::vector<double> getValues(const std::vector<FrameStats>& frames, Function&& function)
+        {
+            std::vector<double> result;
+            result.reserve(frames.size());
+            for (const FrameStats& frame : frames)
+                result.push_back(function(frame));
+            return result;
+        }
+
+        void writeJsonString(const std::string& value, std::ostream& stream)
+        {
+            stream << '"';
+            for (const char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    stream << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                           << std::dec;
+                else
+                    stream << c;
+            }
+            stream << '"';
+        }
+
+        // JSON has no representation for infinity and NaN
+        double toJsonNumber(double value)
+        {
+            return std::isfinite(value) ? value : 0;
+        }
+    }
+
+    BenchmarkResult makeBenchmarkResult(
+        const std::string& sceneName, std::vector<FrameStats> frames, std::span<const std::string> subsystemNames)
+    {
+        BenchmarkResult result;
+        result.sceneName = sceneName;
+        result.avgFps = 0;
+        result.minFps = 0;
+        result.avgFrameTime = 0;
+        result.maxFrameTime = 0;
+        result.p99FrameTime = 0;
+        result.totalFrames = static_cast<unsigned int>(frames.size());
+
+        if (!frames.empty())
+        {
+            std::vector<double> frameTimes = getValues(frames, [](const FrameStats& v) { return v.dt; });
+            std::sort(frameTimes.begin(), frameTimes.end());
+            const double totalTime = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0);
+            result.avgFrameTime = static_cast<float>(totalTime / static_cast<double>(frameTimes.size()));
+            result.maxFrameTime = static_cast<float>(frameTimes.back());
+            result.p99FrameTime = static_cast<float>(getPercentile(frameTimes, 0.99));
+            if (result.avgFrameTime > 0)
+                result.avgFps = 1.0f / result.avgFrameTime;
+            if (result.maxFrameTime > 0)
+                result.minFps = 1.0f / result.maxFrameTime;
+
+            result.timings.push_back(
+                makeTimingStats("cpuMain", getValues(frames, [](const FrameStats& v) { return v.cpuMainTime; })));
+            result.timings.push_back(
+                makeTimingStats("cpuCull", getValues(frames, [](const FrameStats& v) { return v.cpuCullTime; })));
+            result.timings.push_back(
+                makeTimingStats("cpuDraw", getValues(frames, [](const FrameStats& v) { return v.cpuDrawTime; })));
+            result.timings.push_back(
+                makeTimingStats("gpu", getValues(frames, [](const FrameStats& v) { return v.gpuTime; })));
+        }
+
+        for (std::size_t i = 0; i < subsystemNames.size(); ++i)
+        {
+            std::vector<double> values;
+            for (const FrameStats& frame : frames)
+                if (i < frame.cpuSubsystemTimes.size() && std::isfinite(frame.cpuSubsystemTimes[i]))
+                    values.push_back(frame.cpuSubsystemTimes[i]);
+            if (!values.empty())
+                result.timings.push_back(makeTimingStats(subsystemNames[i], std::move(values)));
+        }
+
+        result.frames = std::move(frames);
+
+        return result;
+    }
+
+    void writeBenchmarkResult(const BenchmarkResult& result, std::ostream& stream)
+    {
+        std::ostringstream output;
+        output.imbue(std::locale::classic());
+        output.precision(std::numeric_limits<float>::max_digits10);
+
+        output << "{\n";
+        output << "  \"scene\": ";
+        writeJsonString(result.sceneName, output);
+        output << ",\n";
+        output << "  \"avgFps\": " << toJsonNumber(result.avgFps) << ",\n";
+        output << "  \"minFps\": " << toJsonNumber(result.minFps) << ",\n";
+        output << "  \"avgFrameTime\": " << toJsonNumber(result.avgFrameTime) << ",\n";
+        output << "  \"maxFrameTime\": " << toJsonNumber(result.maxFrameTime) << ",\n";
+        output << "  \"p99FrameTime\": " << toJsonNumber(result.p99FrameTime) << ",\n";
+        output << "  \"totalFrames\": " << result.totalFrames << ",\n";
+        output << "  \"timings\": {";
+        for (std::size_t i = 0; i < result.timings.size(); ++i)
+        {
+            const TimingStats& timing = result.timings[i];
+            output << (i == 0 ? "\n" : ",\n") << "    ";
+            writeJsonString(timing.name, output);
+            output << ": { \"avg\": " << toJsonNumber(timing.avgTime) << ", \"max\": " << toJsonNumber(timing.maxTime)
+                   << ", \"p99\": " << toJsonNumber(timing.p99Time) << " }";
+        }
+        output << (result.timings.empty() ? "}\n" : "\n  }\n");
+        output << "}\n";
+
+        stream << output.str();
+    }
+}
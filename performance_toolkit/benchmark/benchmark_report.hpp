@@ -0,0 +1,26 @@
+#ifndef PERFORMANCE_TOOLKIT_BENCHMARK_REPORT_HPP
+#define PERFORMANCE_TOOLKIT_BENCHMARK_REPORT_HPP
+
+#include "../toolkit.hpp"
+
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace PerformanceToolkit
+{
+    /**
+     * @brief Aggregates recorded frames into BenchmarkResult.
+     *
+     * subsystemNames gives the names for FrameStats::cpuSubsystemTimes by index. Missing and non finite values are
+     * ignored, subsystems without values are not reported. Times are in seconds.
+     */
+    BenchmarkResult makeBenchmarkResult(
+        const std::string& sceneName, std::vector<FrameStats> frames, std::span<const std::string> subsystemNames);
+
+    // Writes the result as a JSON object without the per frame data.
+    void writeBenchmarkResult(const BenchmarkResult& result, std::ostream& stream);
+}
+
+#endif
@@ -0,0 +1,161 @@
+#include "benchmark_track.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <limits>
+#include <locale>
+#include <numbers>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace PerformanceToolkit
+{
+    namespace
+    {
+        [[noreturn]] void throwParseError(std::size_t lineNumber, const std::string& message)
+        {
+            throw std::runtime_error("Invalid benchmark track line " + std::to_string(lineNumber) + ": " + message);
+        }
+
+        float lerpAngle(float from, float to, float factor)
+        {
+            constexpr float pi = std::numbers::pi_v<float>;
+            float delta = std::remainder(to - from, 2 * pi);
+            // remainder rounds half to even, keep the direction stable for opposite angles
+            if (delta == -pi)
+                delta = pi;
+            return from + delta * factor;
+        }
+
+        template <class Key>
+        void checkOrder(const std::vector<Key>& keys, const Key& key)
+        {
+            if (!std::isfinite(key.time) || key.time < 0)
+                throw std::invalid_argument("Benchmark track key time has to be finite and non negative");
+            if (!keys.empty() && key.time < keys.back().time)
+                throw std::invalid_argument("Benchmark track keys have to be sorted by time");
+        }
+    }
+
+    BenchmarkTrack BenchmarkTrack::read(std::istream& stream)
+    {
+        BenchmarkTrack result;
+        std::string line;
+        std::size_t lineNumber = 0;
+
+        while (std::getline(stream, line))
+        {
+            ++lineNumber;
+
+            std::istringstream lineStream(line);
+            lineStream.imbue(std::locale::classic());
+
+            std::string kind;
+            if (!(lineStream >> kind) || kind.starts_with('#'))
+                continue;
+
+            try
+            {
+                if (kind == "camera")
+                {
+                    CameraKey key;
+                    if (!(lineStream >> key.time >> key.position[0] >> key.position[1] >> key.position[2] >> key.pitch
+                            >> key.yaw))
+                        throwParseError(lineNumber, "expected camera <time> <x> <y> <z> <pitch> <yaw>");
+                    result.addCamera(key);
+                }
+                else if (kind == "action")
+                {
+                    InputKey key;
+                    if (!(lineStream >> key.time >> key.action))
+                        throwParseError(lineNumber, "expected action <time> <action id>");
+                    result.addInput(key);
+                }
+                else
+                    throwParseError(lineNumber, "unknown key \"" + kind + "\"");
+            }
+            catch (const std::invalid_argument& e)
+            {
+                throwParseError(lineNumber, e.what());
+            }
+
+            std::string rest;
+            if (lineStream >> rest)
+                throwParseError(lineNumber, "unexpected \"" + rest + "\"");
+        }
+
+        return result;
+    }
+
+    void BenchmarkTrack::write(std::ostream& stream) const
+    {
+        std::ostringstream output;
+        output.imbue(std::locale::classic());
+        output.precision(std::numeric_limits<double>::max_digits10);
+
+        output << "# OpenMW benchmark track\n";
+        for (const CameraKey& key : mCameraKeys)
+            output << "camera " << key.time << ' ' << key.position[0] << ' ' << key.position[1] << ' '
+                   << key.position[2] << ' ' << key.pitch << ' ' << key.yaw << '\n';
+        for (const InputKey& key : mInputKeys)
+            output << "action " << key.time << ' ' << key.action << '\n';
+
+        stream << output.str();
+    }
+
+    void BenchmarkTrack::addCamera(const CameraKey& key)
+    {
+        checkOrder(mCameraKeys, key);
+        mCameraKeys.push_back(key);
+    }
+
+    void BenchmarkTrack::addInput(const InputKey& key)
+    {
+        checkOrder(mInputKeys, key);
+        mInputKeys.push_back(key);
+    }
+
+    double BenchmarkTrack::getDuration() const
+    {
+        double result = 0;
+        if (!mCameraKeys.empty())
+            result = mCameraKeys.back().time;
+        if (!mInputKeys.empty())
+            result = std::max(result, mInputKeys.back().time);
+        return result;
+    }
+
+    CameraKey BenchmarkTrack::sampleCamera(double time) const
+    {
+        const auto next = std::upper_bound(mCameraKeys.begin(), mCameraKeys.end(), time,
+            [](double value, const CameraKey& key) { return value < key.time; });
+
+        if (next == mCameraKeys.begin())
+            return mCameraKeys.front();
+        if (next == mCameraKeys.end())
+            return mCameraKeys.back();
+
+        const CameraKey& from = *std::prev(next);
+        const CameraKey& to = *next;
+        const float factor = static_cast<float>((time - from.time) / (to.time - from.time));
+
+        CameraKey result;
+        result.time = time;
+        for (std::size_t i = 0; i < result.position.size(); ++i)
+            result.position[i] = from.position[i] + (to.position[i] - from.position[i]) * factor;
+        result.pitch = from.pitch + (to.pitch - from.pitch) * factor;
+        result.yaw = lerpAngle(from.yaw, to.yaw, factor);
+        return result;
+    }
+
+    std::span<const InputKey> BenchmarkTrack::getInputs(double begin, double end) const
+    {
+        const auto byTime = [](const InputKey& key, double value) { return key.time < value; };
+        const auto first = std::lower_bound(mInputKeys.begin(), mInputKeys.end(), begin, byTime);
+        const auto last = std::lower_bound(first, mInputKeys.end(), end, byTime);
+        return std::span<const InputKey>(first, last);
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef PERFORMANCE_TOOLKIT_BENCHMARK_TRACK_HPP
+#define PERFORMANCE_TOOLKIT_BENCHMARK_TRACK_HPP
+
+#include <array>
+#include <iosfwd>
+#include <span>
+#include <vector>
+
+namespace PerformanceToolkit
+{
+    // Player position and view direction at the given time since the start of the track. Angles are in radians.
+    struct CameraKey
+    {
+        double time = 0;
+        std::array<float, 3> position{};
+        float pitch = 0;
+        float yaw = 0;
+    };
+
+    // Input action (MWInput::Actions) executed once when the track reaches the given time.
+    struct InputKey
+    {
+        double time = 0;
+        int action = 0;
+    };
+
+    /**
+     * @brief Recorded camera path and input actions replayed by the benchmark mode.
+     *
+     * Stored as a text file with a key per line, keys of each kind are sorted by time:
+     *
+     *     # comment
+     *     camera <time> <x> <y> <z> <pitch> <yaw>
+     *     action <time> <action id>
+     *
+     * The camera is interpolated linearly between keys, yaw takes the shortest way around the circle.
+     */
+    class BenchmarkTrack
+    {
+    public:
+        // Throws std::runtime_error with the line number on malformed input.
+        static BenchmarkTrack read(std::istream& stream);
+
+        void write(std::ostream& stream) const;
+
+        // Keys have to be added in the order of time.
+        void addCamera(const CameraKey& key);
+        void addInput(const InputKey& key);
+
+        std::span<const CameraKey> getCameraKeys() const { return mCameraKeys; }
+        std::span<const InputKey> getInputKeys() const { return mInputKeys; }
+
+        // Time of the last key
+        double getDuration() const;
+
+        bool hasCamera() const { return !mCameraKeys.empty(); }
+
+        // Camera at the given time, clamped to the first and the last key. Requires hasCamera().
+        CameraKey sampleCamera(double time) const;
+
+        // Input keys with time in [begin, end)
+        std::span<const InputKey> getInputs(double begin, double end) const;
+
+    private:
+        std::vector<CameraKey> mCameraKeys;
+        std::vector<InputKey> mInputKeys;
+    };
+}
+
+#endif
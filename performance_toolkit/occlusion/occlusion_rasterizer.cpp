@@ -0,0 +1,278 @@
+#include "occlusion_rasterizer.hpp"
+
+#include <components/misc/jobsystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+namespace PerformanceToolkit
+{
+    namespace
+    {
+        // Rows rendered by one job.
+        constexpr int sRowsPerJob = 8;
+
+        // Clip space w below which a vertex is considered to be at or behind the near plane.
+        constexpr float sMinW = 1e-3f;
+
+        std::array<float, 4> transform(const OcclusionVertex& v, const OcclusionMatrix& m)
+        {
+            return {
+                v.x * m[0] + v.y * m[4] + v.z * m[8] + m[12],
+                v.x * m[1] + v.y * m[5] + v.z * m[9] + m[13],
+                v.x * m[2] + v.y * m[6] + v.z * m[10] + m[14],
+                v.x * m[3] + v.y * m[7] + v.z * m[11] + m[15],
+            };
+        }
+    }
+
+    OcclusionRasterizer::OcclusionRasterizer(unsigned width, unsigned height)
+        : mWidth(width)
+        , mHeight(height)
+        , mDepth(static_cast<std::size_t>(width) * height, 0.0f)
+    {
+    }
+
+    void OcclusionRasterizer::clear()
+    {
+        std::fill(mDepth.begin(), mDepth.end(), 0.0f);
+        mTriangles.clear();
+    }
+
+    void OcclusionRasterizer::addOccluder(std::span<const OcclusionVertex> vertices, std::span<const unsigned> indices,
+        const OcclusionMatrix& modelViewProjection)
+    {
+        const float width = static_cast<float>(mWidth);
+        const float height = static_cast<float>(mHeight);
+
+        // x, y in pixels and 1 / w, negative 1 / w marks vertices behind the near plane
+        mScreenVertices.clear();
+        for (const OcclusionVertex& vertex : vertices)
+        {
+            const std::array<float, 4> clip = transform(vertex, modelViewProjection);
+            if (clip[3] < sMinW)
+            {
+                mScreenVertices.push_back({ 0, 0, -1 });
+                continue;
+            }
+            const float invW = 1.0f / clip[3];
+            mScreenVertices.push_back(
+                { (clip[0] * invW * 0.5f + 0.5f) * width, (clip[1] * invW * 0.5f + 0.5f) * height, invW });
+        }
+
+        const auto isRasterized = [&](unsigned i0, unsigned i1, unsigned i2) {
+            if (i0 >= mScreenVertices.size() || i1 >= mScreenVertices.size() || i2 >= mScreenVertices.size())
+                return false;
+            const std::array<float, 3>& v0 = mScreenVertices[i0];
+            const std::array<float, 3>& v1 = mScreenVertices[i1];
+            const std::array<float, 3>& v2 = mScreenVertices[i2];
+            if (v0[2] < 0 || v1[2] < 0 || v2[2] < 0)
+                return false;
+            const float area = (v1[0] - v0[0]) * (v2[1] - v0[1]) - (v2[0] - v0[0]) * (v1[1] - v0[1]);
+            return area > 0 || area < 0;
+        };
+
+        // Screen space side of the point relative to the edge line
+        const auto getSide = [&](unsigned from, unsigned to, unsigned point) {
+            const std::array<float, 3>& a = mScreenVertices[from];
+            const std::array<float, 3>& b = mScreenVertices[to];
+            const std::array<float, 3>& p = mScreenVertices[point];
+            const float cross = (b[0] - a[0]) * (p[1] - a[1]) - (b[1] - a[1]) * (p[0] - a[0]);
+            return (cross > 0) - (cross < 0);
+        };
+
+        mEdges.clear();
+        for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const bool rasterized = isRasterized(indices[i], indices[i + 1], indices[i + 2]);
+            for (std::size_t edge = 0; edge < 3; ++edge)
+            {
+                const auto [from, to] = std::minmax(indices[i + edge], indices[i + (edge + 1) % 3]);
+                mEdges.push_back(Edge{ .mFrom = from,
+                    .mTo = to,
+                    .mOpposite = indices[i + (edge + 2) % 3],
+                    .mRasterized = rasterized });
+            }
+        }
+        std::sort(mEdges.begin(), mEdges.end(),
+            [](const Edge& l, const Edge& r) { return std::tie(l.mFrom, l.mTo) < std::tie(r.mFrom, r.mTo); });
+
+        // Pixels crossed by an edge are covered by the neighbour triangle only when the edge is shared by exactly two
+        // rasterized triangles lying on the opposite sides of it on the screen. Silhouette edges where the surface
+        // folds over don't qualify.
+        const auto isInnerEdge = [&](unsigned first, unsigned second) {
+            const auto [from, to] = std::minmax(first, second);
+            const auto range = std::equal_range(mEdges.begin(), mEdges.end(), Edge{ .mFrom = from, .mTo = to },
+                [](const Edge& l, const Edge& r) { return std::tie(l.mFrom, l.mTo) < std::tie(r.mFrom, r.mTo); });
+            if (range.second - range.first != 2)
+                return false;
+            const Edge& l = *range.first;
+            const Edge& r = *(range.first + 1);
+            if (!l.mRasterized || !r.mRasterized)
+                return false;
+            const int lSide = getSide(from, to, l.mOpposite);
+            const int rSide = getSide(from, to, r.mOpposite);
+            return lSide != 0 && lSide == -rSide;
+        };
+
+        for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            std::array<unsigned, 3> triangleIndices{ indices[i], indices[i + 1], indices[i + 2] };
+
+            if (!isRasterized(triangleIndices[0], triangleIndices[1], triangleIndices[2]))
+                continue;
+
+            std::array<float, 3> v0 = mScreenVertices[triangleIndices[0]];
+            std::array<float, 3> v1 = mScreenVertices[triangleIndices[1]];
+            std::array<float, 3> v2 = mScreenVertices[triangleIndices[2]];
+
+            float area = (v1[0] - v0[0]) * (v2[1] - v0[1]) - (v2[0] - v0[0]) * (v1[1] - v0[1]);
+            if (area < 0)
+            {
+                std::swap(v1, v2);
+                std::swap(triangleIndices[1], triangleIndices[2]);
+                area = -area;
+            }
+
+            Triangle triangle;
+
+            triangle.mMinX = std::max(0, static_cast<int>(std::floor(std::min({ v0[0], v1[0], v2[0] }))));
+            triangle.mMaxX = std::min(static_cast<int>(mWidth),
+                static_cast<int>(std::ceil(std::min(std::max({ v0[0], v1[0], v2[0] }), width))));
+            triangle.mMinY = std::max(0, static_cast<int>(std::floor(std::min({ v0[1], v1[1], v2[1] }))));
+            triangle.mMaxY = std::min(static_cast<int>(mHeight),
+                static_cast<int>(std::ceil(std::min(std::max({ v0[1], v1[1], v2[1] }), height))));
+            if (triangle.mMinX >= triangle.mMaxX || triangle.mMinY >= triangle.mMaxY)
+                continue;
+
+            const std::array<const std::array<float, 3>*, 3> points{ &v0, &v1, &v2 };
+            for (std::size_t edge = 0; edge < 3; ++edge)
+            {
+                const std::array<float, 3>& from = *points[edge];
+                const std::array<float, 3>& to = *points[(edge + 1) % 3];
+                const float a = from[1] - to[1];
+                const float b = to[0] - from[0];
+                const float c = -a * from[0] - b * from[1];
+                triangle.mEdgeA[edge] = a;
+                triangle.mEdgeB[edge] = b;
+                // It's enough to check the pixel center for inner edges. Otherwise evaluate at the pixel corner
+                // farthest inside the edge to require full coverage.
+                if (isInnerEdge(triangleIndices[edge], triangleIndices[(edge + 1) % 3]))
+                    triangle.mEdgeC[edge] = c + 0.5f * (a + b);
+                else
+                    triangle.mEdgeC[edge] = c + 0.5f * (a + b) - 0.5f * (std::abs(a) + std::abs(b));
+            }
+
+            const float depthA = ((v1[2] - v0[2]) * (v2[1] - v0[1]) - (v2[2] - v0[2]) * (v1[1] - v0[1])) / area;
+            const float depthB = ((v2[2] - v0[2]) * (v1[0] - v0[0]) - (v1[2] - v0[2]) * (v2[0] - v0[0])) / area;
+            const float depthC = v0[2] - depthA * v0[0] - depthB * v0[1];
+            // Evaluate at the pixel corner with the farthest depth
+            triangle.mDepthA = depthA;
+            triangle.mDepthB = depthB;
+            triangle.mDepthC = depthC + 0.5f * (depthA + depthB) - 0.5f * (std::abs(depthA) + std::abs(depthB));
+            triangle.mMinDepth = std::min({ v0[2], v1[2], v2[2] });
+
+            mTriangles.push_back(triangle);
+        }
+    }
+
+    void OcclusionRasterizer::render(Misc::JobSystem* jobSystem)
+    {
+        const int height = static_cast<int>(mHeight);
+
+        if (jobSystem == nullptr || jobSystem->getNumThreads() == 0 || height <= sRowsPerJob)
+        {
+            renderRows(0, height);
+            return;
+        }
+
+        jobSystem->parallelFor(
+            0, mHeight, sRowsPerJob,
+            [this](std::size_t begin, std::size_t end) {
+                renderRows(static_cast<int>(begin), static_cast<int>(end));
+            },
+            Misc::JobPriority::High);
+    }
+
+    void OcclusionRasterizer::renderRows(int begin, int end)
+    {
+        for (const Triangle& triangle : mTriangles)
+        {
+            const int minY = std::max(begin, triangle.mMinY);
+            const int maxY = std::min(end, triangle.mMaxY);
+
+            for (int y = minY; y < maxY; ++y)
+            {
+                const float fy = static_cast<float>(y);
+                const float edge0 = triangle.mEdgeB[0] * fy + triangle.mEdgeC[0];
+                const float edge1 = triangle.mEdgeB[1] * fy + triangle.mEdgeC[1];
+                const float edge2 = triangle.mEdgeB[2] * fy + triangle.mEdgeC[2];
+                const float depth = triangle.mDepthB * fy + triangle.mDepthC;
+                float* const row = mDepth.data() + static_cast<std::size_t>(y) * mWidth;
+
+                // Branchless to let the compiler vectorize the loop
+                for (int x = triangle.mMinX; x < triangle.mMaxX; ++x)
+                {
+                    const float fx = static_cast<float>(x);
+                    const bool covered = (triangle.mEdgeA[0] * fx + edge0 >= 0)
+                        & (triangle.mEdgeA[1] * fx + edge1 >= 0) & (triangle.mEdgeA[2] * fx + edge2 >= 0);
+                    const float pixelDepth = std::max(triangle.mDepthA * fx + depth, triangle.mMinDepth);
+                    row[x] = covered ? std::max(row[x], pixelDepth) : row[x];
+                }
+            }
+        }
+    }
+
+    bool OcclusionRasterizer::isOccluded(
+        const OcclusionVertex& min, const OcclusionVertex& max, const OcclusionMatrix& modelViewProjection) const
+    {
+        if (mTriangles.empty())
+            return false;
+
+        float minX = std::numeric_limits<float>::max();
+        float maxX = std::numeric_limits<float>::lowest();
+        float minY = std::numeric_limits<float>::max();
+        float maxY = std::numeric_limits<float>::lowest();
+        float maxDepth = 0;
+
+        for (unsigned i = 0; i < 8; ++i)
+        {
+            const OcclusionVertex corner{ (i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z };
+            const std::array<float, 4> clip = transform(corner, modelViewProjection);
+            // The box intersects the near plane, depth of the nearest point is unknown
+            if (clip[3] < sMinW)
+                return false;
+            const float invW = 1.0f / clip[3];
+            const float x = (clip[0] * invW * 0.5f + 0.5f) * static_cast<float>(mWidth);
+            const float y = (clip[1] * invW * 0.5f + 0.5f) * static_cast<float>(mHeight);
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+            maxDepth = std::max(maxDepth, invW);
+        }
+
+        const float width = static_cast<float>(mWidth);
+        const float height = static_cast<float>(mHeight);
+        const int beginX = static_cast<int>(std::floor(std::clamp(minX, 0.0f, width)));
+        const int endX = static_cast<int>(std::ceil(std::clamp(maxX, 0.0f, width)));
+        const int beginY = static_cast<int>(std::floor(std::clamp(minY, 0.0f, height)));
+        const int endY = static_cast<int>(std::ceil(std::clamp(maxY, 0.0f, height)));
+
+        // Off screen boxes are left for the frustum culling
+        if (beginX >= endX || beginY >= endY)
+            return false;
+
+        for (int y = beginY; y < endY; ++y)
+        {
+            const float* const row = mDepth.data() + static_cast<std::size_t>(y) * mWidth;
+            for (int x = beginX; x < endX; ++x)
+                if (row[x] <= maxDepth)
+                    return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef PERFORMANCE_TOOLKIT_OCCLUSION_RASTERIZER_HPP
+#define PERFORMANCE_TOOLKIT_OCCLUSION_RASTERIZER_HPP
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    class JobSystem;
+}
+
+namespace PerformanceToolkit
+{
+    struct OcclusionVertex
+    {
+        float x = 0;
+        float y = 0;
+        float z = 0;
+    };
+
+    // 4x4 matrix transforming row vectors (v * M) stored row by row, the layout of osg::Matrixf::ptr().
+    using OcclusionMatrix = std::array<float, 16>;
+
+    /**
+     * @brief Rasterizes occluder triangles into a low resolution depth buffer on CPU and tests boxes against it.
+     *
+     * The buffer stores 1 / w of the clip space position of the nearest occluder, so tests do not depend on the depth
+     * range convention of the projection matrix and require a perspective projection. Occluders are rasterized
+     * conservatively: a pixel is written only when the occluder covers it completely, with the farthest depth of the
+     * triangle inside the pixel. Coverage is tested against the pixel centers only for edges shared by two rasterized
+     * triangles of the same occluder lying on the opposite sides of the edge on the screen, and against the pixel
+     * corners for the others, including silhouette edges. Triangles crossing the near plane are skipped. Results do
+     * not depend on the order of occluders or the number of threads used to render.
+     */
+    class OcclusionRasterizer
+    {
+    public:
+        OcclusionRasterizer(unsigned width, unsigned height);
+
+        unsigned getWidth() const { return mWidth; }
+        unsigned getHeight() const { return mHeight; }
+
+        // Remove queued triangles and reset the depth buffer to the infinitely far plane.
+        void clear();
+
+        // Transform occluder triangles to the screen space and queue them for rendering. Each triplet of indices
+        // defines a triangle, both windings are accepted.
+        void addOccluder(std::span<const OcclusionVertex> vertices, std::span<const unsigned> indices,
+            const OcclusionMatrix& modelViewProjection);
+
+        // Rasterize queued triangles. The buffer is split into bands of rows rendered on the job system threads when
+        // it is provided.
+        void render(Misc::JobSystem* jobSystem = nullptr);
+
+        // Returns true if the box is behind rendered occluders in every on screen pixel it covers.
+        bool isOccluded(const OcclusionVertex& min, const OcclusionVertex& max,
+            const OcclusionMatrix& modelViewProjection) const;
+
+        float getDepth(unsigned x, unsigned y) const { return mDepth[y * mWidth + x]; }
+
+        std::size_t getNumTriangles() const { return mTriangles.size(); }
+
+    private:
+        struct Triangle
+        {
+            // Edge functions a * x + b * y + c for integer pixel coordinates, non negative when the pixel is fully
+            // covered.
+            std::array<float, 3> mEdgeA;
+            std::array<float, 3> mEdgeB;
+            std::array<float, 3> mEdgeC;
+            // Plane giving the farthest depth inside an integer pixel.
+            float mDepthA;
+            float mDepthB;
+            float mDepthC;
+            float mMinDepth;
+            int mMinX;
+            int mMaxX;
+            int mMinY;
+            int mMaxY;
+        };
+
+        struct Edge
+        {
+            // Vertex indices of the edge, mFrom <= mTo
+            unsigned mFrom = 0;
+            unsigned mTo = 0;
+            // Vertex of the triangle not on the edge
+            unsigned mOpposite = 0;
+            bool mRasterized = false;
+        };
+
+        unsigned mWidth;
+        unsigned mHeight;
+        std::vector<float> mDepth;
+        std::vector<Triangle> mTriangles;
+        std::vector<std::array<float, 3>> mScreenVertices;
+        std::vector<Edge> mEdges;
+
+        void renderRows(int begin, int end);
+    };
+}
+
+#endif
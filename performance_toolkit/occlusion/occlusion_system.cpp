@@ -1,8 +1,130 @@
 #include "occlusion_system.hpp"
+#include <osg/Camera>
+#include <osg/Switch>
+#include <osg/TriangleFunctor>
 #include <osgOcclusionQuery/OcclusionQueryNode>
+#include <osgUtil/CullVisitor>
+#include <algorithm>
+#include <array>
 
 namespace PerformanceToolkit
 {
+    namespace
+    {
+        struct OccluderTriangleCollector
+        {
+            osg::Matrixf mMatrix;
+            std::vector<std::array<osg::Vec3f, 3>>* mTriangles = nullptr;
+
+            void operator()(const osg::Vec3& v1, const osg::Vec3& v2, const osg::Vec3& v3,
+                bool /*temp*/ = false) // Note: unused temp argument left here for OSG versions less than 3.5.6
+            {
+                mTriangles->push_back({ mMatrix.preMult(v1), mMatrix.preMult(v2), mMatrix.preMult(v3) });
+            }
+        };
+
+        // Collects triangles of the children in the local space of the traversed node.
+        class OccluderMeshVisitor : public osg::NodeVisitor
+        {
+        public:
+            std::vector<std::array<osg::Vec3f, 3>> mTriangles;
+
+            OccluderMeshVisitor() : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN) {}
+
+            void apply(osg::Drawable& drawable) override
+            {
+                osg::TriangleFunctor<OccluderTriangleCollector> functor;
+                functor.mMatrix = osg::computeLocalToWorld(getNodePath());
+                functor.mTriangles = &mTriangles;
+                drawable.accept(functor);
+            }
+        };
+
+        float getArea(const std::array<osg::Vec3f, 3>& triangle)
+        {
+            return ((triangle[1] - triangle[0]) ^ (triangle[2] - triangle[0])).length() * 0.5f;
+        }
+
+        // Keep only the largest triangles. Dropping triangles keeps the occluder conservative.
+        void buildOccluderMesh(osg::Node& node, unsigned int maxTriangles, std::vector<OcclusionVertex>& vertices,
+            std::vector<unsigned>& indices)
+        {
+            OccluderMeshVisitor visitor;
+            node.traverse(visitor);
+
+            std::vector<std::array<osg::Vec3f, 3>>& triangles = visitor.mTriangles;
+            std::stable_sort(triangles.begin(), triangles.end(),
+                [](const auto& l, const auto& r) { return getArea(l) > getArea(r); });
+            if (triangles.size() > maxTriangles)
+                triangles.resize(maxTriangles);
+
+            // Weld vertices to let the rasterizer find edges shared by triangles
+            std::map<std::array<float, 3>, unsigned> vertexIndices;
+            for (const std::array<osg::Vec3f, 3>& triangle : triangles)
+            {
+                for (const osg::Vec3f& position : triangle)
+                {
+                    const auto [it, inserted] = vertexIndices.emplace(
+                        std::array<float, 3>{ position.x(), position.y(), position.z() },
+                        static_cast<unsigned>(vertices.size()));
+                    if (inserted)
+                        vertices.push_back(OcclusionVertex{ position.x(), position.y(), position.z() });
+                    indices.push_back(it->second);
+                }
+            }
+        }
+
+        OcclusionMatrix toOcclusionMatrix(const osg::Matrix& matrix)
+        {
+            OcclusionMatrix result;
+            for (std::size_t i = 0; i < result.size(); ++i)
+                result[i] = static_cast<float>(matrix.ptr()[i]);
+            return result;
+        }
+
+        // Returns the path of the node traversed by the cull visitor or nullptr when the node is not part of the
+        // traversed scene or is hidden by a node mask or a switch.
+        const osg::NodePath* findCulledPath(const osg::NodePathList& paths, const osgUtil::CullVisitor& cv)
+        {
+            const osg::NodePath& cullPath = cv.getNodePath();
+            if (cullPath.empty())
+                return nullptr;
+
+            for (const osg::NodePath& path : paths)
+            {
+                const auto root = std::find(path.begin(), path.end(), cullPath.front());
+                if (root == path.end())
+                    continue;
+
+                bool visible = true;
+                for (auto it = root; visible && it != path.end(); ++it)
+                {
+                    if (!cv.validNodeMask(**it))
+                        visible = false;
+                    else if (const osg::Switch* switchNode = (*it)->asSwitch();
+                             switchNode != nullptr && std::next(it) != path.end())
+                        visible = switchNode->getChildValue(*std::next(it));
+                }
+                if (visible)
+                    return &path;
+            }
+
+            return nullptr;
+        }
+
+        class SoftwareOcclusionCallback : public osg::NodeCallback
+        {
+        public:
+            void operator()(osg::Node* node, osg::NodeVisitor* nv) override
+            {
+                if (nv->getVisitorType() == osg::NodeVisitor::CULL_VISITOR
+                    && OcclusionSystem::getInstance().isOccluded(*node, *static_cast<osgUtil::CullVisitor*>(nv)))
+                    return;
+                traverse(node, nv);
+            }
+        };
+    }
+
     OcclusionSystem& OcclusionSystem::getInstance()
     {
         static OcclusionSystem instance;
@@ -14,48 +136,82 @@ namespace PerformanceToolkit
     void OcclusionSystem::update()
     {
         mOccludedCount = 0;
-        
+
         // Maintenance: Remove nodes that are no longer in the scene
         auto prune = [](auto& container) {
-            container.erase(std::remove_if(container.begin(), container.end(), 
-                [](const auto& node) { return !node.valid() || node->getNumParents() == 0; }), 
+            container.erase(std::remove_if(container.begin(), container.end(),
+                [](const auto& node) { return !node.valid() || node->getNumParents() == 0; }),
                 container.end());
         };
-        
-        prune(mOccluders);
+
         prune(mOccludees);
+        prune(mSoftwareOccludees);
+
+        mOccluders.erase(std::remove_if(mOccluders.begin(), mOccluders.end(),
+            [](const Occluder& occluder) { return occluder.mNode->getNumParents() == 0; }),
+            mOccluders.end());
 
         for (auto& oqn : mOccludees)
         {
             // Only count if the query has actually finished to avoid flickering stats
             if (oqn->getQueryResultReady())
             {
-                if (!oqn->getPassed()) 
+                if (!oqn->getPassed())
                     mOccludedCount++;
             }
         }
+
+        // Software backend tests happen during the cull of the previous frame
+        mOccludedCount += mSoftwareOccludedCount;
+        mSoftwareOccludedCount = 0;
+
+        // Forget cameras which are no longer culled
+        for (auto it = mCameraStates.begin(); it != mCameraStates.end();)
+        {
+            if (it->second.mFrameNumber + 1 < mLastFrameNumber)
+                it = mCameraStates.erase(it);
+            else
+                ++it;
+        }
     }
 
     void OcclusionSystem::registerOccluder(osg::Node* node)
     {
         if (!node) return;
-        
+
         // Prevent double registration
-        if (std::find(mOccluders.begin(), mOccluders.end(), node) != mOccluders.end())
+        if (std::find_if(mOccluders.begin(), mOccluders.end(),
+                [node](const Occluder& occluder) { return occluder.mNode == node; })
+            != mOccluders.end())
             return;
 
-        mOccluders.push_back(node);
+        Occluder occluder;
+        occluder.mNode = node;
+        buildOccluderMesh(*node, mMaxOccluderTriangles, occluder.mVertices, occluder.mIndices);
+        mOccluders.push_back(std::move(occluder));
     }
 
     void OcclusionSystem::unregisterOccluder(osg::Node* node)
     {
-        mOccluders.erase(std::remove(mOccluders.begin(), mOccluders.end(), node), mOccluders.end());
+        mOccluders.erase(std::remove_if(mOccluders.begin(), mOccluders.end(),
+            [node](const Occluder& occluder) { return occluder.mNode == node; }),
+            mOccluders.end());
     }
 
     void OcclusionSystem::wrapOccludee(osg::Group* parent, osg::Node* occludee, unsigned int drawCallImpact)
     {
         if (!parent || !occludee) return;
 
+        if (mBackend == OcclusionBackend::Software)
+        {
+            // Tests are cheap and don't need throttling, the occludee stays in place
+            if (std::find(mSoftwareOccludees.begin(), mSoftwareOccludees.end(), occludee) != mSoftwareOccludees.end())
+                return;
+            occludee->addCullCallback(new SoftwareOcclusionCallback);
+            mSoftwareOccludees.push_back(occludee);
+            return;
+        }
+
         // Phase 3: Throttling - Only query if it's "worth it" or we have spare slots
         if (mOccludees.size() >= mMaxActiveQueries && drawCallImpact < 5)
             return;
@@ -64,7 +220,7 @@ namespace PerformanceToolkit
         osg::ref_ptr<osg::OcclusionQueryNode> oqn = new osg::OcclusionQueryNode;
         oqn->addChild(occludee);
         oqn->setQueriesEnabled(true);
-        
+
         mOccludees.push_back(oqn);
         // Replace original occludee with the OQN
         parent->replaceChild(occludee, oqn.get());
@@ -73,10 +229,113 @@ namespace PerformanceToolkit
     void OcclusionSystem::removeOccludee(osg::Node* node)
     {
         // Find the OQN that wraps this node
-        mOccludees.erase(std::remove_if(mOccludees.begin(), mOccludees.end(), 
-            [node](const auto& oqn) { 
-                return oqn->getNumChildren() > 0 && oqn->getChild(0) == node; 
-            }), 
+        mOccludees.erase(std::remove_if(mOccludees.begin(), mOccludees.end(),
+            [node](const auto& oqn) {
+                return oqn->getNumChildren() > 0 && oqn->getChild(0) == node;
+            }),
             mOccludees.end());
+
+        const auto software = std::find(mSoftwareOccludees.begin(), mSoftwareOccludees.end(), node);
+        if (software == mSoftwareOccludees.end())
+            return;
+
+        for (osg::Callback* callback = node->getCullCallback(); callback != nullptr;
+             callback = callback->getNestedCallback())
+        {
+            if (dynamic_cast<SoftwareOcclusionCallback*>(callback) != nullptr)
+            {
+                node->removeCullCallback(callback);
+                break;
+            }
+        }
+
+        mSoftwareOccludees.erase(software);
+    }
+
+    bool OcclusionSystem::isOccluded(const osg::Node& occludee, osgUtil::CullVisitor& cv)
+    {
+        if (mOccluders.empty())
+            return false;
+
+        const osg::Camera* camera = cv.getCurrentCamera();
+        const osg::RefMatrix* projection = cv.getProjectionMatrix();
+        if (camera == nullptr || projection == nullptr)
+            return false;
+
+        // Depth is compared by 1 / w, which is constant for orthographic projections like the shadow maps use
+        if ((*projection)(2, 3) == 0)
+            return false;
+
+        const osg::BoundingSphere& bound = occludee.getBound();
+        if (!bound.valid())
+            return false;
+
+        const unsigned int frameNumber = cv.getFrameStamp() != nullptr ? cv.getFrameStamp()->getFrameNumber() : 0;
+        mLastFrameNumber = frameNumber;
+
+        auto it = mCameraStates.find(camera);
+        if (it == mCameraStates.end())
+            it = mCameraStates.try_emplace(camera, mBufferWidth, mBufferHeight).first;
+        CameraState& state = it->second;
+
+        if (!state.mRendered || state.mFrameNumber != frameNumber)
+        {
+            state.mFrameNumber = frameNumber;
+            state.mRendered = true;
+            state.mViewProjection = camera->getViewMatrix() * *projection;
+            renderOccluders(state, camera->getInverseViewMatrix().getTrans(), cv);
+        }
+
+        // The bound is in the parent space
+        osg::NodePath path = cv.getNodePath();
+        if (!path.empty() && path.back() == &occludee)
+            path.pop_back();
+        const osg::Matrix matrix = osg::computeLocalToWorld(path) * state.mViewProjection;
+
+        const osg::Vec3f radius(bound.radius(), bound.radius(), bound.radius());
+        const osg::Vec3f min = bound.center() - radius;
+        const osg::Vec3f max = bound.center() + radius;
+        if (!state.mRasterizer.isOccluded(OcclusionVertex{ min.x(), min.y(), min.z() },
+                OcclusionVertex{ max.x(), max.y(), max.z() }, toOcclusionMatrix(matrix)))
+            return false;
+
+        ++mSoftwareOccludedCount;
+        return true;
+    }
+
+    void OcclusionSystem::renderOccluders(
+        CameraState& state, const osg::Vec3f& eyePoint, const osgUtil::CullVisitor& cv)
+    {
+        state.mRasterizer.clear();
+
+        // Prefer occluders covering a larger part of the view
+        mOccluderOrder.clear();
+        for (std::size_t i = 0; i < mOccluders.size(); ++i)
+        {
+            const Occluder& occluder = mOccluders[i];
+            if (occluder.mIndices.empty() || occluder.mNode->getNumParents() == 0)
+                continue;
+            const osg::BoundingSphere& bound = occluder.mNode->getBound();
+            const float distance = std::max((bound.center() - eyePoint).length(), 1.0f);
+            mOccluderOrder.emplace_back(-bound.radius() / distance, i);
+        }
+
+        std::sort(mOccluderOrder.begin(), mOccluderOrder.end());
+
+        unsigned int rendered = 0;
+        for (std::size_t i = 0; i < mOccluderOrder.size() && rendered < mMaxRenderedOccluders; ++i)
+        {
+            const Occluder& occluder = mOccluders[mOccluderOrder[i].second];
+            // Occluders hidden from the current traversal must not hide anything
+            const osg::NodePathList paths = occluder.mNode->getParentalNodePaths();
+            const osg::NodePath* path = findCulledPath(paths, cv);
+            if (path == nullptr)
+                continue;
+            const osg::Matrix matrix = osg::computeLocalToWorld(*path) * state.mViewProjection;
+            state.mRasterizer.addOccluder(occluder.mVertices, occluder.mIndices, toOcclusionMatrix(matrix));
+            ++rendered;
+        }
+
+        state.mRasterizer.render(mJobSystem);
     }
 }
@@ -3,11 +3,38 @@
 
 #include <osg/ref_ptr>
 #include <osg/Group>
+#include <osg/Matrix>
 #include <map>
 #include <vector>
 
+#include "occlusion_rasterizer.hpp"
+
+namespace osg
+{
+    class Camera;
+    class OcclusionQueryNode;
+}
+
+namespace osgUtil
+{
+    class CullVisitor;
+}
+
+namespace Misc
+{
+    class JobSystem;
+}
+
 namespace PerformanceToolkit
 {
+    enum class OcclusionBackend
+    {
+        // Occluders are rasterized on CPU every frame, occludees are tested during cull.
+        Software,
+        // Occludees are wrapped into osg::OcclusionQueryNode, results are available a frame later.
+        HardwareQueries,
+    };
+
     /**
      * @brief Manages occlusion queries and occluder registration.
      */
@@ -17,26 +44,73 @@ namespace PerformanceToolkit
         static OcclusionSystem& getInstance();
 
         void update();
-        
+
         // Register a node as a potential occluder (large building, wall, etc.)
         void registerOccluder(osg::Node* node);
         void unregisterOccluder(osg::Node* node);
-        
+
         // Wrap a group of nodes that should be occluded by occluders
         void wrapOccludee(osg::Group* parent, osg::Node* occludee, unsigned int drawCallImpact = 1);
         void removeOccludee(osg::Node* node);
 
         unsigned int getOccludedCount() const { return mOccludedCount; }
 
+        // Applies to occludees wrapped after the call
+        void setBackend(OcclusionBackend backend) { mBackend = backend; }
+        OcclusionBackend getBackend() const { return mBackend; }
+
+        // Threads used to rasterize occluders, rendering happens on the cull thread when not set
+        void setJobSystem(Misc::JobSystem* jobSystem) { mJobSystem = jobSystem; }
+
+        // Software backend: test the bounds of the occludee against occluders rendered for the current camera
+        bool isOccluded(const osg::Node& occludee, osgUtil::CullVisitor& cv);
+
     private:
         OcclusionSystem();
-        
-        std::vector<osg::ref_ptr<osg::Node>> mOccluders;
+
+        struct Occluder
+        {
+            osg::ref_ptr<osg::Node> mNode;
+            // Simplified mesh in the local space of the node
+            std::vector<OcclusionVertex> mVertices;
+            std::vector<unsigned> mIndices;
+        };
+
+        struct CameraState
+        {
+            unsigned int mFrameNumber = 0;
+            bool mRendered = false;
+            osg::Matrix mViewProjection;
+            OcclusionRasterizer mRasterizer;
+
+            CameraState(unsigned width, unsigned height)
+                : mRasterizer(width, height)
+            {
+            }
+        };
+
+        void renderOccluders(CameraState& state, const osg::Vec3f& eyePoint, const osgUtil::CullVisitor& cv);
+
+        std::vector<Occluder> mOccluders;
         std::vector<osg::ref_ptr<osg::OcclusionQueryNode>> mOccludees;
+        std::vector<osg::ref_ptr<osg::Node>> mSoftwareOccludees;
+        std::map<const osg::Camera*, CameraState> mCameraStates;
+        std::vector<std::pair<float, std::size_t>> mOccluderOrder;
         unsigned int mOccludedCount = 0;
-        
+        unsigned int mSoftwareOccludedCount = 0;
+        unsigned int mLastFrameNumber = 0;
+
+        OcclusionBackend mBackend = OcclusionBackend::HardwareQueries;
+        Misc::JobSystem* mJobSystem = nullptr;
+
+        // Software backend: depth buffer resolution and limits of the rendered geometry
+        unsigned int mBufferWidth = 256;
+        unsigned int mBufferHeight = 128;
+        unsigned int mMaxRenderedOccluders = 64;
+        unsigned int mMaxOccluderTriangles = 128;
+
         // Phase 3: Throttling
-        unsigned int mMaxActiveQueries = 256; 
+        unsigned int mMaxActiveQueries = 256;
         unsigned int mActiveQueryCount = 0;
     };
 }
@@ -1,9 +1,8 @@
 #include "toolkit.hpp"
+#include "benchmark/benchmark_report.hpp"
 #include "occlusion/occlusion_system.hpp"
 #include "content_scanner/scanner.hpp"
 #include <osg/Stats>
-#include <numeric>
-#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -61,6 +60,7 @@ namespace PerformanceToolkit
         {
             FrameStats fs;
             fs.dt = static_cast<float>(dt);
+            fs.cpuMainTime = 0;
             fs.cpuCullTime = cullTime;
             fs.cpuDrawTime = drawTime;
             fs.gpuTime = gpuTime;
@@ -113,43 +113,14 @@ namespace PerformanceToolkit
             return;
         }
 
-        BenchmarkResult res;
-        res.sceneName = mCurrentBenchmarkScene;
-        res.totalFrames = mBenchmarkFrames.size();
-        
-        float totalTime = 0;
-        res.minFps = 1e10f;
-        res.maxFrameTime = 0;
-        
-        std::vector<float> dts;
-        for (const auto& f : mBenchmarkFrames)
-        {
-            totalTime += f.dt;
-            dts.push_back(f.dt);
-            if (f.dt > 0)
-                res.minFps = std::min(res.minFps, 1.0f / f.dt);
-            res.maxFrameTime = std::max(res.maxFrameTime, f.dt);
-        }
-        
-        res.avgFrameTime = totalTime / res.totalFrames;
-        res.avgFps = 1.0f / res.avgFrameTime;
-        
-        std::sort(dts.begin(), dts.end());
-        res.p99FrameTime = dts[static_cast<size_t>(dts.size() * 0.99)];
+        const BenchmarkResult res = makeBenchmarkResult(mCurrentBenchmarkScene, std::move(mBenchmarkFrames), {});
+        mBenchmarkFrames.clear();
 
         // Write to file
         std::string filename = "benchmark_" + mCurrentBenchmarkScene + ".json";
         std::ofstream ofs(filename);
-        ofs << "{\n";
-        ofs << "  \"scene\": \"" << res.sceneName << "\",\n";
-        ofs << "  \"avgFps\": " << res.avgFps << ",\n";
-        ofs << "  \"minFps\": " << res.minFps << ",\n";
-        ofs << "  \"avgFrameTime\": " << res.avgFrameTime << ",\n";
-        ofs << "  \"maxFrameTime\": " << res.maxFrameTime << ",\n";
-        ofs << "  \"p99FrameTime\": " << res.p99FrameTime << ",\n";
-        ofs << "  \"totalFrames\": " << res.totalFrames << "\n";
-        ofs << "}\n";
-        
+        writeBenchmarkResult(res, ofs);
+
         std::cout << "Benchmark results saved to " << filename << std::endl;
     }
 }
@@ -41,6 +41,16 @@ namespace PerformanceToolkit
         double cpuCullTime;
         double cpuDrawTime;
         double gpuTime;
+        // Main thread time of engine subsystems, names are given to makeBenchmarkResult
+        std::vector<double> cpuSubsystemTimes;
+    };
+
+    struct TimingStats
+    {
+        std::string name;
+        double avgTime = 0;
+        double maxTime = 0;
+        double p99Time = 0;
     };
 
     struct BenchmarkResult
@@ -52,6 +62,8 @@ namespace PerformanceToolkit
         float maxFrameTime;
         float p99FrameTime;
         unsigned int totalFrames;
+        // Frame phases (main, cull, draw, gpu) followed by subsystems
+        std::vector<TimingStats> timings;
         std::vector<FrameStats> frames;
     };
 